@@ -0,0 +1,22 @@
+# Cross compiles for AArch64 Linux and runs the tests/benchmarks (ctest) with qemu-user, e.g.:
+#   cmake -DCMAKE_TOOLCHAIN_FILE=cmake/toolchains/aarch64-linux-gnu.cmake -DBUILD_TESTING=On -B build-aarch64 .
+# requires a gcc cross toolchain (e.g. Debian/Ubuntu packages g++-aarch64-linux-gnu and qemu-user)
+
+set(CMAKE_SYSTEM_NAME Linux)
+set(CMAKE_SYSTEM_PROCESSOR aarch64)
+
+set(DICE_HASH_AARCH64_TRIPLE "aarch64-linux-gnu" CACHE STRING "target triple of the cross toolchain")
+set(DICE_HASH_AARCH64_SYSROOT "/usr/${DICE_HASH_AARCH64_TRIPLE}" CACHE PATH "sysroot used by qemu to find the target's dynamic loader and libraries")
+
+set(CMAKE_C_COMPILER ${DICE_HASH_AARCH64_TRIPLE}-gcc)
+set(CMAKE_CXX_COMPILER ${DICE_HASH_AARCH64_TRIPLE}-g++)
+set(CMAKE_ASM_COMPILER ${DICE_HASH_AARCH64_TRIPLE}-gcc)
+
+# used by add_test and catch_discover_tests
+set(CMAKE_CROSSCOMPILING_EMULATOR qemu-aarch64 -L ${DICE_HASH_AARCH64_SYSROOT})
+
+set(CMAKE_FIND_ROOT_PATH ${DICE_HASH_AARCH64_SYSROOT})
+set(CMAKE_FIND_ROOT_PATH_MODE_PROGRAM NEVER)
+set(CMAKE_FIND_ROOT_PATH_MODE_LIBRARY ONLY)
+set(CMAKE_FIND_ROOT_PATH_MODE_INCLUDE ONLY)
+set(CMAKE_FIND_ROOT_PATH_MODE_PACKAGE BOTH)
@@ -85,6 +85,9 @@ class DiceHashConan(ConanFile):
         self.cpp_info.set_property("cmake_target_name", "dice-hash::dice-hash")
         self.cpp_info.set_property("cmake_file_name", "dice-hash")
 
+        if self.settings.os in ["Linux", "FreeBSD"]:
+            self.cpp_info.system_libs.append("pthread")
+
         if self.options.with_sodium:
             self.cpp_info.libs += ["dice-hash", "blake3"]
             self.cpp_info.requires += ["libsodium::libsodium", "highway::highway"]
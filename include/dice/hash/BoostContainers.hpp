@@ -0,0 +1,55 @@
+#ifndef DICE_HASH_BOOSTCONTAINERS_HPP
+#define DICE_HASH_BOOSTCONTAINERS_HPP
+
+/** @file
+ * @brief Adds the boost containers to the container traits of the DiceHash.
+ *
+ * The containers of metall (metall::container::vector, string, map, unordered_map, ...) and of boost::interprocess
+ * are boost containers with allocators that use offset pointers. Including this header makes them hashable
+ * by the DiceHash directly (i.e. without copying them into std containers first).
+ * The hashes are equal to the hashes of the std containers with the same content.
+ *
+ * Boost is not a dependency of dice-hash, this header must only be included if boost is available.
+ */
+
+#include "dice/hash/DiceHash.hpp"
+
+#include <boost/container/container_fwd.hpp>
+#include <boost/unordered/unordered_map_fwd.hpp>
+#include <boost/unordered/unordered_set_fwd.hpp>
+
+namespace dice::hash {
+
+	template<class T, class Allocator, class Options>
+	struct is_contiguous_container<boost::container::vector<T, Allocator, Options>> : std::true_type {};
+
+	template<class T, std::size_t N, class Allocator, class Options>
+	struct is_contiguous_container<boost::container::small_vector<T, N, Allocator, Options>> : std::true_type {};
+
+	template<class T, std::size_t Capacity, class Options>
+	struct is_contiguous_container<boost::container::static_vector<T, Capacity, Options>> : std::true_type {};
+
+	template<class CharT, class Traits, class Allocator>
+	struct is_contiguous_container<boost::container::basic_string<CharT, Traits, Allocator>> : std::true_type {};
+
+	template<class Key, class T, class Compare, class Allocator, class Options>
+	struct is_ordered_container<boost::container::map<Key, T, Compare, Allocator, Options>> : std::true_type {};
+
+	template<class Key, class Compare, class Allocator, class Options>
+	struct is_ordered_container<boost::container::set<Key, Compare, Allocator, Options>> : std::true_type {};
+
+	template<class Key, class T, class Compare, class Allocator>
+	struct is_ordered_container<boost::container::flat_map<Key, T, Compare, Allocator>> : std::true_type {};
+
+	template<class Key, class Compare, class Allocator>
+	struct is_ordered_container<boost::container::flat_set<Key, Compare, Allocator>> : std::true_type {};
+
+	template<class Key, class T, class Hash, class KeyEqual, class Allocator>
+	struct is_unordered_container<boost::unordered_map<Key, T, Hash, KeyEqual, Allocator>> : std::true_type {};
+
+	template<class Key, class Hash, class KeyEqual, class Allocator>
+	struct is_unordered_container<boost::unordered_set<Key, Hash, KeyEqual, Allocator>> : std::true_type {};
+
+}// namespace dice::hash
+
+#endif//DICE_HASH_BOOSTCONTAINERS_HPP
@@ -11,9 +11,15 @@
 
 #include "dice/hash/internal/Container_trait.hpp"
 #include "dice/hash/internal/DiceHashPolicies.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <cstring>
+#include <initializer_list>
+#include <iterator>
 #include <map>
 #include <memory>
+#include <random>
 #include <set>
 #include <span>
 #include <string>
@@ -58,259 +64,467 @@ namespace dice::hash {
 		}
 	};
 
-	/** Class which contains all dice_hash functions.
-	 * @tparam Policy The Policy the hash is based on.
+	/** Helper struct for hashing a custom type via a value that represents it (e.g. a fingerprint or a tuple of its members).
+	 * In contrast to dice_hash_overload the representation does not depend on the policy, so the type can be hashed with every
+	 * policy, including the KeyedHashPolicy of a SeededDiceHash.
+	 * Specialize it with a static function `represent(T const &) noexcept` that returns a value of a hashable type.
+	 * @tparam T The custom type.
 	 */
-	template<Policies::HashPolicy Policy>
-	class dice_hash_templates {
-	private:
-		/** Calculates the hash over an ordered container.
-         * An example would be a vector, a map, an array or a list.
-         * Needs a ForwardIterator in the Container-type, and an member type "value_type".
-         *
-         * @tparam Container The container type (vector, map, list, etc).
-         * @param container The container to calculate the hash value of.
-         * @return The combined hash of all values inside of the container.
-         */
-		template<typename Container>
-		static std::size_t dice_hash_ordered_container(Container const &container) noexcept {
-			typename Policy::HashState hash_state(container.size());
-			std::size_t item_hash;
-			for (const auto &item : container) {
-				item_hash = dice_hash(item);
-				hash_state.add(item_hash);
+	template<typename T>
+	struct dice_hash_representation {};
+
+	namespace detail {
+		/** Implementation of all dice_hash functions.
+		 * For a HashPolicy it is empty and only calls the static policy functions.
+		 * For a KeyedHashPolicy it references the policy object (i.e. the key) and calls the policy functions on it.
+		 * @tparam Policy The Policy the hash is based on.
+		 */
+		template<typename Policy>
+		requires Policies::HashPolicy<Policy> || Policies::KeyedHashPolicy<Policy>
+		class dice_hash_impl {
+		public:
+			static constexpr bool keyed = !Policies::HashPolicy<Policy>;
+
+		private:
+			struct NoPolicy {};
+			[[no_unique_address]] std::conditional_t<keyed, Policy const *, NoPolicy> policy_;
+
+			[[nodiscard]] std::size_t policy_hash_bytes(void const *ptr, std::size_t len) const noexcept {
+				if constexpr (keyed) {
+					return policy_->hash_bytes(ptr, len);
+				} else {
+					return Policy::hash_bytes(ptr, len);
+				}
 			}
-			return hash_state.digest();
-		}
 
-		/** Calculates the hash over an unordered container.
-         * An example would be a unordered_map or an unordered_set.
-         * It uses the dice_hash_invertible_combine because a specific layout of data cannot be assumed.
-         * Needs a ForwardIterator in the Container-type, and an member type "value_type".
-         *
-         * @tparam Container The container type (unordered_map/set etc).
-         * @param container The container to calculate the hash value of.
-         * @return The combined hash of all Values inside of the container.
-         */
-		template<typename Container>
-		static std::size_t dice_hash_unordered_container(Container const &container) noexcept {
-			std::size_t h{};
-			for (auto const &it : container) {
-				h = Policy::hash_invertible_combine({h, dice_hash(it)});
+			static constexpr bool has_hash_bytes_fixed = requires(Policy const &policy, void const *ptr) {
+				{ policy.template hash_bytes_fixed<1>(ptr) } noexcept -> std::convertible_to<std::size_t>;
+			};
+
+			static constexpr bool has_hash_elements = requires(Policy const &policy, void const *ptr, std::size_t len) {
+				{ policy.template hash_elements<2>(ptr, len) } noexcept -> std::convertible_to<std::size_t>;
+			};
+
+			/** Policy::hash_bytes_fixed<N> if the policy provides it, otherwise Policy::hash_bytes. */
+			template<std::size_t N>
+			[[nodiscard]] std::size_t policy_hash_bytes_fixed(void const *ptr) const noexcept {
+				if constexpr (!has_hash_bytes_fixed) {
+					return policy_hash_bytes(ptr, N);
+				} else if constexpr (keyed) {
+					return policy_->template hash_bytes_fixed<N>(ptr);
+				} else {
+					return Policy::template hash_bytes_fixed<N>(ptr);
+				}
 			}
-			return h;
-		}
 
-		/** Helper function for hashing tuples.
-         * It is a wrapper for hash_and_combine.
-         * This function can be called with the help of std::make_index_sequence.
-         * @tparam TupleArgs The types used in the tuple.
-         * @tparam ids Generated by std::make_index_sequence. Needed for indexing the tuple values.
-         * @param tuple The tuple to hash.
-         * @return Hash value.
-         */
-		template<typename... TupleArgs, std::size_t... ids>
-		static std::size_t dice_hash_tuple(std::tuple<TupleArgs...> const &tuple, std::index_sequence<ids...> const &) {
-			return Policy::hash_combine({dice_hash(std::get<ids>(tuple))...});
-		}
+			template<typename T>
+			[[nodiscard]] std::size_t policy_hash_fundamental(T x) const noexcept {
+				if constexpr (keyed) {
+					return policy_->hash_fundamental(x);
+				} else {
+					return Policy::hash_fundamental(x);
+				}
+			}
 
-		template<typename T>
-		static constexpr bool is_fundamental = std::is_fundamental_v<T> || std::is_same_v<std::remove_cv_t<T>, std::byte>;
+			[[nodiscard]] std::size_t policy_hash_combine(std::initializer_list<std::size_t> hashes) const noexcept {
+				if constexpr (keyed) {
+					return policy_->hash_combine(hashes);
+				} else {
+					return Policy::hash_combine(hashes);
+				}
+			}
 
-	public:
-		/** Base case for dice_hash.
-         * This case is only chosen if no other match is found in this struct.
-         * Than it tries to find a specialization of dice::hash::dice_hash_overload and
-         * if none is found, this function will not compile.
-         * @tparam T The type to hash.
-         * @return Hash value.
-         */
-		template<typename T>
-		static std::size_t dice_hash(T const &t) noexcept {
-			return dice_hash_overload<Policy, T>::dice_hash(t);
-		}
+			[[nodiscard]] std::size_t policy_hash_invertible_combine(std::initializer_list<std::size_t> hashes) const noexcept {
+				if constexpr (keyed) {
+					return policy_->hash_invertible_combine(hashes);
+				} else {
+					return Policy::hash_invertible_combine(hashes);
+				}
+			}
 
-		/** Implementation for fundamentals.
-         * @tparam T Fundamental type.
-         * @param fundamental Value to hash.
-         * @return Hash value.
-         */
-		template<typename T>
-		requires is_fundamental<std::decay_t<T>> static std::size_t dice_hash(T const &fundamental) noexcept {
-			return Policy::hash_fundamental(fundamental);
-		}
+			[[nodiscard]] typename Policy::HashState make_hash_state(std::size_t size) const noexcept {
+				if constexpr (keyed) {
+					return typename Policy::HashState(*policy_, size);
+				} else {
+					return typename Policy::HashState(size);
+				}
+			}
 
-		/** Implementation for string types.
-         * @tparam CharT A char type. See the definition of std::string for more information.
-         * @param str The string to hash.
-         * @return Hash value.
-         */
-		template<typename CharT>
-		static std::size_t dice_hash(std::basic_string<CharT> const &str) noexcept {
-			return Policy::hash_bytes(str.data(), sizeof(CharT) * str.size());
-		}
+		public:
+			dice_hash_impl() noexcept requires(!keyed) = default;
 
-		/** Implementation for string view.
-         * @tparam CharT A char type. See the definition of std::string for more information.
-         * @param sv The string view to hash.
-         * @return Hash value.
-         */
-		template<typename CharT>
-		static std::size_t dice_hash(std::basic_string_view<CharT> const &sv) noexcept {
-			return Policy::hash_bytes(sv.data(), sizeof(CharT) * sv.size());
-		}
+			/** @param policy the keyed policy, must outlive this object */
+			explicit dice_hash_impl(Policy const &policy) noexcept requires keyed : policy_{&policy} {}
 
-		/** Implementation for raw pointers.
-         * CAUTION: hashes the POINTER, not the OBJECT POINTED TO!
-         * @tparam T A pointer type.
-         * @param ptr The pointer to hash.
-         * @return Hash value.
-         */
-		template<typename T>
-		static std::size_t dice_hash(T *ptr) noexcept {
-			return Policy::hash_fundamental(ptr);
-		}
+		private:
+			/** Calculates the hash over an ordered container.
+	         * An example would be a vector, a map, an array or a list.
+	         * Needs a ForwardIterator in the Container-type, and an member type "value_type".
+	         *
+	         * @tparam Container The container type (vector, map, list, etc).
+	         * @param container The container to calculate the hash value of.
+	         * @return The combined hash of all values inside of the container.
+	         */
+			template<typename Container>
+			std::size_t dice_hash_ordered_container(Container const &container) const noexcept {
+				auto hash_state = make_hash_state(container.size());
+				std::size_t item_hash;
+				for (const auto &item : container) {
+					item_hash = dice_hash(item);
+					hash_state.add(item_hash);
+				}
+				return hash_state.digest();
+			}
 
-		/** Implementation for unique pointers.
-         * CAUTION: hashes the POINTER, not the OBJECT POINTED TO!
-         * @tparam T A unique pointer type.
-         * @param ptr The pointer to hash.
-         * @return Hash value.
-         */
-		template<typename T>
-		static std::size_t dice_hash(std::unique_ptr<T> const &ptr) noexcept {
-			return dice_hash(ptr.get());
-		}
+			/** Calculates the hash over an unordered container.
+	         * An example would be a unordered_map or an unordered_set.
+	         * It uses the dice_hash_invertible_combine because a specific layout of data cannot be assumed.
+	         * Needs a ForwardIterator in the Container-type, and an member type "value_type".
+	         *
+	         * @tparam Container The container type (unordered_map/set etc).
+	         * @param container The container to calculate the hash value of.
+	         * @return The combined hash of all Values inside of the container.
+	         */
+			template<typename Container>
+			std::size_t dice_hash_unordered_container(Container const &container) const noexcept {
+				std::size_t h{};
+				for (auto const &it : container) {
+					h = policy_hash_invertible_combine({h, dice_hash(it)});
+				}
+				return h;
+			}
 
-		/** implementation for shared pointers.
-         * CAUTION: hashes the POINTER, not the OBJECT POINTED TO!
-         * @tparam T A shared pointer type.
-         * @param ptr The pointer to hash.
-         * @return Hash value.
-         */
-		template<typename T>
-		static std::size_t dice_hash(std::shared_ptr<T> const &ptr) noexcept {
-			return dice_hash(ptr.get());
-		}
+			/** Helper function for hashing tuples.
+	         * It is a wrapper for hash_and_combine.
+	         * This function can be called with the help of std::make_index_sequence.
+	         * @tparam TupleArgs The types used in the tuple.
+	         * @tparam ids Generated by std::make_index_sequence. Needed for indexing the tuple values.
+	         * @param tuple The tuple to hash.
+	         * @return Hash value.
+	         */
+			template<typename... TupleArgs, std::size_t... ids>
+			std::size_t dice_hash_tuple(std::tuple<TupleArgs...> const &tuple, std::index_sequence<ids...> const &) const {
+				return policy_hash_combine({dice_hash(std::get<ids>(tuple))...});
+			}
+
+			template<typename>
+			struct AlwaysFalse : std::false_type {};
 
-		/** Implementation for std arrays.
-        * It will use different implementations if the type is fundamental or not.
-        * @tparam T The type of the values.
-        * @tparam N The number of values.
-        * @param arr The array itself.
-        * @return Hash value.
-        */
-		template<typename T, std::size_t N>
-		static std::size_t dice_hash(std::array<T, N> const &arr) noexcept {
-			if constexpr (is_fundamental<T>) {
-				return Policy::hash_bytes(arr.data(), sizeof(T) * N);
-			} else {
-				return dice_hash_ordered_container(arr);
+			template<typename T>
+			static constexpr bool is_fundamental = std::is_fundamental_v<T> || std::is_same_v<std::remove_cv_t<T>, std::byte>;
+
+			/** Size of the stack buffer in which hash_fundamentals converts values to little endian on big endian platforms,
+			 * for policies without hash_elements. */
+			static constexpr std::size_t big_endian_chunk_len = 4096;
+
+			/** Hashes a contiguous sequence of fundamentals as bytes.
+	         * On big endian platforms the values are hashed in little endian byte order, so that the hash is the same on every platform:
+	         * the policy's hash_elements reads them as little endian. Policies without hash_elements get the values converted
+	         * in a stack buffer of big_endian_chunk_len bytes; longer sequences are then hashed chunk by chunk and the chunk hashes
+	         * are combined, so for such policies their hash values differ between little and big endian platforms.
+	         * @tparam T A fundamental type.
+	         * @param data Pointer to the first value.
+	         * @param size Number of values.
+	         * @return Hash value.
+	         */
+			template<typename T>
+			std::size_t hash_fundamentals(T const *data, std::size_t size) const noexcept {
+				if constexpr (std::endian::native == std::endian::little || sizeof(T) == 1) {
+					return policy_hash_bytes(data, sizeof(T) * size);
+				} else if constexpr (has_hash_elements) {
+					if constexpr (keyed) {
+						return policy_->template hash_elements<sizeof(T)>(data, sizeof(T) * size);
+					} else {
+						return Policy::template hash_elements<sizeof(T)>(data, sizeof(T) * size);
+					}
+				} else {
+					static constexpr std::size_t chunk_size = big_endian_chunk_len / sizeof(T);
+					std::array<std::remove_cv_t<T>, chunk_size> chunk;
+					auto const hash_chunk = [&](std::size_t first, std::size_t n) noexcept {
+						std::transform(data + first, data + first + n, chunk.begin(), [](auto x) { return Policies::detail::to_little_endian(x); });
+						return policy_hash_bytes(chunk.data(), sizeof(T) * n);
+					};
+
+					if (size <= chunk_size) {
+						return hash_chunk(0, size);
+					}
+
+					auto hash_state = make_hash_state((size + chunk_size - 1) / chunk_size);
+					for (std::size_t first = 0; first < size; first += chunk_size) {
+						hash_state.add(hash_chunk(first, std::min(chunk_size, size - first)));
+					}
+					return hash_state.digest();
+				}
 			}
-		}
 
-		/** Implementation for vectors.
-         * It will use different implementations for fundamental and non-fundamental types.
-         * @tparam T The type of the values.
-         * @param vec The vector itself.
-         * @return Hash value.
-         */
-		template<typename T>
-		static std::size_t dice_hash(std::vector<T> const &vec) noexcept {
-			if constexpr (is_fundamental<T>) {
-				static_assert(!std::is_same_v<std::decay_t<T>, bool>,
-							  "vector of booleans has a special implementation which results in errors!");
-				return Policy::hash_bytes(vec.data(), sizeof(T) * vec.size());
-			} else {
-				return dice_hash_ordered_container(vec);
+			/** Hashes N contiguous fundamentals (N known at compile time) as bytes.
+	         * The hash is the same as hash_fundamentals(data, N), but the policy can use a kernel that is specialized for the length.
+	         * @tparam N Number of values.
+	         * @tparam T A fundamental type.
+	         * @param data Pointer to the first value.
+	         * @return Hash value.
+	         */
+			template<std::size_t N, typename T>
+			std::size_t hash_fundamentals(T const *data) const noexcept {
+				if constexpr (std::endian::native == std::endian::little || sizeof(T) == 1) {
+					return policy_hash_bytes_fixed<sizeof(T) * N>(data);
+				} else {
+					return hash_fundamentals(data, N);
+				}
 			}
-		}
 
-		/** Implementation for byte spans
-		 * @param bytes byte span to hash
-		 * @return Hash value.
-		 */
-		template<typename T, std::size_t Extent>
-		static std::size_t dice_hash(std::span<T, Extent> const &span) noexcept {
-			if constexpr (is_fundamental<T>) {
-				return Policy::hash_bytes(span.data(), span.size_bytes());
-			} else {
-				return dice_hash_ordered_container(span);
+		public:
+			/** Base case for dice_hash.
+	         * This case is only chosen if no other match is found in this struct.
+	         * Than it tries to find a specialization of dice::hash::dice_hash_representation or dice::hash::dice_hash_overload and
+	         * if none is found, this function will not compile.
+	         * @tparam T The type to hash.
+	         * @return Hash value.
+	         */
+			template<typename T>
+			std::size_t dice_hash(T const &t) const noexcept {
+				if constexpr (requires { dice_hash_representation<T>::represent(t); }) {
+					return dice_hash(dice_hash_representation<T>::represent(t));
+				} else if constexpr (keyed) {
+					static_assert(AlwaysFalse<T>::value,
+								  "dice_hash_overload specializations are static and cannot be used with a KeyedHashPolicy. "
+								  "Specialize dice_hash_representation or hash the members of the type (e.g. as a tuple) instead.");
+					return 0;
+				} else {
+					return dice_hash_overload<Policy, T>::dice_hash(t);
+				}
 			}
-		}
 
-		/** Implementation for tuples.
-         * Will hash every entry and then combine the hashes.
-         * @tparam TupleArgs The types of the tuple values.
-         * @param tpl The tuple itself.
-         * @return Hash value.
-         */
-		template<typename... TupleArgs>
-		static std::size_t dice_hash(std::tuple<TupleArgs...> const &tpl) noexcept {
-			return dice_hash_tuple(tpl, std::make_index_sequence<sizeof...(TupleArgs)>());
-		}
+			/** Implementation for fundamentals.
+	         * @tparam T Fundamental type.
+	         * @param fundamental Value to hash.
+	         * @return Hash value.
+	         */
+			template<typename T>
+			requires is_fundamental<std::decay_t<T>> std::size_t dice_hash(T const &fundamental) const noexcept {
+				return policy_hash_fundamental(fundamental);
+			}
 
-		/** Implementation for pairs.
-         * Will hash the entries and then combine them.
-         * @tparam T Type of the first value.
-         * @tparam V Type of the second value.
-         * @param p The pair itself.
-         * @return Hash value.
-         */
-		template<typename T, typename V>
-		static std::size_t dice_hash(std::pair<T, V> const &p) noexcept {
-			return Policy::hash_combine({dice_hash(p.first), dice_hash(p.second)});
-		}
+			/** Implementation for string types.
+	         * The hash does not depend on the allocator, e.g. a string in a metall segment hashes like an equal std::string.
+	         * @tparam CharT A char type. See the definition of std::string for more information.
+	         * @tparam Traits The char traits.
+	         * @tparam Allocator The allocator of the string.
+	         * @param str The string to hash.
+	         * @return Hash value.
+	         */
+			template<typename CharT, typename Traits, typename Allocator>
+			std::size_t dice_hash(std::basic_string<CharT, Traits, Allocator> const &str) const noexcept {
+				return hash_fundamentals(str.data(), str.size());
+			}
 
-		/** Overload for std::monostate.
-         * It is needed so its usage in std::variant is possible.
-         * Will simply return the seed.
-         * @return The seed of the hash function.
-         */
-		static std::size_t dice_hash(std::monostate const &) noexcept {
-			return Policy::ErrorValue;
-		}
+			/** Implementation for string view.
+	         * @tparam CharT A char type. See the definition of std::string for more information.
+	         * @tparam Traits The char traits.
+	         * @param sv The string view to hash.
+	         * @return Hash value.
+	         */
+			template<typename CharT, typename Traits>
+			std::size_t dice_hash(std::basic_string_view<CharT, Traits> const &sv) const noexcept {
+				return hash_fundamentals(sv.data(), sv.size());
+			}
 
-		/** Implementation for variant.
-         * Will hash the value which was set.
-         * The hash of a variant of a type is equal to the hash of the type.
-         * For example: a variant of int of 42 is equal to the hash of the int of 42.
-         * If the variant is valueless_by_exception, the seed will be returned.
-         * @tparam VariantArgs Types of the possible values.
-         * @param var The variant itself.
-         * @return Hash value.
-         */
-		template<typename... VariantArgs>
-		static std::size_t dice_hash(std::variant<VariantArgs...> const &var) noexcept {
-			try {
-				return std::visit([]<typename T>(T &&arg) { return dice_hash(std::forward<T>(arg)); }, var);
-			} catch (std::bad_variant_access const &) {
+			/** Implementation for raw pointers.
+	         * CAUTION: hashes the POINTER, not the OBJECT POINTED TO!
+	         * @tparam T A pointer type.
+	         * @param ptr The pointer to hash.
+	         * @return Hash value.
+	         */
+			template<typename T>
+			std::size_t dice_hash(T *ptr) const noexcept {
+				return policy_hash_fundamental(ptr);
+			}
+
+			/** Implementation for unique pointers.
+	         * CAUTION: hashes the POINTER, not the OBJECT POINTED TO!
+	         * @tparam T A unique pointer type.
+	         * @param ptr The pointer to hash.
+	         * @return Hash value.
+	         */
+			template<typename T>
+			std::size_t dice_hash(std::unique_ptr<T> const &ptr) const noexcept {
+				return dice_hash(ptr.get());
+			}
+
+			/** implementation for shared pointers.
+	         * CAUTION: hashes the POINTER, not the OBJECT POINTED TO!
+	         * @tparam T A shared pointer type.
+	         * @param ptr The pointer to hash.
+	         * @return Hash value.
+	         */
+			template<typename T>
+			std::size_t dice_hash(std::shared_ptr<T> const &ptr) const noexcept {
+				return dice_hash(ptr.get());
+			}
+
+			/** Implementation for std arrays.
+	        * It will use different implementations if the type is fundamental or not.
+	        * Arrays of fundamentals are hashed with a kernel for their size (if the policy provides one, see Policies::max_fixed_len).
+	        * @tparam T The type of the values.
+	        * @tparam N The number of values.
+	        * @param arr The array itself.
+	        * @return Hash value.
+	        */
+			template<typename T, std::size_t N>
+			std::size_t dice_hash(std::array<T, N> const &arr) const noexcept {
+				if constexpr (is_fundamental<T>) {
+					return hash_fundamentals<N>(arr.data());
+				} else {
+					return dice_hash_ordered_container(arr);
+				}
+			}
+
+			/** Implementation for vectors.
+	         * It will use different implementations for fundamental and non-fundamental types.
+	         * The hash does not depend on the allocator.
+	         * @tparam T The type of the values.
+	         * @tparam Allocator The allocator of the vector.
+	         * @param vec The vector itself.
+	         * @return Hash value.
+	         */
+			template<typename T, typename Allocator>
+			std::size_t dice_hash(std::vector<T, Allocator> const &vec) const noexcept {
+				if constexpr (is_fundamental<T>) {
+					static_assert(!std::is_same_v<std::decay_t<T>, bool>,
+								  "vector of booleans has a special implementation which results in errors!");
+					return hash_fundamentals(vec.data(), vec.size());
+				} else {
+					return dice_hash_ordered_container(vec);
+				}
+			}
+
+			/** Implementation for spans.
+			 * Spans of fundamentals with a static extent are hashed with a kernel for their size (like std::array).
+			 * @tparam T The type of the values.
+			 * @tparam Extent The extent of the span.
+			 * @param span The span to hash.
+			 * @return Hash value.
+			 */
+			template<typename T, std::size_t Extent>
+			std::size_t dice_hash(std::span<T, Extent> const &span) const noexcept {
+				if constexpr (is_fundamental<T> && Extent != std::dynamic_extent) {
+					return hash_fundamentals<Extent>(span.data());
+				} else if constexpr (is_fundamental<T>) {
+					return hash_fundamentals(span.data(), span.size());
+				} else {
+					return dice_hash_ordered_container(span);
+				}
+			}
+
+			/** Implementation for tuples.
+	         * Will hash every entry and then combine the hashes.
+	         * @tparam TupleArgs The types of the tuple values.
+	         * @param tpl The tuple itself.
+	         * @return Hash value.
+	         */
+			template<typename... TupleArgs>
+			std::size_t dice_hash(std::tuple<TupleArgs...> const &tpl) const noexcept {
+				return dice_hash_tuple(tpl, std::make_index_sequence<sizeof...(TupleArgs)>());
+			}
+
+			/** Implementation for pairs.
+	         * Will hash the entries and then combine them.
+	         * @tparam T Type of the first value.
+	         * @tparam V Type of the second value.
+	         * @param p The pair itself.
+	         * @return Hash value.
+	         */
+			template<typename T, typename V>
+			std::size_t dice_hash(std::pair<T, V> const &p) const noexcept {
+				return policy_hash_combine({dice_hash(p.first), dice_hash(p.second)});
+			}
+
+			/** Overload for std::monostate.
+	         * It is needed so its usage in std::variant is possible.
+	         * Will simply return the seed.
+	         * @return The seed of the hash function.
+	         */
+			std::size_t dice_hash(std::monostate const &) const noexcept {
 				return Policy::ErrorValue;
 			}
-		}
 
-		/** Implementation for ordered container.
-         * It uses a custom type trait to check if the type is in fact an ordered container.
-         * CAUTION: If you want to add another type to the trait, you might need to do it before this is included!
-         * @tparam T The container type.
-         * @param container The container itself.
-         * @return Hash value.
-         */
-		template<typename T>
-		requires is_ordered_container_v<T> static std::size_t dice_hash(T const &container) noexcept {
-			return dice_hash_ordered_container(container);
-		}
+			/** Implementation for variant.
+	         * Will hash the value which was set.
+	         * The hash of a variant of a type is equal to the hash of the type.
+	         * For example: a variant of int of 42 is equal to the hash of the int of 42.
+	         * If the variant is valueless_by_exception, the seed will be returned.
+	         * @tparam VariantArgs Types of the possible values.
+	         * @param var The variant itself.
+	         * @return Hash value.
+	         */
+			template<typename... VariantArgs>
+			std::size_t dice_hash(std::variant<VariantArgs...> const &var) const noexcept {
+				try {
+					return std::visit([this]<typename T>(T &&arg) { return dice_hash(std::forward<T>(arg)); }, var);
+				} catch (std::bad_variant_access const &) {
+					return Policy::ErrorValue;
+				}
+			}
 
-		/** Implementation for unordered container.
-         * It uses a custom type trait to check if the type is in fact an unordered container.
-         * CAUTION: If you want to add another type to the trait, you might need to do it before this is included!
-         * @tparam T The container type.
-         * @param container The container itself.
-         * @return Hash value.
-         */
+			/** Implementation for contiguous container.
+	         * It uses a custom type trait to check if the type is in fact a contiguous container.
+	         * Containers of fundamental types are hashed as bytes, i.e. like a std::vector or std::basic_string with the same content.
+	         * CAUTION: If you want to add another type to the trait, you might need to do it before this is included!
+	         * @tparam T The container type.
+	         * @param container The container itself.
+	         * @return Hash value.
+	         */
+			template<typename T>
+			requires is_contiguous_container_v<T> std::size_t dice_hash(T const &container) const noexcept {
+				using value_type = typename T::value_type;
+				if constexpr (is_fundamental<value_type>) {
+					return hash_fundamentals(std::to_address(std::data(container)), std::size(container));
+				} else {
+					return dice_hash_ordered_container(container);
+				}
+			}
+
+			/** Implementation for ordered container.
+	         * It uses a custom type trait to check if the type is in fact an ordered container.
+	         * CAUTION: If you want to add another type to the trait, you might need to do it before this is included!
+	         * @tparam T The container type.
+	         * @param container The container itself.
+	         * @return Hash value.
+	         */
+			template<typename T>
+			requires is_ordered_container_v<T> std::size_t dice_hash(T const &container) const noexcept {
+				return dice_hash_ordered_container(container);
+			}
+
+			/** Implementation for unordered container.
+	         * It uses a custom type trait to check if the type is in fact an unordered container.
+	         * CAUTION: If you want to add another type to the trait, you might need to do it before this is included!
+	         * @tparam T The container type.
+	         * @param container The container itself.
+	         * @return Hash value.
+	         */
+			template<typename T>
+			requires is_unordered_container_v<T> std::size_t dice_hash(T const &container) const noexcept {
+				return dice_hash_unordered_container(container);
+			}
+		};
+	}// namespace detail
+
+	/** Class which contains all dice_hash functions.
+	 * Use it to define dice_hash_overload for custom types, e.g. dice_hash_templates<Policy>::dice_hash(std::make_tuple(x.a, x.b)).
+	 * @tparam Policy The Policy the hash is based on.
+	 */
+	template<Policies::HashPolicy Policy>
+	class dice_hash_templates {
+	public:
+		/** Calculates the hash of t with the matching dice_hash implementation (see detail::dice_hash_impl).
+		 * @tparam T The type to hash.
+		 * @param t The value to hash.
+		 * @return Hash value.
+		 */
 		template<typename T>
-		requires is_unordered_container_v<T> static std::size_t dice_hash(T const &container) noexcept {
-			return dice_hash_unordered_container(container);
+		static std::size_t dice_hash(T const &t) noexcept {
+			return detail::dice_hash_impl<Policy>{}.dice_hash(t);
 		}
 	};
 
@@ -321,6 +535,11 @@ namespace dice::hash {
      */
 	template<typename T, Policies::HashPolicy Policy = Policies::Martinus>
 	struct DiceHash : private Policy {
+		/** Version of the hash values produced by Policy (see Policies::policy_version_v).
+		 * Persisted hash values should be stored together with it; they remain valid as long as it does not change.
+		 */
+		static constexpr std::uint32_t policy_version = Policies::policy_version_v<Policy>;
+
 		/** Policy function for combining already hashed values.
 		 * This using declaration is equal to a handwritten wrapper function.
 		 *@param list Initializer list of std::size_t hashes.
@@ -354,13 +573,93 @@ namespace dice::hash {
 		}
 	};
 
+	namespace detail {
+		/** Process-wide random seed, generated on first use. */
+		[[nodiscard]] inline std::uint64_t random_seed() {
+			static std::uint64_t const seed = [] {
+				std::random_device rd;
+				return (static_cast<std::uint64_t>(rd()) << 32) ^ static_cast<std::uint64_t>(rd());
+			}();
+			return seed;
+		}
+
+		/** Policy keyed with random_seed(); the key derivation is only done once per Policy. */
+		template<Policies::KeyedHashPolicy Policy>
+		[[nodiscard]] Policy const &random_keyed_policy() {
+			static Policy const policy{random_seed()};
+			return policy;
+		}
+	}// namespace detail
+
+	/** DiceHash with a KeyedHashPolicy, i.e. a hash functor that holds a runtime key.
+	 * Hash tables that hash untrusted input (e.g. IRIs of ingested data) should use it, so that attackers cannot precompute colliding keys.
+	 * A default constructed SeededDiceHash uses a random seed that is generated once per process.
+	 * It supports the same types as DiceHash, except for types that are only hashable via a dice_hash_overload specialization
+	 * (types with a dice_hash_representation specialization are supported).
+	 * @tparam T The type to define the hash for.
+	 * @tparam Policy The KeyedHashPolicy defines how the hash works on a basic level.
+	 */
+	template<typename T, Policies::KeyedHashPolicy Policy = Policies::seeded_wyhash>
+	class SeededDiceHash {
+		Policy policy_;
+
+	public:
+		/** Keys the policy with the process-wide random seed. */
+		SeededDiceHash() : policy_{detail::random_keyed_policy<Policy>()} {}
+
+		/** @param seed seed to key the policy with */
+		explicit SeededDiceHash(std::uint64_t seed) noexcept : policy_{seed} {}
+
+		/** @param policy an already keyed policy */
+		explicit SeededDiceHash(Policy const &policy) noexcept : policy_{policy} {}
+
+		/** Overloaded operator to calculate a hash.
+		 * @param t The value to calculate the hash of.
+		 * @return Hash value.
+		 */
+		std::size_t operator()(T const &t) const noexcept {
+			return detail::dice_hash_impl<Policy>{policy_}.dice_hash(t);
+		}
+
+		/** Policy function for combining already hashed values.
+		 * @param hashes Initializer list of std::size_t hashes.
+		 * @return Single hash value.
+		 */
+		[[nodiscard]] std::size_t hash_combine(std::initializer_list<std::size_t> hashes) const noexcept {
+			return policy_.hash_combine(hashes);
+		}
+
+		/** Policy function for combining already hashed values in a invertible fashion.
+		 * @param hashes Initializer list of std::size_t hashes.
+		 * @return Single hash value.
+		 */
+		[[nodiscard]] std::size_t hash_invertible_combine(std::initializer_list<std::size_t> hashes) const noexcept {
+			return policy_.hash_invertible_combine(hashes);
+		}
+
+		/** Function to check if a hash is equal to an error value.
+		 * @param to_check The hash value to check.
+		 * @return True if value is an error value, false otherwise.
+		 */
+		[[nodiscard]] static constexpr bool is_faulty(std::size_t to_check) noexcept {
+			return to_check == Policy::ErrorValue;
+		}
+
+		/** @return the keyed policy, e.g. to create other functors with the same key */
+		[[nodiscard]] Policy const &policy() const noexcept {
+			return policy_;
+		}
+	};
+
     template <typename T>
     using DiceHashMartinus = DiceHash<T, Policies::Martinus>;
-#ifdef __x86_64__
     template <typename T>
     using DiceHashxxh3 = DiceHash<T, Policies::xxh3>;
-#endif
     template <typename T>
     using DiceHashwyhash = DiceHash<T, Policies::wyhash>;
+    template <typename T>
+    using SeededDiceHashxxh3 = SeededDiceHash<T, Policies::seeded_xxh3>;
+    template <typename T>
+    using SeededDiceHashwyhash = SeededDiceHash<T, Policies::seeded_wyhash>;
 }// namespace dice::hash
 #endif//DICE_HASH_DICEHASH_HPP
\ No newline at end of file
@@ -0,0 +1,665 @@
+#ifndef DICE_HASH_FLATHASHMAP_HPP
+#define DICE_HASH_FLATHASHMAP_HPP
+
+/** @file
+ * @brief A flat (open addressing) hash map built on the DiceHash with pipelined bulk operations.
+ */
+
+#include "dice/hash/DiceHash.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+namespace dice::hash {
+
+	namespace detail {
+		/**
+		 * @brief hints the CPU to load the cache line of ptr
+		 */
+		inline void prefetch(void const *ptr) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+			__builtin_prefetch(ptr);
+#else
+			(void) ptr;
+#endif
+		}
+	}// namespace detail
+
+	/**
+	 * @brief A hash map with open addressing and linear probing, i.e. all entries are stored inline in a single array of slots.
+	 *
+	 * Every slot stores the hash of its key (with the lowest bit set, 0 marks an empty slot) next to the entry, so probing mostly
+	 * compares hashes and a lookup usually touches a single cache line. The bucket of a hash is chosen by Fibonacci hashing
+	 * (multiplication with 2^64/phi, the upper bits are used), so weak hashes (e.g. the identity) work as well.
+	 * The table grows by doubling when the load factor would exceed 3/4; erase uses backward shift deletion (no tombstones).
+	 *
+	 * In addition to the usual single key operations there are bulk operations (find_bulk, insert_bulk) for many keys at once.
+	 * They compute the hashes PrefetchDistance keys ahead and issue a prefetch for the buckets of these keys, so hashing and the
+	 * cache misses of multiple lookups overlap instead of every lookup waiting for its bucket.
+	 * This pays off once the table does not fit into the cache anymore.
+	 *
+	 * @note pointers to values are invalidated by any insertion of a new key that grows the table and by erase
+	 * @note not thread-safe; concurrent access has to be synchronized externally (concurrent const access is fine)
+	 * @tparam Key key type
+	 * @tparam Value mapped type
+	 * @tparam Hash hash function for Key, e.g. DiceHash<Key> or SeededDiceHash<Key>
+	 * @tparam KeyEqual equality of keys
+	 * @tparam Allocator allocator for std::pair<Key, Value>
+	 */
+	template<typename Key, typename Value, typename Hash = DiceHash<Key>, typename KeyEqual = std::equal_to<Key>,
+			 typename Allocator = std::allocator<std::pair<Key, Value>>>
+	class FlatHashMap {
+	public:
+		using key_type = Key;
+		using mapped_type = Value;
+		using value_type = std::pair<Key, Value>;
+		using size_type = size_t;
+		using hasher = Hash;
+		using key_equal = KeyEqual;
+		using allocator_type = Allocator;
+
+		/**
+		 * @brief default number of keys that bulk operations hash (and prefetch) ahead
+		 */
+		static constexpr size_t default_prefetch_distance = 16;
+
+		static constexpr size_t min_capacity = 16;
+
+	private:
+		static constexpr size_t empty_tag = 0;
+
+		struct Slot {
+			size_t tag = empty_tag;
+			union {
+				value_type value;
+			};
+
+			Slot() noexcept {}
+			~Slot() {}
+		};
+
+		using alloc_traits = std::allocator_traits<Allocator>;
+		using value_alloc_traits = typename std::allocator_traits<Allocator>::template rebind_traits<value_type>;
+		using value_allocator = typename value_alloc_traits::allocator_type;
+		using slot_alloc_traits = typename std::allocator_traits<Allocator>::template rebind_traits<Slot>;
+		using slot_allocator = typename slot_alloc_traits::allocator_type;
+		using slot_pointer = typename slot_alloc_traits::pointer;
+
+		[[no_unique_address]] Hash hash_;
+		[[no_unique_address]] KeyEqual key_equal_;
+		[[no_unique_address]] Allocator alloc_;
+		slot_pointer slots_ = nullptr;
+		size_t capacity_ = 0;// 0 or a power of two >= min_capacity
+		size_t shift_ = 64;  // 64 - log2(capacity_)
+		size_t size_ = 0;
+
+		[[nodiscard]] Slot *slots() const noexcept {
+			return std::to_address(slots_);
+		}
+
+		[[nodiscard]] size_t tag_of(Key const &key) const noexcept(noexcept(hash_(key))) {
+			return static_cast<size_t>(hash_(key)) | 1;
+		}
+
+		[[nodiscard]] size_t bucket(size_t tag) const noexcept {
+			return static_cast<size_t>((static_cast<uint64_t>(tag) * 0x9E3779B97F4A7C15UL) >> shift_);
+		}
+
+		[[nodiscard]] static size_t max_size_for(size_t capacity) noexcept {
+			return capacity / 4 * 3;
+		}
+
+		/**
+		 * @return the index of the slot of key or of the empty slot where it would be inserted
+		 * @pre capacity_ > 0
+		 */
+		[[nodiscard]] size_t probe(Key const &key, size_t tag) const {
+			auto const mask = capacity_ - 1;
+			for (auto ix = bucket(tag);; ix = (ix + 1) & mask) {
+				auto const &slot = slots()[ix];
+				if (slot.tag == empty_tag || (slot.tag == tag && key_equal_(slot.value.first, key))) {
+					return ix;
+				}
+			}
+		}
+
+		void prefetch_bucket(size_t tag) const noexcept {
+			detail::prefetch(slots() + bucket(tag));
+		}
+
+		template<typename... Args>
+		void construct_value(Slot &slot, size_t tag, Args &&...args) {
+			value_allocator value_alloc{alloc_};
+			value_alloc_traits::construct(value_alloc, std::addressof(slot.value), std::forward<Args>(args)...);
+			slot.tag = tag;
+		}
+
+		void destroy_value(Slot &slot) noexcept {
+			value_allocator value_alloc{alloc_};
+			value_alloc_traits::destroy(value_alloc, std::addressof(slot.value));
+			slot.tag = empty_tag;
+		}
+
+		[[nodiscard]] slot_pointer allocate_slots(size_t capacity) {
+			slot_allocator slot_alloc{alloc_};
+			auto new_slots = slot_alloc_traits::allocate(slot_alloc, capacity);
+			for (size_t ix = 0; ix < capacity; ++ix) {
+				slot_alloc_traits::construct(slot_alloc, std::to_address(new_slots) + ix);
+			}
+			return new_slots;
+		}
+
+		/**
+		 * @brief destroys all values and frees the slots
+		 */
+		void deallocate_slots() noexcept {
+			if (slots_ == nullptr) {
+				return;
+			}
+
+			slot_allocator slot_alloc{alloc_};
+			for (size_t ix = 0; ix < capacity_; ++ix) {
+				auto &slot = slots()[ix];
+				if (slot.tag != empty_tag) {
+					destroy_value(slot);
+				}
+				slot_alloc_traits::destroy(slot_alloc, &slot);
+			}
+			slot_alloc_traits::deallocate(slot_alloc, slots_, capacity_);
+			slots_ = nullptr;
+		}
+
+		/**
+		 * @brief moves all entries into a table with new_capacity slots (the stored tags are reused, keys are not rehashed)
+		 */
+		void rehash(size_t new_capacity) {
+			auto const old_slots = slots_;
+			auto const old_capacity = capacity_;
+
+			slots_ = allocate_slots(new_capacity);
+			capacity_ = new_capacity;
+			shift_ = 64 - static_cast<size_t>(std::countr_zero(new_capacity));
+
+			if (old_slots == nullptr) {
+				return;
+			}
+
+			slot_allocator slot_alloc{alloc_};
+			auto const mask = capacity_ - 1;
+			for (size_t ix = 0; ix < old_capacity; ++ix) {
+				auto &src = std::to_address(old_slots)[ix];
+				if (src.tag != empty_tag) {
+					auto dst = bucket(src.tag);
+					while (slots()[dst].tag != empty_tag) {
+						dst = (dst + 1) & mask;
+					}
+					construct_value(slots()[dst], src.tag, std::move(src.value));
+					destroy_value(src);
+				}
+				slot_alloc_traits::destroy(slot_alloc, &src);
+			}
+			slot_alloc_traits::deallocate(slot_alloc, old_slots, old_capacity);
+		}
+
+		/**
+		 * @return whether inserting one more entry would exceed the maximum load factor
+		 */
+		[[nodiscard]] bool needs_grow_for_insert() const noexcept {
+			return size_ + 1 > max_size_for(capacity_);
+		}
+
+		void grow_for_insert() {
+			rehash(capacity_ == 0 ? min_capacity : capacity_ * 2);
+		}
+
+		template<typename... Args>
+		std::pair<Value *, bool> emplace_at(Slot &slot, size_t tag, Key const &key, Args &&...args) {
+			construct_value(slot, tag, std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Args>(args)...));
+			++size_;
+			return {&slot.value.second, true};
+		}
+
+		/**
+		 * @pre the table has room for one more entry
+		 */
+		template<typename... Args>
+		std::pair<Value *, bool> try_emplace_impl(size_t tag, Key const &key, Args &&...args) {
+			auto &slot = slots()[probe(key, tag)];
+			if (slot.tag != empty_tag) {
+				return {&slot.value.second, false};
+			}
+			return emplace_at(slot, tag, key, std::forward<Args>(args)...);
+		}
+
+		/**
+		 * @brief takes the slots (and hash and key_equal) of other, other is left empty
+		 * @pre this has no slots and other's slots can be freed with alloc_
+		 */
+		void take_slots(FlatHashMap &other) noexcept {
+			using std::swap;
+			swap(hash_, other.hash_);
+			swap(key_equal_, other.key_equal_);
+			slots_ = std::exchange(other.slots_, nullptr);
+			capacity_ = std::exchange(other.capacity_, 0);
+			shift_ = std::exchange(other.shift_, 64);
+			size_ = std::exchange(other.size_, 0);
+		}
+
+		/**
+		 * @brief fills this (which has no slots) with copies of or moved entries of other, in a table of the same capacity
+		 */
+		template<typename Other>
+		void construct_entries_from(Other &&other) {
+			if (other.capacity_ == 0) {
+				return;
+			}
+
+			slots_ = allocate_slots(other.capacity_);
+			capacity_ = other.capacity_;
+			shift_ = other.shift_;
+			try {
+				// same capacity, so every entry can stay in its slot
+				for (size_t ix = 0; ix < capacity_; ++ix) {
+					auto &src = other.slots()[ix];
+					if (src.tag != empty_tag) {
+						if constexpr (std::is_lvalue_reference_v<Other>) {
+							construct_value(slots()[ix], src.tag, src.value);
+						} else {
+							construct_value(slots()[ix], src.tag, std::move(src.value));
+						}
+						++size_;
+					}
+				}
+			} catch (...) {
+				deallocate_slots();
+				capacity_ = 0;
+				shift_ = 64;
+				size_ = 0;
+				throw;
+			}
+		}
+
+		/**
+		 * @brief calls process(i, tag) for every key, PrefetchDistance keys after their bucket was prefetched
+		 */
+		template<size_t PrefetchDistance, typename KeyAt, typename Process>
+		void pipelined(size_t n, KeyAt &&key_at, Process &&process) const {
+			static_assert(PrefetchDistance > 0 && std::has_single_bit(PrefetchDistance), "PrefetchDistance must be a power of two");
+
+			std::array<size_t, PrefetchDistance> tags;
+			for (size_t ix = 0; ix < std::min(n, PrefetchDistance); ++ix) {
+				tags[ix] = tag_of(key_at(ix));
+				prefetch_bucket(tags[ix]);
+			}
+
+			for (size_t ix = 0; ix < n; ++ix) {
+				auto &ring_entry = tags[ix % PrefetchDistance];
+				auto const tag = ring_entry;
+				if (ix + PrefetchDistance < n) {
+					ring_entry = tag_of(key_at(ix + PrefetchDistance));
+					prefetch_bucket(ring_entry);
+				}
+				process(ix, tag);
+			}
+		}
+
+		template<size_t PrefetchDistance, typename Self, typename F>
+		static void find_bulk_impl(Self &self, std::span<Key const> keys, F &&on_result) {
+			if (self.size_ == 0) {
+				for (size_t ix = 0; ix < keys.size(); ++ix) {
+					on_result(ix, nullptr);
+				}
+				return;
+			}
+
+			self.template pipelined<PrefetchDistance>(
+					keys.size(),
+					[&keys](size_t ix) -> Key const & { return keys[ix]; },
+					[&](size_t ix, size_t tag) {
+						auto &slot = self.slots()[self.probe(keys[ix], tag)];
+						on_result(ix, slot.tag == empty_tag ? nullptr : &slot.value.second);
+					});
+		}
+
+	public:
+		/**
+		 * @param expected_size number of entries the table should hold without growing
+		 */
+		explicit FlatHashMap(size_t expected_size = 0, Hash const &hash = Hash{}, KeyEqual const &key_equal = KeyEqual{},
+							 Allocator const &alloc = Allocator{})
+			: hash_{hash}, key_equal_{key_equal}, alloc_{alloc} {
+			reserve(expected_size);
+		}
+
+		FlatHashMap(FlatHashMap const &other)
+			: FlatHashMap{other, alloc_traits::select_on_container_copy_construction(other.alloc_)} {
+		}
+
+		FlatHashMap(FlatHashMap const &other, Allocator const &alloc)
+			: hash_{other.hash_}, key_equal_{other.key_equal_}, alloc_{alloc} {
+			construct_entries_from(other);
+		}
+
+		FlatHashMap(FlatHashMap &&other) noexcept
+			: hash_{std::move(other.hash_)},
+			  key_equal_{std::move(other.key_equal_)},
+			  alloc_{std::move(other.alloc_)},
+			  slots_{std::exchange(other.slots_, nullptr)},
+			  capacity_{std::exchange(other.capacity_, 0)},
+			  shift_{std::exchange(other.shift_, 64)},
+			  size_{std::exchange(other.size_, 0)} {
+		}
+
+		/**
+		 * @brief takes the slots of other if alloc can free them, otherwise moves the entries one by one into slots from alloc
+		 */
+		FlatHashMap(FlatHashMap &&other, Allocator const &alloc)
+			: hash_{std::move(other.hash_)}, key_equal_{std::move(other.key_equal_)}, alloc_{alloc} {
+			if (alloc_traits::is_always_equal::value || alloc_ == other.alloc_) {
+				slots_ = std::exchange(other.slots_, nullptr);
+				capacity_ = std::exchange(other.capacity_, 0);
+				shift_ = std::exchange(other.shift_, 64);
+				size_ = std::exchange(other.size_, 0);
+			} else {
+				construct_entries_from(std::move(other));
+			}
+		}
+
+		/**
+		 * @brief replaces the entries with copies of the entries of other, the allocator is copied only if it propagates on copy assignment
+		 */
+		FlatHashMap &operator=(FlatHashMap const &other) {
+			if (this == &other) {
+				return *this;
+			}
+
+			constexpr bool propagate = alloc_traits::propagate_on_container_copy_assignment::value;
+			// copy first, so this stays unchanged if copying throws
+			FlatHashMap copy{other, propagate ? other.alloc_ : alloc_};
+			deallocate_slots();
+			if constexpr (propagate) {
+				alloc_ = other.alloc_;
+			}
+			take_slots(copy);
+			return *this;
+		}
+
+		/**
+		 * @brief takes the entries of other; if the allocator does not propagate on move assignment and differs from other's,
+		 * the entries are moved one by one instead
+		 */
+		FlatHashMap &operator=(FlatHashMap &&other) noexcept(alloc_traits::propagate_on_container_move_assignment::value
+															 || alloc_traits::is_always_equal::value) {
+			if (this == &other) {
+				return *this;
+			}
+
+			if constexpr (alloc_traits::propagate_on_container_move_assignment::value) {
+				deallocate_slots();
+				alloc_ = std::move(other.alloc_);
+				take_slots(other);
+			} else if (alloc_traits::is_always_equal::value || alloc_ == other.alloc_) {
+				deallocate_slots();
+				take_slots(other);
+			} else {
+				FlatHashMap moved{std::move(other), alloc_};
+				deallocate_slots();
+				take_slots(moved);
+			}
+			return *this;
+		}
+
+		~FlatHashMap() {
+			deallocate_slots();
+		}
+
+		void swap(FlatHashMap &other) noexcept {
+			using std::swap;
+			swap(hash_, other.hash_);
+			swap(key_equal_, other.key_equal_);
+			swap(alloc_, other.alloc_);
+			swap(slots_, other.slots_);
+			swap(capacity_, other.capacity_);
+			swap(shift_, other.shift_);
+			swap(size_, other.size_);
+		}
+
+		friend void swap(FlatHashMap &lhs, FlatHashMap &rhs) noexcept {
+			lhs.swap(rhs);
+		}
+
+		[[nodiscard]] size_t size() const noexcept {
+			return size_;
+		}
+
+		[[nodiscard]] bool empty() const noexcept {
+			return size_ == 0;
+		}
+
+		/**
+		 * @return number of slots
+		 */
+		[[nodiscard]] size_t capacity() const noexcept {
+			return capacity_;
+		}
+
+		/**
+		 * @brief grows the table so that it can hold n entries without growing again
+		 */
+		void reserve(size_t n) {
+			if (n <= max_size_for(capacity_)) {
+				return;
+			}
+
+			auto new_capacity = std::max(capacity_, min_capacity);
+			while (max_size_for(new_capacity) < n) {
+				new_capacity *= 2;
+			}
+			rehash(new_capacity);
+		}
+
+		/**
+		 * @brief removes all entries, keeps the capacity
+		 */
+		void clear() noexcept {
+			for (size_t ix = 0; ix < capacity_; ++ix) {
+				if (auto &slot = slots()[ix]; slot.tag != empty_tag) {
+					destroy_value(slot);
+				}
+			}
+			size_ = 0;
+		}
+
+		/**
+		 * @brief inserts key with a value constructed from args if key is not in the map
+		 * @return pointer to the value of key and whether it was inserted
+		 */
+		template<typename... Args>
+		std::pair<Value *, bool> try_emplace(Key const &key, Args &&...args) {
+			auto const tag = tag_of(key);
+			// probe first: finding an existing key never grows the table (and never invalidates pointers)
+			if (capacity_ > 0) {
+				auto &slot = slots()[probe(key, tag)];
+				if (slot.tag != empty_tag) {
+					return {&slot.value.second, false};
+				}
+				if (!needs_grow_for_insert()) {
+					return emplace_at(slot, tag, key, std::forward<Args>(args)...);
+				}
+			}
+
+			// key might refer into an entry that growing moves, so it is copied first
+			Key const key_copy{key};
+			grow_for_insert();
+			return emplace_at(slots()[probe(key_copy, tag)], tag, key_copy, std::forward<Args>(args)...);
+		}
+
+		/**
+		 * @brief inserts the entry if its key is not in the map
+		 * @return pointer to the value of the key and whether it was inserted
+		 */
+		std::pair<Value *, bool> insert(value_type const &entry) {
+			return try_emplace(entry.first, entry.second);
+		}
+
+		/**
+		 * @return the value of key, default constructed and inserted if key is not in the map
+		 */
+		Value &operator[](Key const &key) {
+			return *try_emplace(key).first;
+		}
+
+		/**
+		 * @return the value of key or nullptr if key is not in the map
+		 */
+		[[nodiscard]] Value *find(Key const &key) {
+			return const_cast<Value *>(std::as_const(*this).find(key));
+		}
+
+		/**
+		 * @return the value of key or nullptr if key is not in the map
+		 */
+		[[nodiscard]] Value const *find(Key const &key) const {
+			if (size_ == 0) {
+				return nullptr;
+			}
+
+			auto const &slot = slots()[probe(key, tag_of(key))];
+			return slot.tag == empty_tag ? nullptr : &slot.value.second;
+		}
+
+		[[nodiscard]] bool contains(Key const &key) const {
+			return find(key) != nullptr;
+		}
+
+		/**
+		 * @brief removes key (and its value) from the map
+		 * @return whether key was in the map
+		 */
+		bool erase(Key const &key) {
+			if (size_ == 0) {
+				return false;
+			}
+
+			auto hole = probe(key, tag_of(key));
+			if (slots()[hole].tag == empty_tag) {
+				return false;
+			}
+			destroy_value(slots()[hole]);
+			--size_;
+
+			// backward shift deletion: move later entries of the probe sequence into the hole, so lookups do not stop early
+			auto const mask = capacity_ - 1;
+			for (auto ix = (hole + 1) & mask; slots()[ix].tag != empty_tag; ix = (ix + 1) & mask) {
+				auto const home = bucket(slots()[ix].tag);
+				// the entry may move to hole if hole is cyclically in [home, ix)
+				if (((ix - home) & mask) >= ((ix - hole) & mask)) {
+					construct_value(slots()[hole], slots()[ix].tag, std::move(slots()[ix].value));
+					destroy_value(slots()[ix]);
+					hole = ix;
+				}
+			}
+			return true;
+		}
+
+		/**
+		 * @brief calls f(key, value) for every entry (in unspecified order)
+		 */
+		template<typename F>
+		void for_each(F &&f) const {
+			for (size_t ix = 0; ix < capacity_; ++ix) {
+				if (auto const &slot = slots()[ix]; slot.tag != empty_tag) {
+					f(slot.value.first, slot.value.second);
+				}
+			}
+		}
+
+		/**
+		 * @brief calls f(key, value) for every entry (in unspecified order)
+		 */
+		template<typename F>
+		void for_each(F &&f) {
+			for (size_t ix = 0; ix < capacity_; ++ix) {
+				if (auto &slot = slots()[ix]; slot.tag != empty_tag) {
+					f(std::as_const(slot.value.first), slot.value.second);
+				}
+			}
+		}
+
+		/**
+		 * @brief looks up all keys, pipelined: the buckets of the keys are prefetched PrefetchDistance lookups ahead
+		 * @param keys keys to look up
+		 * @param on_result called with (index in keys, pointer to the value or nullptr) in the order of keys
+		 */
+		template<size_t PrefetchDistance = default_prefetch_distance, typename F>
+		void find_bulk(std::span<Key const> keys, F &&on_result) const {
+			find_bulk_impl<PrefetchDistance>(*this, keys, std::forward<F>(on_result));
+		}
+
+		/**
+		 * @brief looks up all keys, pipelined: the buckets of the keys are prefetched PrefetchDistance lookups ahead
+		 * @param keys keys to look up
+		 * @param on_result called with (index in keys, pointer to the value or nullptr) in the order of keys
+		 */
+		template<size_t PrefetchDistance = default_prefetch_distance, typename F>
+		void find_bulk(std::span<Key const> keys, F &&on_result) {
+			find_bulk_impl<PrefetchDistance>(*this, keys, std::forward<F>(on_result));
+		}
+
+		/**
+		 * @brief looks up all keys, pipelined (see find_bulk)
+		 * @param keys keys to look up
+		 * @param values receives a pointer to the value of keys[i] (or nullptr) at index i, must have the size of keys
+		 */
+		template<size_t PrefetchDistance = default_prefetch_distance>
+		void find_bulk(std::span<Key const> keys, std::span<Value const *> values) const {
+			assert(values.size() == keys.size());
+			find_bulk<PrefetchDistance>(keys, [values](size_t ix, Value const *value) { values[ix] = value; });
+		}
+
+		/**
+		 * @brief inserts all entries whose keys are not in the map yet (the first one wins for duplicate keys), pipelined like find_bulk
+		 * @return number of inserted entries
+		 * @note grows the table for all entries up front, even if their keys are already in the map
+		 */
+		template<size_t PrefetchDistance = default_prefetch_distance>
+		size_t insert_bulk(std::span<value_type const> entries) {
+			// grow first, so the table (and the prefetched buckets) stay the same during the pipeline
+			reserve(size_ + entries.size());
+
+			size_t inserted = 0;
+			pipelined<PrefetchDistance>(
+					entries.size(),
+					[&entries](size_t ix) -> Key const & { return entries[ix].first; },
+					[&](size_t ix, size_t tag) {
+						inserted += try_emplace_impl(tag, entries[ix].first, entries[ix].second).second;
+					});
+			return inserted;
+		}
+
+		[[nodiscard]] hasher hash_function() const {
+			return hash_;
+		}
+
+		[[nodiscard]] key_equal key_eq() const {
+			return key_equal_;
+		}
+
+		[[nodiscard]] allocator_type get_allocator() const noexcept {
+			return alloc_;
+		}
+	};
+
+}// namespace dice::hash
+
+#endif//DICE_HASH_FLATHASHMAP_HPP
@@ -0,0 +1,362 @@
+#ifndef DICE_HASH_HASHFILE_HPP
+#define DICE_HASH_HASHFILE_HPP
+
+/** @file
+ * @brief Hashing of file contents without first copying them into a user-space buffer.
+ *
+ * Files are memory mapped whenever possible. If that is not possible (e.g. the file is a pipe or mmap is not supported
+ * by the underlying filesystem) they are streamed using large, page aligned pread/read calls with readahead hints.
+ */
+
+#if __has_include(<sys/mman.h>) && __has_include(<unistd.h>)
+
+#include <dice/hash/DiceHash.hpp>
+#include <dice/hash/ThreadPool.hpp>
+#include <dice/hash/blake/Blake3.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <new>
+#include <span>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace dice::hash {
+
+	/**
+	 * @brief How the contents of a file are read
+	 */
+	enum struct FileReadMode {
+		automatic, ///< memory map the file if possible, otherwise fall back to stream
+		mmap,	   ///< memory map the file, throw if that is not possible
+		stream,	   ///< read the file in large blocks using pread/read
+	};
+
+	struct FileHashOptions {
+		FileReadMode mode = FileReadMode::automatic;
+
+		/**
+		 * @brief size of the blocks passed to the hasher, rounded up to a multiple of the page size when streaming
+		 */
+		size_t block_size = size_t{4} << 20;
+	};
+
+	/**
+	 * @brief A hasher that can consume data incrementally, e.g. blake3::Blake3, blake2b::Blake2b and blake2xb::Blake2Xb
+	 */
+	template<typename H>
+	concept DigestingHasher = requires (H &hasher, std::span<std::byte const> data) {
+		hasher.digest(data);
+	};
+
+	namespace detail::file {
+		[[noreturn]] inline void throw_errno(char const *what, std::filesystem::path const &path) {
+			throw std::system_error{errno, std::generic_category(), std::string{what} + " " + path.string()};
+		}
+
+		/**
+		 * @brief RAII wrapper around a read-only file descriptor
+		 */
+		class File {
+			int fd_;
+			struct stat stat_;
+
+		public:
+			explicit File(std::filesystem::path const &path) : fd_{::open(path.c_str(), O_RDONLY | O_CLOEXEC)} {
+				if (fd_ == -1) {
+					throw_errno("Could not open", path);
+				}
+
+				if (::fstat(fd_, &stat_) == -1) {
+					auto const err = errno;
+					::close(fd_);
+					errno = err;
+					throw_errno("Could not stat", path);
+				}
+			}
+
+			File(File const &) = delete;
+			File &operator=(File const &) = delete;
+
+			~File() {
+				::close(fd_);
+			}
+
+			[[nodiscard]] int fd() const noexcept {
+				return fd_;
+			}
+
+			[[nodiscard]] bool is_regular() const noexcept {
+				return S_ISREG(stat_.st_mode);
+			}
+
+			[[nodiscard]] size_t size() const noexcept {
+				return static_cast<size_t>(stat_.st_size);
+			}
+
+			/**
+			 * @brief whether reading the file yields no bytes at all
+			 * @note files in procfs or sysfs report a size of 0 but still have contents
+			 */
+			[[nodiscard]] bool reads_empty(std::filesystem::path const &path) const {
+				std::byte first;
+				while (true) {
+					auto const res = ::pread(fd_, &first, 1, 0);
+					if (res != -1) {
+						return res == 0;
+					}
+					if (errno != EINTR) {
+						throw_errno("Could not read", path);
+					}
+				}
+			}
+		};
+
+		/**
+		 * @brief throws if a file that could not be memory mapped has to be, i.e. unless it is empty
+		 */
+		inline void require_mmap_fallback_is_empty(File const &file, std::filesystem::path const &path) {
+			if (file.is_regular() && file.size() == 0) {
+				// empty files cannot be mapped, files that only report a size of 0 have contents that would be lost
+				if (file.reads_empty(path)) {
+					return;
+				}
+				errno = EINVAL;
+			}
+			throw_errno("Could not mmap", path);
+		}
+
+		/**
+		 * @brief RAII wrapper around a read-only memory mapping of a whole file
+		 */
+		class Mapping {
+			void *addr_ = MAP_FAILED;
+			size_t size_ = 0;
+
+		public:
+			/**
+			 * @brief Tries to map the file, check valid() afterwards
+			 */
+			Mapping(File const &file, int advice) noexcept {
+				if (!file.is_regular() || file.size() == 0) {
+					return;
+				}
+
+				addr_ = ::mmap(nullptr, file.size(), PROT_READ, MAP_PRIVATE, file.fd(), 0);
+				if (addr_ != MAP_FAILED) {
+					size_ = file.size();
+					::madvise(addr_, size_, advice); // only a hint, failure is irrelevant
+				}
+			}
+
+			Mapping(Mapping const &) = delete;
+			Mapping &operator=(Mapping const &) = delete;
+
+			~Mapping() {
+				if (addr_ != MAP_FAILED) {
+					::munmap(addr_, size_);
+				}
+			}
+
+			[[nodiscard]] bool valid() const noexcept {
+				return addr_ != MAP_FAILED;
+			}
+
+			[[nodiscard]] std::span<std::byte const> bytes() const noexcept {
+				return {static_cast<std::byte const *>(addr_), size_};
+			}
+		};
+
+		struct AlignedDelete {
+			std::align_val_t alignment;
+
+			void operator()(std::byte *ptr) const noexcept {
+				::operator delete[](ptr, alignment);
+			}
+		};
+
+		/**
+		 * @brief Calls f with consecutive, page aligned blocks of the file contents
+		 */
+		template<typename F>
+		void stream_blocks(File const &file, std::filesystem::path const &path, size_t block_size, F &&f) {
+			auto const page_size = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+			block_size = std::max(page_size, (block_size + page_size - 1) / page_size * page_size);
+
+			std::align_val_t const alignment{page_size};
+			std::unique_ptr<std::byte[], AlignedDelete> const buffer{static_cast<std::byte *>(::operator new[](block_size, alignment)),
+																	 AlignedDelete{alignment}};
+
+			bool const seekable = file.is_regular();
+			if (seekable) {
+				::posix_fadvise(file.fd(), 0, 0, POSIX_FADV_SEQUENTIAL);
+			}
+
+			off_t offset = 0;
+			while (true) {
+				size_t filled = 0;
+				while (filled < block_size) {
+					auto const res = seekable
+											 ? ::pread(file.fd(), buffer.get() + filled, block_size - filled, offset + static_cast<off_t>(filled))
+											 : ::read(file.fd(), buffer.get() + filled, block_size - filled);
+					if (res == -1) {
+						if (errno == EINTR) {
+							continue;
+						}
+						throw_errno("Could not read", path);
+					}
+					if (res == 0) {
+						break;
+					}
+					filled += static_cast<size_t>(res);
+				}
+
+				if (filled == 0) {
+					return;
+				}
+
+				offset += static_cast<off_t>(filled);
+				if (seekable) {
+					// let the kernel fetch the next block while the current one is being hashed
+					::posix_fadvise(file.fd(), offset, static_cast<off_t>(block_size), POSIX_FADV_WILLNEED);
+				}
+
+				f(std::span<std::byte const>{buffer.get(), filled});
+
+				if (filled < block_size && seekable) {
+					return;
+				}
+			}
+		}
+
+		/**
+		 * @brief Calls f with the contents of the file, either as a single span (mmap) or as consecutive blocks (stream)
+		 */
+		template<typename F>
+		void for_each_block(std::filesystem::path const &path, FileHashOptions const &options, int advice, F &&f) {
+			File const file{path};
+
+			if (options.mode != FileReadMode::stream) {
+				Mapping const mapping{file, advice};
+				if (mapping.valid()) {
+					f(mapping.bytes());
+					return;
+				}
+
+				if (options.mode == FileReadMode::mmap) {
+					require_mmap_fallback_is_empty(file, path);
+					return;
+				}
+			}
+
+			stream_blocks(file, path, options.block_size, f);
+		}
+	} // namespace detail::file
+
+	/**
+	 * @brief digests the contents of the file at path into hasher
+	 * @throws std::system_error if the file cannot be read
+	 */
+	template<DigestingHasher H>
+	void digest_file(H &hasher, std::filesystem::path const &path, FileHashOptions const &options = {}) {
+		detail::file::for_each_block(path, options, MADV_SEQUENTIAL, [&](std::span<std::byte const> data) {
+			hasher.digest(data);
+		});
+	}
+
+	/**
+	 * @brief digests the contents of the file at path into hasher, hashing independent parts of the file on executor
+	 * @note the resulting state is identical to digest_file(hasher, path)
+	 * @throws std::system_error if the file cannot be read
+	 */
+	template<size_t OutputExtent, Executor E>
+	void digest_file_parallel(blake3::Blake3<OutputExtent> &hasher, std::filesystem::path const &path, E &executor, FileHashOptions const &options = {}) {
+		// workers touch different parts of the file at the same time, sequential readahead would not help
+		detail::file::for_each_block(path, options, MADV_NORMAL, [&](std::span<std::byte const> data) {
+			hasher.digest_parallel(data, executor);
+		});
+	}
+
+	/**
+	 * @brief digests the contents of the file at path into hasher, hashing independent parts of the file on ThreadPool::global()
+	 * @note the resulting state is identical to digest_file(hasher, path)
+	 * @throws std::system_error if the file cannot be read
+	 */
+	template<size_t OutputExtent>
+	void digest_file_parallel(blake3::Blake3<OutputExtent> &hasher, std::filesystem::path const &path, FileHashOptions const &options = {}) {
+		detail::file::for_each_block(path, options, MADV_NORMAL, [&](std::span<std::byte const> data) {
+			hasher.digest_parallel(data);
+		});
+	}
+
+	/**
+	 * @brief convenience function to hash a whole file with a DigestingHasher (e.g. blake3::Blake3, blake2b::Blake2b, blake2xb::Blake2Xb)
+	 * @param out location to write the hash to, for hashers with dynamic output extent this also determines the output length
+	 * @throws std::system_error if the file cannot be read
+	 */
+	template<DigestingHasher Hasher>
+	void hash_file(std::filesystem::path const &path, std::span<std::byte, Hasher::output_extent> out, FileHashOptions const &options = {}) {
+		auto hasher = [&]() {
+			if constexpr (Hasher::output_extent == std::dynamic_extent && std::is_constructible_v<Hasher, size_t>) {
+				return Hasher{out.size()};
+			} else {
+				return Hasher{};
+			}
+		}();
+
+		digest_file(hasher, path, options);
+		std::move(hasher).finish(out);
+	}
+
+	/**
+	 * @brief hashes a whole file with a DiceHash policy
+	 * @return the same value as DiceHash<std::string_view, Policy>{}(contents of the file)
+	 * @note DiceHash policies cannot hash incrementally, if the file cannot be memory mapped it is read into memory as a whole
+	 * @throws std::system_error if the file cannot be read
+	 */
+	template<Policies::HashPolicy Policy>
+	std::size_t hash_file(std::filesystem::path const &path, FileHashOptions const &options = {}) {
+		detail::file::File const file{path};
+
+		if (options.mode != FileReadMode::stream) {
+			detail::file::Mapping const mapping{file, MADV_SEQUENTIAL};
+			if (mapping.valid()) {
+				auto const data = mapping.bytes();
+				return Policy::hash_bytes(data.data(), data.size());
+			}
+
+			if (options.mode == FileReadMode::mmap) {
+				detail::file::require_mmap_fallback_is_empty(file, path);
+				return Policy::hash_bytes(nullptr, 0);
+			}
+		}
+
+		std::vector<std::byte> contents;
+		if (file.is_regular()) {
+			contents.reserve(file.size());
+		}
+
+		detail::file::stream_blocks(file, path, options.block_size, [&](std::span<std::byte const> data) {
+			contents.insert(contents.end(), data.begin(), data.end());
+		});
+
+		return Policy::hash_bytes(contents.data(), contents.size());
+	}
+
+} // namespace dice::hash
+
+#else
+#error "HashFile.hpp requires a POSIX system"
+#endif
+
+#endif // DICE_HASH_HASHFILE_HPP
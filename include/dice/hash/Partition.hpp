@@ -0,0 +1,323 @@
+#ifndef DICE_HASH_PARTITION_HPP
+#define DICE_HASH_PARTITION_HPP
+
+/** @file
+ * @brief Hash partitioning (radix partitioning by the DiceHash of a key), e.g. for the partition phase of parallel hash joins.
+ */
+
+#include "dice/hash/DiceHash.hpp"
+#include "dice/hash/ThreadPool.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace dice::hash {
+
+	/**
+	 * @brief maps hash to a partition in [0, n_partitions) by multiply-shift, i.e. (hash * n_partitions) / 2^64 (without a division)
+	 * @note the partition is determined by the upper bits of hash, so hash must be well mixed (the DiceHash is)
+	 */
+	[[nodiscard]] constexpr size_t partition_of(size_t hash, size_t n_partitions) noexcept {
+		if constexpr (sizeof(size_t) == 8) {
+#ifdef __SIZEOF_INT128__
+			return static_cast<size_t>((static_cast<__uint128_t>(hash) * n_partitions) >> 64);
+#else
+			// upper 64 bits of the 128 bit product, exact for n_partitions <= 2^32
+			return static_cast<size_t>(((hash >> 32) * n_partitions + (((hash & 0xFFFFFFFF) * n_partitions) >> 32)) >> 32);
+#endif
+		} else {
+			return static_cast<size_t>((static_cast<uint64_t>(hash) * n_partitions) >> 32);
+		}
+	}
+
+	/**
+	 * @brief Partitions values by the hash of their key into n_partitions partitions.
+	 *
+	 * scatter is the classic two pass radix partitioning, parallelized over chunks of the input:
+	 *  1. every chunk hashes its values in batches, maps the hashes to partitions with partition_of and counts the values per partition
+	 *  2. the prefix sum over the histograms (partition major, chunk minor) yields where each chunk writes each partition
+	 *  3. every chunk scatters its values to the output, through one cache line sized buffer per partition
+	 *     (software write combining): the buffers mirror the cache lines of the output, full lines are written at once
+	 *     with non-temporal stores (on x86), so the output is neither read (for ownership) nor pollutes the cache
+	 *
+	 * The buffers of all partitions have to stay in the cache, so write combining is only used for up to max_buffered_partitions
+	 * partitions; with more partitions the values are scattered directly. Every thread allocates its buffers once and reuses them.
+	 * The input is only split into as many chunks as keep the histograms (a counter per chunk and partition) no larger than the input.
+	 *
+	 * The partitions of pass 1 are kept (4 bytes per value), keys are hashed only once.
+	 * The output is stable: within a partition values are in the order of the input.
+	 *
+	 * @tparam T type of the values
+	 * @tparam KeyOf returns the key of a value, the value itself by default
+	 * @tparam Hash hash function for the keys
+	 */
+	template<typename T, typename KeyOf = std::identity,
+			 typename Hash = DiceHash<std::remove_cvref_t<std::invoke_result_t<KeyOf const &, T const &>>>>
+	class HashPartitioner {
+	public:
+		/**
+		 * @brief number of values that are hashed before their partitions are computed and counted
+		 */
+		static constexpr size_t batch_size = 256;
+
+		/**
+		 * @brief inputs are only split into chunks (and thus tasks) of at least this many values
+		 */
+		static constexpr size_t min_chunk_size = size_t{1} << 14;
+
+		/**
+		 * @brief size of a write combining buffer in bytes
+		 */
+		static constexpr size_t write_combining_bytes = 64;
+
+		/**
+		 * @brief maximum number of partitions that scatter buffers (the buffers take 128 KiB, about the size of an L2 cache)
+		 */
+		static constexpr size_t max_buffered_partitions = 2'048;
+
+		/**
+		 * @brief whether scatter buffers the output (for up to max_buffered_partitions partitions), otherwise values are copied one by one
+		 */
+		static constexpr bool write_combining = std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T>
+												&& sizeof(T) <= write_combining_bytes / 2 && write_combining_bytes % sizeof(T) == 0;
+
+		/**
+		 * @brief number of values in a write combining buffer
+		 */
+		static constexpr size_t line_size = write_combining ? write_combining_bytes / sizeof(T) : 1;
+
+	private:
+		size_t n_partitions_;
+		[[no_unique_address]] KeyOf key_of_;
+		[[no_unique_address]] Hash hash_;
+
+		struct Chunk {
+			size_t begin;
+			size_t end;
+		};
+
+		/**
+		 * @brief splits n values into at most concurrency chunks of at least min_chunk_size and n_partitions_ values,
+		 * so the histograms are no larger than the input
+		 */
+		[[nodiscard]] std::vector<Chunk> make_chunks(size_t n, size_t concurrency) const {
+			auto const n_chunks = std::max<size_t>(1, std::min({concurrency, n / min_chunk_size, n / n_partitions_}));
+			std::vector<Chunk> chunks;
+			chunks.reserve(n_chunks);
+			for (size_t ix = 0; ix < n_chunks; ++ix) {
+				chunks.push_back(Chunk{.begin = n * ix / n_chunks, .end = n * (ix + 1) / n_chunks});
+			}
+			return chunks;
+		}
+
+		/**
+		 * @brief pass 1: computes the partitions of the values in chunk and counts them in histogram
+		 */
+		void compute_partitions(std::span<T const> in, Chunk chunk, std::span<uint32_t> partitions, std::span<size_t> histogram) const {
+			std::array<size_t, batch_size> hashes;
+			for (auto batch_begin = chunk.begin; batch_begin < chunk.end; batch_begin += batch_size) {
+				auto const len = std::min(batch_size, chunk.end - batch_begin);
+				for (size_t ix = 0; ix < len; ++ix) {
+					hashes[ix] = hash_(std::invoke(key_of_, in[batch_begin + ix]));
+				}
+				for (size_t ix = 0; ix < len; ++ix) {
+					auto const partition = partition_of(hashes[ix], n_partitions_);
+					partitions[batch_begin + ix] = static_cast<uint32_t>(partition);
+					++histogram[partition];
+				}
+			}
+		}
+
+		/**
+		 * @brief writes a full line to the cache line aligned dst, bypassing the cache where possible (the output is not read again soon)
+		 */
+		static void store_line(T *dst, T const *src) noexcept {
+#if defined(__SSE2__)
+			auto *dst_vec = reinterpret_cast<__m128i *>(dst);
+			auto const *src_vec = reinterpret_cast<__m128i const *>(src);
+			for (size_t ix = 0; ix < write_combining_bytes / sizeof(__m128i); ++ix) {
+				_mm_stream_si128(dst_vec + ix, _mm_load_si128(src_vec + ix));
+			}
+#else
+			std::copy_n(src, line_size, dst);
+#endif
+		}
+
+		/**
+		 * @brief a write combining buffer, holds the values of one cache line of out
+		 */
+		struct alignas(write_combining_bytes) Line {
+			std::array<T, line_size> values;
+		};
+
+		/**
+		 * @brief the write combining buffers of the calling thread, allocated (for max_buffered_partitions partitions) on its first
+		 * scatter and reused by all later chunks the thread scatters
+		 */
+		struct WorkerBuffers {
+			std::vector<Line> lines;
+			std::vector<size_t> begins;
+
+			static WorkerBuffers &of_this_thread() {
+				static thread_local WorkerBuffers buffers{.lines = std::vector<Line>(max_buffered_partitions),
+														  .begins = std::vector<size_t>(max_buffered_partitions)};
+				return buffers;
+			}
+		};
+
+		/**
+		 * @brief pass 2: writes the values of chunk to out, cursors is the position of the chunk in each partition
+		 */
+		void scatter_chunk(std::span<T const> in, Chunk chunk, std::span<uint32_t const> partitions, std::span<size_t> cursors, std::span<T> out) const {
+			if constexpr (write_combining) {
+				auto const out_address = reinterpret_cast<uintptr_t>(out.data());
+				if (out_address % sizeof(T) == 0 && n_partitions_ <= max_buffered_partitions) {
+					// a line buffers the values of one cache line of out, value i of out is in slot (i + skew) % line_size
+					auto const skew = (out_address % write_combining_bytes) / sizeof(T);
+
+					auto &[lines, begins] = WorkerBuffers::of_this_thread();
+					std::copy(cursors.begin(), cursors.end(), begins.begin());
+					for (auto ix = chunk.begin; ix < chunk.end; ++ix) {
+						auto const partition = partitions[ix];
+						auto const pos = cursors[partition]++;
+						auto const slot = (pos + skew) % line_size;
+						auto &line = lines[partition].values;
+						line[slot] = in[ix];
+						if (slot == line_size - 1) {
+							if (pos + 1 >= begins[partition] + line_size) {
+								store_line(out.data() + pos + 1 - line_size, line.data());
+							} else {
+								// the first line of the partition starts in the middle of a cache line (that other partitions or chunks write as well)
+								auto const n_buffered = pos + 1 - begins[partition];
+								std::copy_n(line.data() + line_size - n_buffered, n_buffered, out.data() + begins[partition]);
+							}
+						}
+					}
+
+					for (size_t partition = 0; partition < n_partitions_; ++partition) {
+						auto const end = cursors[partition];
+						auto const n_buffered = std::min((end + skew) % line_size, end - begins[partition]);
+						auto const &line = lines[partition].values;
+						std::copy_n(line.data() + (end + skew) % line_size - n_buffered, n_buffered, out.data() + end - n_buffered);
+					}
+#if defined(__SSE2__)
+					_mm_sfence();// the streamed lines must be visible once the chunk is finished
+#endif
+					return;
+				}
+			}
+
+			for (auto ix = chunk.begin; ix < chunk.end; ++ix) {
+				out[cursors[partitions[ix]]++] = in[ix];
+			}
+		}
+
+	public:
+		/**
+		 * @param n_partitions number of partitions, in [1, 2^32]
+		 * @throws std::invalid_argument if n_partitions is out of range
+		 */
+		explicit HashPartitioner(size_t n_partitions, KeyOf key_of = KeyOf{}, Hash hash = Hash{})
+			: n_partitions_{n_partitions}, key_of_{std::move(key_of)}, hash_{std::move(hash)} {
+			if (n_partitions == 0 || n_partitions - 1 > std::numeric_limits<uint32_t>::max()) {
+				throw std::invalid_argument{"the number of partitions must be in [1, 2^32]"};
+			}
+		}
+
+		[[nodiscard]] size_t n_partitions() const noexcept {
+			return n_partitions_;
+		}
+
+		/**
+		 * @return the partition of value
+		 */
+		[[nodiscard]] size_t operator()(T const &value) const {
+			return partition_of(hash_(std::invoke(key_of_, value)), n_partitions_);
+		}
+
+		/**
+		 * @brief writes the values of in to out, grouped by partition; the chunks of in are processed on executor
+		 * @return n_partitions() + 1 offsets, partition p is out[offsets[p], offsets[p + 1])
+		 * @throws std::invalid_argument if in and out have different sizes
+		 */
+		template<Executor E>
+		std::vector<size_t> scatter(std::span<T const> in, std::span<T> out, E &executor) const {
+			if (in.size() != out.size()) {
+				throw std::invalid_argument{"input and output of the partitioning must have the same size"};
+			}
+
+			auto const chunks = make_chunks(in.size(), executor.concurrency());
+			auto const n_chunks = chunks.size();
+
+			auto const partitions = std::make_unique_for_overwrite<uint32_t[]>(in.size());
+			std::vector<size_t> histograms(n_chunks * n_partitions_, 0);// chunk major
+			executor.parallel_for(n_chunks, [&](size_t chunk) {
+				compute_partitions(in, chunks[chunk], std::span{partitions.get(), in.size()}, std::span{histograms}.subspan(chunk * n_partitions_, n_partitions_));
+			});
+
+			// exclusive prefix sum over (partition, chunk), turns the histograms into the output cursors
+			std::vector<size_t> offsets(n_partitions_ + 1);
+			size_t sum = 0;
+			for (size_t partition = 0; partition < n_partitions_; ++partition) {
+				offsets[partition] = sum;
+				for (size_t chunk = 0; chunk < n_chunks; ++chunk) {
+					auto &count = histograms[chunk * n_partitions_ + partition];
+					sum += std::exchange(count, sum);
+				}
+			}
+			offsets[n_partitions_] = sum;
+
+			executor.parallel_for(n_chunks, [&](size_t chunk) {
+				scatter_chunk(in, chunks[chunk], std::span<uint32_t const>{partitions.get(), in.size()}, std::span{histograms}.subspan(chunk * n_partitions_, n_partitions_), out);
+			});
+
+			return offsets;
+		}
+
+		/**
+		 * @brief writes the values of in to out, grouped by partition; the chunks of in are processed on ThreadPool::global()
+		 * @return n_partitions() + 1 offsets, partition p is out[offsets[p], offsets[p + 1])
+		 * @throws std::invalid_argument if in and out have different sizes
+		 */
+		std::vector<size_t> scatter(std::span<T const> in, std::span<T> out) const {
+			return scatter(in, out, ThreadPool::global());
+		}
+	};
+
+	/**
+	 * @brief writes the values of in to out, grouped by the partition of their DiceHash (see HashPartitioner)
+	 * @return n_partitions + 1 offsets, partition p is out[offsets[p], offsets[p + 1])
+	 * @throws std::invalid_argument if n_partitions is not in [1, 2^32] or in and out have different sizes
+	 */
+	template<typename T, Executor E>
+	std::vector<size_t> partition(std::type_identity_t<std::span<T const>> in, std::span<T> out, size_t n_partitions, E &executor) {
+		return HashPartitioner<T>{n_partitions}.scatter(in, out, executor);
+	}
+
+	/**
+	 * @brief writes the values of in to out, grouped by the partition of their DiceHash (see HashPartitioner), on ThreadPool::global()
+	 * @return n_partitions + 1 offsets, partition p is out[offsets[p], offsets[p + 1])
+	 * @throws std::invalid_argument if n_partitions is not in [1, 2^32] or in and out have different sizes
+	 */
+	template<typename T>
+	std::vector<size_t> partition(std::type_identity_t<std::span<T const>> in, std::span<T> out, size_t n_partitions) {
+		return HashPartitioner<T>{n_partitions}.scatter(in, out);
+	}
+
+}// namespace dice::hash
+
+#endif//DICE_HASH_PARTITION_HPP
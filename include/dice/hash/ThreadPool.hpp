@@ -0,0 +1,199 @@
+#ifndef DICE_HASH_THREADPOOL_HPP
+#define DICE_HASH_THREADPOOL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace dice::hash {
+
+	/**
+	 * @brief Something that can run a batch of independent tasks, potentially in parallel.
+	 * 		executor.parallel_for(n, f) must invoke f(i) exactly once for every i in [0, n) and must only return
+	 * 		after all invocations finished. If an invocation throws the exception must be propagated to the caller.
+	 * 		executor.concurrency() is a hint on how many invocations can run in parallel.
+	 *
+	 * @note This allows plugging in existing thread pools (e.g. TBB, OpenMP, an application wide pool) by writing a small adapter.
+	 */
+	template<typename E>
+	concept Executor = requires (E &executor, size_t n, std::function<void(size_t)> const &f) {
+		{ executor.concurrency() } -> std::convertible_to<size_t>;
+		executor.parallel_for(n, f);
+	};
+
+	/**
+	 * @brief A minimal fixed size thread pool implementing the Executor concept.
+	 * 		The thread calling parallel_for participates in executing the tasks,
+	 * 		so a pool with concurrency() == n owns n - 1 worker threads.
+	 *
+	 * @note Concurrent calls to parallel_for from different threads are serialized.
+	 * 		Calls from within a task (nested parallelism) are executed inline on the calling thread.
+	 */
+	class ThreadPool {
+		struct Job {
+			void (*invoke)(void const *fn, size_t ix);
+			void const *fn;
+			size_t n;
+			std::atomic<size_t> next;
+			std::exception_ptr error;
+		};
+
+		std::vector<std::thread> workers_;
+
+		std::mutex submit_mutex_;
+
+		std::mutex mutex_;
+		std::condition_variable work_cv_;
+		std::condition_variable idle_cv_;
+		Job *job_ = nullptr;
+		size_t generation_ = 0;
+		size_t active_ = 0;
+		bool stop_ = false;
+
+		static bool &inside_task() noexcept {
+			static thread_local bool inside = false;
+			return inside;
+		}
+
+		void run_tasks(Job &job) noexcept {
+			inside_task() = true;
+			for (size_t ix = job.next.fetch_add(1, std::memory_order_relaxed); ix < job.n; ix = job.next.fetch_add(1, std::memory_order_relaxed)) {
+				try {
+					job.invoke(job.fn, ix);
+				} catch (...) {
+					std::lock_guard lock{mutex_};
+					if (job.error == nullptr) {
+						job.error = std::current_exception();
+					}
+					job.next.store(job.n, std::memory_order_relaxed); // skip remaining tasks
+				}
+			}
+			inside_task() = false;
+		}
+
+		void worker_loop() noexcept {
+			size_t seen_generation = 0;
+
+			std::unique_lock lock{mutex_};
+			while (true) {
+				work_cv_.wait(lock, [&]() { return stop_ || (job_ != nullptr && generation_ != seen_generation); });
+				if (stop_) {
+					return;
+				}
+
+				seen_generation = generation_;
+				Job *job = job_;
+				++active_;
+
+				lock.unlock();
+				run_tasks(*job);
+				lock.lock();
+
+				if (--active_ == 0) {
+					idle_cv_.notify_all();
+				}
+			}
+		}
+
+	public:
+		/**
+		 * @brief Creates a thread pool
+		 * @param concurrency number of tasks that can be executed in parallel (including the calling thread), at least 1
+		 */
+		explicit ThreadPool(size_t concurrency = std::thread::hardware_concurrency()) {
+			concurrency = std::max<size_t>(concurrency, 1);
+			workers_.reserve(concurrency - 1);
+			for (size_t ix = 0; ix < concurrency - 1; ++ix) {
+				workers_.emplace_back([this]() { worker_loop(); });
+			}
+		}
+
+		ThreadPool(ThreadPool const &) = delete;
+		ThreadPool(ThreadPool &&) = delete;
+		ThreadPool &operator=(ThreadPool const &) = delete;
+		ThreadPool &operator=(ThreadPool &&) = delete;
+
+		~ThreadPool() {
+			{
+				std::lock_guard lock{mutex_};
+				stop_ = true;
+			}
+			work_cv_.notify_all();
+
+			for (auto &worker : workers_) {
+				worker.join();
+			}
+		}
+
+		/**
+		 * @brief A lazily constructed, process wide pool with std::thread::hardware_concurrency() threads
+		 */
+		static ThreadPool &global() {
+			static ThreadPool pool;
+			return pool;
+		}
+
+		/**
+		 * @return the number of tasks that can be executed in parallel
+		 */
+		[[nodiscard]] size_t concurrency() const noexcept {
+			return workers_.size() + 1;
+		}
+
+		/**
+		 * @brief Invokes f(i) for every i in [0, n) on the pool and waits until all invocations are finished.
+		 * 		If any invocation throws, the remaining tasks are skipped and the first exception is rethrown.
+		 */
+		template<typename F> requires std::invocable<F const &, size_t>
+		void parallel_for(size_t n, F const &f) {
+			if (n == 0) {
+				return;
+			}
+
+			if (workers_.empty() || n == 1 || inside_task()) {
+				for (size_t ix = 0; ix < n; ++ix) {
+					f(ix);
+				}
+				return;
+			}
+
+			Job job{.invoke = [](void const *fn, size_t ix) { (*static_cast<F const *>(fn))(ix); },
+					.fn = std::addressof(f),
+					.n = n,
+					.next = {0},
+					.error = nullptr};
+
+			std::lock_guard submit_lock{submit_mutex_};
+			{
+				std::lock_guard lock{mutex_};
+				job_ = &job;
+				++generation_;
+			}
+			work_cv_.notify_all();
+
+			run_tasks(job);
+
+			{
+				std::unique_lock lock{mutex_};
+				job_ = nullptr; // no new worker may pick up this job
+				idle_cv_.wait(lock, [&]() { return active_ == 0; });
+			}
+
+			if (job.error != nullptr) {
+				std::rethrow_exception(job.error);
+			}
+		}
+	};
+
+} // namespace dice::hash
+
+#endif // DICE_HASH_THREADPOOL_HPP
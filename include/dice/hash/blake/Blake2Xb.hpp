@@ -18,6 +18,7 @@
 #include <stdexcept>
 #include <limits>
 #include <cassert>
+#include <type_traits>
 
 #include <sodium.h>
 
@@ -102,7 +103,10 @@ namespace dice::hash::blake2xb {
 		ParamBlock param_{};
 		crypto_generichash_blake2b_state state_;
 
-		void init_state(std::span<std::byte const> key) {
+		ParamBlock initial_param_;
+		crypto_generichash_blake2b_state initial_state_;
+
+		void init_state(std::span<std::byte const> key) noexcept {
 			static constexpr std::array<uint64_t, 8> init_vec{0x6a09e667f3bcc908ULL,
 															  0xbb67ae8584caa73bULL,
 															  0x3c6ef372fe94f82bULL,
@@ -154,18 +158,22 @@ namespace dice::hash::blake2xb {
 			}
 		}
 
-		struct PrivateTag {};
-		static constexpr PrivateTag private_tag{};
+		struct UncheckedTag {};
+		static constexpr UncheckedTag unchecked_tag{};
 
-		Blake2Xb(PrivateTag,
-				 size_t output_len,
-				 std::span<std::byte const> key,
-				 std::span<std::byte const, salt_extent> salt,
-				 std::span<std::byte const, personality_extent> personality) {
+		/**
+		 * @brief the value of xof_digest_len in the parameter block if the output length is statically known (or unknown)
+		 */
+		static constexpr uint32_t static_xof_digest_len = output_extent == dynamic_output_extent
+																  ? unknown_output_extend_magic
+																  : static_cast<uint32_t>(output_extent);
 
-			if (output_len == 0) {
-				output_len = unknown_output_extend_magic;
-			} else if (output_len > max_output_extent) {
+		/**
+		 * @brief validates the constructor arguments
+		 * @return the value of xof_digest_len in the parameter block
+		 */
+		static uint32_t validate(size_t output_len, std::span<std::byte const> key) {
+			if (output_len > max_output_extent) {
 				throw std::runtime_error{"Output length too large"};
 			}
 
@@ -175,20 +183,35 @@ namespace dice::hash::blake2xb {
 				}
 			}
 
-			if (auto const res = sodium_init(); res == -1) {
-				throw std::runtime_error{"Could not initialize sodium"};
-			}
+			return output_len == 0 ? unknown_output_extend_magic : static_cast<uint32_t>(output_len);
+		}
+
+		/**
+		 * @pre output length and key have been validated, see validate
+		 */
+		Blake2Xb(UncheckedTag,
+				 uint32_t xof_digest_len,
+				 std::span<std::byte const> key,
+				 std::span<std::byte const, salt_extent> salt,
+				 std::span<std::byte const, personality_extent> personality) noexcept {
+			::dice::hash::detail::sodium_init_once();
 
 			param_.digest_len = crypto_generichash_blake2b_BYTES_MAX;
 			param_.key_len = static_cast<uint8_t>(key.size());
 			param_.fanout = 1;
 			param_.depth = 1;
-			param_.xof_digest_len = detail::little_endian(output_len);
+			param_.xof_digest_len = detail::little_endian(xof_digest_len);
 
 			std::copy(salt.begin(), salt.end(), detail::byte_iter_mut(param_.salt));
 			std::copy(personality.begin(), personality.end(), detail::byte_iter_mut(param_.personality));
 
 			init_state(key);
+			save_initial_state();
+		}
+
+		void save_initial_state() noexcept {
+			initial_param_ = param_;
+			initial_state_ = state_;
 		}
 
 	public:
@@ -202,21 +225,87 @@ namespace dice::hash::blake2xb {
 		explicit Blake2Xb(size_t output_len,
 						  std::span<std::byte const> key = {},
 						  std::span<std::byte const, salt_extent> salt = default_salt,
-						  std::span<std::byte const, personality_extent> personality = default_personality) /*noexcept(sodium is initialized && output_len is within size constraints && key.size() is within size constaints)*/
+						  std::span<std::byte const, personality_extent> personality = default_personality)
 			requires (output_extent == dynamic_output_extent)
-			: Blake2Xb{private_tag, output_len, key, salt, personality} {
+			: Blake2Xb{unchecked_tag, validate(output_len, key), key, salt, personality} {
+		}
+
+		/**
+		 * @brief Constructs an unkeyed BLAKE2Xb instance either using an unknown output length (if output_extent == dynamic_output_extent) or a statically determined output length of output_extent
+		 */
+		Blake2Xb() noexcept
+			: Blake2Xb{unchecked_tag, static_xof_digest_len, {}, default_salt, default_personality} {
 		}
 
 		/**
 		 * @brief Constructs a BLAKE2Xb instance either using an unknown output length (if output_extent == dynamic_output_extent) or a statically determined output length of output_extent
-		 * @param key optionally a key with a length (>= min_key_length && <= max_key_length)
+		 * @param key a key with a length (>= min_key_length && <= max_key_length) or an empty span for unkeyed hashing
+		 * @param salt BLAKE2b salt
+		 * @param personality BLAKE2b personality
+		 */
+		explicit Blake2Xb(std::span<std::byte const> key,
+						  std::span<std::byte const, salt_extent> salt = default_salt,
+						  std::span<std::byte const, personality_extent> personality = default_personality)
+			: Blake2Xb{unchecked_tag, validate(output_extent == dynamic_output_extent ? 0 : output_extent, key), key, salt, personality} {
+		}
+
+		/**
+		 * @brief Constructs a BLAKE2Xb instance either using an unknown output length (if output_extent == dynamic_output_extent) or a statically determined output length of output_extent
+		 * 		and a key whose length is known (and therefore validated) at compile time
+		 * @param key a key with a length (>= min_key_length && <= max_key_length)
 		 * @param salt BLAKE2b salt
 		 * @param personality BLAKE2b personality
 		 */
-		explicit Blake2Xb(std::span<std::byte const> key = {},
+		template<typename Key>
+			requires (std::is_convertible_v<Key const &, std::span<std::byte const>>
+					  && blake2b::detail::static_extent_v<Key> != std::dynamic_extent
+					  && blake2b::detail::valid_key_extent<blake2b::detail::static_extent_v<Key>>)
+		explicit Blake2Xb(Key const &key,
 						  std::span<std::byte const, salt_extent> salt = default_salt,
-						  std::span<std::byte const, personality_extent> personality = default_personality) /*noexcept(sodium is initialized && key.size() is within size constraints)*/
-			: Blake2Xb{private_tag, output_extent == dynamic_output_extent ? 0 : output_extent, key, salt, personality} {
+						  std::span<std::byte const, personality_extent> personality = default_personality) noexcept
+			: Blake2Xb{unchecked_tag, static_xof_digest_len, std::span<std::byte const>{key}, salt, personality} {
+		}
+
+		Blake2Xb(Blake2Xb const &other) noexcept = default;
+		Blake2Xb &operator=(Blake2Xb const &other) noexcept = default;
+
+		/**
+		 * @brief erases the states (in keyed mode they contain the key block) and parameter blocks
+		 */
+		~Blake2Xb() {
+			sodium_memzero(&state_, sizeof(state_));
+			sodium_memzero(&initial_state_, sizeof(initial_state_));
+			sodium_memzero(&param_, sizeof(param_));
+			sodium_memzero(&initial_param_, sizeof(initial_param_));
+		}
+
+		/**
+		 * @brief returns this instance to the state directly after construction, i.e. forgets all digested data
+		 * @note this is much cheaper than constructing a new instance, because nothing needs to be validated or recomputed
+		 */
+		void reset() noexcept {
+			param_ = initial_param_;
+			state_ = initial_state_;
+		}
+
+		/**
+		 * @brief returns this instance to the state directly after construction, but using a different key.
+		 * 		Output length, salt and personality are kept.
+		 * @param key a key with a length (>= min_key_length && <= max_key_length) or an empty span for unkeyed hashing
+		 * @throws std::runtime_error if the size of key is not known at compile time and invalid
+		 */
+		template<typename Key>
+			requires (std::is_convertible_v<Key const &, std::span<std::byte const>> && blake2b::detail::valid_key_extent<blake2b::detail::static_extent_v<Key>>)
+		void reset(Key const &key) noexcept(blake2b::detail::static_extent_v<Key> != std::dynamic_extent) {
+			std::span<std::byte const> const key_bytes{key};
+			if constexpr (blake2b::detail::static_extent_v<Key> == std::dynamic_extent) {
+				validate(0, key_bytes);
+			}
+
+			param_ = initial_param_;
+			param_.key_len = static_cast<uint8_t>(key_bytes.size());
+			init_state(key_bytes);
+			save_initial_state();
 		}
 
 		/**
@@ -312,7 +401,7 @@ namespace dice::hash::blake2xb {
 								std::span<std::byte, output_extent> out,
 								std::span<std::byte const> key = {},
 								std::span<std::byte const, salt_extent> salt = default_salt,
-								std::span<std::byte const, personality_extent> personality = default_personality) /*noexcept(sodium is initialized && key is within size constraints)*/ {
+								std::span<std::byte const, personality_extent> personality = default_personality) /*noexcept(key is within size constraints)*/ {
 			auto blake = [&]() {
 				if constexpr (output_extent == dynamic_output_extent) {
 					return Blake2Xb{out.size(), key, salt, personality};
@@ -9,11 +9,16 @@
 
 #include <sodium.h>
 
+#include <dice/hash/internal/SodiumInit.hpp>
+
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <random>
 #include <span>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
 
 namespace dice::hash::blake2b {
 
@@ -55,14 +60,32 @@ namespace dice::hash::blake2b {
 	}
 
 	namespace detail {
+		/**
+		 * @brief the extent of the std::span a Key converts to, std::dynamic_extent if it is not known at compile time
+		 */
+		template<typename Key>
+		inline constexpr size_t static_extent_v = decltype(std::span{std::declval<Key const &>()})::extent;
+
+		/**
+		 * @brief true iff KeyExtent is either not known at compile time or a valid key length (0 meaning no key)
+		 */
+		template<size_t KeyExtent>
+		inline constexpr bool valid_key_extent = KeyExtent == std::dynamic_extent || KeyExtent == 0 || (KeyExtent >= min_key_extent && KeyExtent <= max_key_extent);
+
 		template<size_t InnerOutputExtent>
 		struct Blake2bInner {
 			crypto_generichash_blake2b_state state_;
+			crypto_generichash_blake2b_state initial_state_;
+			std::array<std::byte, salt_extent> salt_;
+			std::array<std::byte, personality_extent> personality_;
 		};
 
 		template<>
 		struct Blake2bInner<dynamic_output_extent> {
 			crypto_generichash_blake2b_state state_;
+			crypto_generichash_blake2b_state initial_state_;
+			std::array<std::byte, salt_extent> salt_;
+			std::array<std::byte, personality_extent> personality_;
 			size_t specified_output_len_;
 		};
 	} // namespace detail
@@ -78,11 +101,7 @@ namespace dice::hash::blake2b {
 	private:
 		detail::Blake2bInner<output_extent> inner_;
 
-		void init(size_t output_len,
-				  std::span<std::byte const> key,
-				  std::span<std::byte const, salt_extent> salt,
-				  std::span<std::byte const, personality_extent> personality) {
-
+		static void validate(size_t output_len, std::span<std::byte const> key) {
 			if (output_len < min_output_extent || output_len > max_output_extent) {
 				throw std::runtime_error{"Invalid blake2b output size"};
 			}
@@ -92,26 +111,45 @@ namespace dice::hash::blake2b {
 					throw std::runtime_error{"Invalid blake2b key size"};
 				}
 			}
+		}
 
-			if (auto const res = sodium_init(); res == -1) {
-				throw std::runtime_error{"Could not initialize sodium"};
-			}
+		/**
+		 * @pre output_len and key have been validated, see validate
+		 */
+		void init_unchecked(size_t output_len,
+							std::span<std::byte const> key,
+							std::span<std::byte const, salt_extent> salt,
+							std::span<std::byte const, personality_extent> personality) noexcept {
+			::dice::hash::detail::sodium_init_once();
 
 			if constexpr (output_extent == dynamic_output_extent) {
 				inner_.specified_output_len_ = output_len;
 			}
 
+			std::copy(salt.begin(), salt.end(), inner_.salt_.begin());
+			std::copy(personality.begin(), personality.end(), inner_.personality_.begin());
+			init_state(key);
+		}
+
+		/**
+		 * @brief initializes state_ (and initial_state_) from the stored parameters and key, without validating them
+		 * @pre all parameters have been validated, see validate
+		 */
+		void init_state(std::span<std::byte const> key) noexcept {
 			auto const res = crypto_generichash_blake2b_init_salt_personal(&inner_.state_,
 																		   reinterpret_cast<unsigned char const *>(key.data()),
 																		   key.size(),
-																		   output_len,
-																		   reinterpret_cast<unsigned char const *>(salt.data()),
-																		   reinterpret_cast<unsigned char const *>(personality.data()));
+																		   concrete_output_extent(),
+																		   reinterpret_cast<unsigned char const *>(inner_.salt_.data()),
+																		   reinterpret_cast<unsigned char const *>(inner_.personality_.data()));
 			// cannot fail here, all invariants have been checked,
 			// see: https://github.com/jedisct1/libsodium/blob/d787d2b1cf13ad2e69c3a7ebc3fb7b68b6430774/src/libsodium/crypto_generichash/blake2b/ref/generichash_blake2b.c#LL69C47-L69C47
 			// and: https://github.com/jedisct1/libsodium/blob/d787d2b1cf13ad2e69c3a7ebc3fb7b68b6430774/src/libsodium/crypto_generichash/blake2b/ref/blake2b-ref.c#L148
 			// and: https://github.com/jedisct1/libsodium/blob/d787d2b1cf13ad2e69c3a7ebc3fb7b68b6430774/src/libsodium/crypto_generichash/blake2b/ref/blake2b-ref.c#L216
 			assert(res == 0);
+			(void) res;
+
+			inner_.initial_state_ = inner_.state_;
 		}
 
 	public:
@@ -125,22 +163,86 @@ namespace dice::hash::blake2b {
 		explicit Blake2b(size_t output_len,
 						 std::span<std::byte const> key = {},
 						 std::span<std::byte const, salt_extent> salt = default_salt,
-						 std::span<std::byte const, personality_extent> personality = default_personality) /*noexcept(sodium is initialized && output_len is within size constraints && key.size() is within size constaints)*/
+						 std::span<std::byte const, personality_extent> personality = default_personality)
 			requires (output_extent == dynamic_output_extent) {
-			init(output_len, key, salt, personality);
+			validate(output_len, key);
+			init_unchecked(output_len, key, salt, personality);
 		}
 
 		/**
-		 * @brief Constructs a BLAKE2b instance either using a statically determined output length of output_extent
-		 * @param key optionally a key with a length (>= min_key_length && <= max_key_length)
+		 * @brief Constructs an unkeyed BLAKE2b instance using a statically determined output length of output_extent
+		 */
+		Blake2b() noexcept
+			requires (output_extent != dynamic_output_extent) {
+			init_unchecked(output_extent, {}, default_salt, default_personality);
+		}
+
+		/**
+		 * @brief Constructs a BLAKE2b instance using a statically determined output length of output_extent
+		 * @param key a key with a length (>= min_key_length && <= max_key_length) or an empty span for unkeyed hashing
 		 * @param salt BLAKE2b salt
 		 * @param personality BLAKE2b personality
 		 */
-		explicit Blake2b(std::span<std::byte const> key = {},
+		explicit Blake2b(std::span<std::byte const> key,
 						 std::span<std::byte const, salt_extent> salt = default_salt,
-						 std::span<std::byte const, personality_extent> personality = default_personality) /*noexcept(sodium is initialized && key.size() is within size constraints)*/
+						 std::span<std::byte const, personality_extent> personality = default_personality)
 			requires (output_extent != dynamic_output_extent) {
-			init(output_extent, key, salt, personality);
+			validate(output_extent, key);
+			init_unchecked(output_extent, key, salt, personality);
+		}
+
+		/**
+		 * @brief Constructs a BLAKE2b instance using a statically determined output length of output_extent
+		 * 		and a key whose length is known (and therefore validated) at compile time
+		 * @param key a key with a length (>= min_key_length && <= max_key_length)
+		 * @param salt BLAKE2b salt
+		 * @param personality BLAKE2b personality
+		 */
+		template<typename Key>
+			requires (output_extent != dynamic_output_extent
+					  && std::is_convertible_v<Key const &, std::span<std::byte const>>
+					  && detail::static_extent_v<Key> != std::dynamic_extent
+					  && detail::valid_key_extent<detail::static_extent_v<Key>>)
+		explicit Blake2b(Key const &key,
+						 std::span<std::byte const, salt_extent> salt = default_salt,
+						 std::span<std::byte const, personality_extent> personality = default_personality) noexcept {
+			init_unchecked(output_extent, std::span<std::byte const>{key}, salt, personality);
+		}
+
+		Blake2b(Blake2b const &other) noexcept = default;
+		Blake2b &operator=(Blake2b const &other) noexcept = default;
+
+		/**
+		 * @brief erases the states, in keyed mode they contain the key block
+		 */
+		~Blake2b() {
+			sodium_memzero(&inner_.state_, sizeof(inner_.state_));
+			sodium_memzero(&inner_.initial_state_, sizeof(inner_.initial_state_));
+		}
+
+		/**
+		 * @brief returns this instance to the state directly after construction, i.e. forgets all digested data
+		 * @note this is much cheaper than constructing a new instance, because nothing needs to be validated or recomputed
+		 */
+		void reset() noexcept {
+			inner_.state_ = inner_.initial_state_;
+		}
+
+		/**
+		 * @brief returns this instance to the state directly after construction, but using a different key.
+		 * 		Output length, salt and personality are kept.
+		 * @param key a key with a length (>= min_key_length && <= max_key_length) or an empty span for unkeyed hashing
+		 * @throws std::runtime_error if the size of key is not known at compile time and invalid
+		 */
+		template<typename Key>
+			requires (std::is_convertible_v<Key const &, std::span<std::byte const>> && detail::valid_key_extent<detail::static_extent_v<Key>>)
+		void reset(Key const &key) noexcept(detail::static_extent_v<Key> != std::dynamic_extent) {
+			std::span<std::byte const> const key_bytes{key};
+			if constexpr (detail::static_extent_v<Key> == std::dynamic_extent) {
+				validate(concrete_output_extent(), key_bytes);
+			}
+
+			init_state(key_bytes);
 		}
 
 		/**
@@ -195,7 +297,7 @@ namespace dice::hash::blake2b {
 								std::span<std::byte, output_extent> out,
 								std::span<std::byte const> key = {},
 								std::span<std::byte const, salt_extent> salt = default_salt,
-								std::span<std::byte const, personality_extent> personality = default_personality) /*noexcept(sodium is initialized && output is within size constraints && key is within size constraints)*/ {
+								std::span<std::byte const, personality_extent> personality = default_personality) /*noexcept(output is within size constraints && key is within size constraints)*/ {
 			auto blake = [&]() {
 				if constexpr (output_extent == dynamic_output_extent) {
 					return Blake2b{out.size(), key, salt, personality};
@@ -2,13 +2,20 @@
 #define DICE_HASH_BLAKE3_HPP
 
 #include <algorithm>
+#include <array>
+#include <bit>
 #include <cstddef>
+#include <cstring>
 #include <span>
+#include <string_view>
 #include <limits>
 #include <random>
+#include <vector>
 
 #include <blake3.h>
 
+#include <dice/hash/ThreadPool.hpp>
+
 namespace dice::hash::blake3 {
 
 	inline constexpr size_t dynamic_output_extent = std::dynamic_extent;
@@ -30,6 +37,339 @@ namespace dice::hash::blake3 {
 		});
 	}
 
+	/**
+	 * @brief inputs shorter than this are always hashed on the calling thread by Blake3::digest_parallel
+	 */
+	inline constexpr size_t parallel_min_input_len = size_t{1} << 20;
+
+	/**
+	 * @brief smallest unit of work (in bytes) Blake3::digest_parallel hands to an executor
+	 */
+	inline constexpr size_t parallel_min_task_len = size_t{64} << 10;
+
+	namespace detail {
+		// The helpers below mirror internal functions of blake3.c and modify the private fields of blake3_hasher
+		// (chunk, cv_stack, cv_stack_len), neither of which is covered by the stability guarantees of the BLAKE3 API.
+		// Check them against blake3.c/blake3_impl.h before bumping the version in internal/blake3/CMakeLists.txt.
+		static_assert(std::string_view{BLAKE3_VERSION_STRING} == "1.5.4",
+					  "dice::hash::blake3::detail was written against BLAKE3 1.5.4, review it for the new BLAKE3 version");
+
+		// domain separation flags, see blake3_impl.h
+		inline constexpr uint8_t flag_chunk_start = 1 << 0;
+		inline constexpr uint8_t flag_chunk_end = 1 << 1;
+		inline constexpr uint8_t flag_parent = 1 << 2;
+
+		using chaining_value = std::array<uint32_t, 8>;
+
+		inline constexpr chaining_value iv{0x6A09E667UL, 0xBB67AE85UL, 0x3C6EF372UL, 0xA54FF53AUL,
+										   0x510E527FUL, 0x9B05688CUL, 0x1F83D9ABUL, 0x5BE0CD19UL};
+
+		inline constexpr uint8_t msg_schedule[7][16]{
+				{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15},
+				{2, 6, 3, 10, 7, 0, 4, 13, 1, 11, 12, 5, 9, 14, 15, 8},
+				{3, 4, 10, 12, 13, 2, 7, 14, 6, 5, 9, 0, 11, 15, 8, 1},
+				{10, 7, 12, 9, 14, 3, 13, 15, 4, 0, 11, 2, 5, 8, 1, 6},
+				{12, 13, 9, 11, 15, 10, 14, 8, 7, 2, 5, 3, 0, 1, 6, 4},
+				{9, 14, 11, 5, 8, 12, 15, 1, 13, 3, 0, 10, 2, 6, 4, 7},
+				{11, 15, 5, 0, 1, 9, 8, 6, 14, 10, 2, 12, 3, 4, 7, 13},
+		};
+
+		inline void g(uint32_t (&state)[16], size_t a, size_t b, size_t c, size_t d, uint32_t x, uint32_t y) noexcept {
+			state[a] = state[a] + state[b] + x;
+			state[d] = std::rotr(state[d] ^ state[a], 16);
+			state[c] = state[c] + state[d];
+			state[b] = std::rotr(state[b] ^ state[c], 12);
+			state[a] = state[a] + state[b] + y;
+			state[d] = std::rotr(state[d] ^ state[a], 8);
+			state[c] = state[c] + state[d];
+			state[b] = std::rotr(state[b] ^ state[c], 7);
+		}
+
+		/**
+		 * @brief The BLAKE3 compression function, truncated to a chaining value (portable version of blake3_compress_in_place).
+		 * 		The compression function of the C implementation is not exported (it is built with hidden visibility),
+		 * 		digest_parallel only needs it for the few parent nodes that merge the subtrees, so a scalar implementation suffices.
+		 */
+		inline void compress_in_place(chaining_value &cv, uint8_t const *block, uint8_t block_len, uint64_t counter, uint8_t flags) noexcept {
+			uint32_t m[16];
+			for (size_t ix = 0; ix < 16; ++ix) {
+				m[ix] = static_cast<uint32_t>(block[4 * ix]) | (static_cast<uint32_t>(block[4 * ix + 1]) << 8)
+						| (static_cast<uint32_t>(block[4 * ix + 2]) << 16) | (static_cast<uint32_t>(block[4 * ix + 3]) << 24);
+			}
+
+			uint32_t state[16]{cv[0], cv[1], cv[2], cv[3], cv[4], cv[5], cv[6], cv[7],
+							   iv[0], iv[1], iv[2], iv[3],
+							   static_cast<uint32_t>(counter), static_cast<uint32_t>(counter >> 32), block_len, flags};
+
+			for (auto const &schedule : msg_schedule) {
+				g(state, 0, 4, 8, 12, m[schedule[0]], m[schedule[1]]);
+				g(state, 1, 5, 9, 13, m[schedule[2]], m[schedule[3]]);
+				g(state, 2, 6, 10, 14, m[schedule[4]], m[schedule[5]]);
+				g(state, 3, 7, 11, 15, m[schedule[6]], m[schedule[7]]);
+				g(state, 0, 5, 10, 15, m[schedule[8]], m[schedule[9]]);
+				g(state, 1, 6, 11, 12, m[schedule[10]], m[schedule[11]]);
+				g(state, 2, 7, 8, 13, m[schedule[12]], m[schedule[13]]);
+				g(state, 3, 4, 9, 14, m[schedule[14]], m[schedule[15]]);
+			}
+
+			for (size_t ix = 0; ix < 8; ++ix) {
+				cv[ix] = state[ix] ^ state[ix + 8];
+			}
+		}
+
+		inline size_t chunk_state_len(blake3_chunk_state const &chunk) noexcept {
+			return BLAKE3_BLOCK_LEN * static_cast<size_t>(chunk.blocks_compressed) + chunk.buf_len;
+		}
+
+		/**
+		 * @brief A node of the BLAKE3 tree before its final compression, i.e. everything needed to compute its chaining value.
+		 * 		Corresponds to output_t in blake3.c.
+		 */
+		struct Output {
+			chaining_value input_cv;
+			uint8_t block[BLAKE3_BLOCK_LEN];
+			uint8_t block_len;
+			uint64_t counter;
+			uint8_t flags;
+
+			/**
+			 * @brief chaining value of this node, only valid if it is not the root of the tree
+			 */
+			[[nodiscard]] chaining_value chaining() const noexcept {
+				chaining_value cv = input_cv;
+				compress_in_place(cv, block, block_len, counter, flags);
+				return cv;
+			}
+		};
+
+		inline Output chunk_output(blake3_chunk_state const &chunk) noexcept {
+			Output output;
+			std::copy(std::begin(chunk.cv), std::end(chunk.cv), output.input_cv.begin());
+			std::memcpy(output.block, chunk.buf, BLAKE3_BLOCK_LEN);
+			output.block_len = chunk.buf_len;
+			output.counter = chunk.chunk_counter;
+			output.flags = chunk.flags | flag_chunk_end | (chunk.blocks_compressed == 0 ? flag_chunk_start : 0);
+			return output;
+		}
+
+		inline Output parent_output(uint32_t const (&key)[8], uint8_t flags, uint8_t const *left_cv, uint8_t const *right_cv) noexcept {
+			Output output;
+			std::copy(std::begin(key), std::end(key), output.input_cv.begin());
+			std::memcpy(output.block, left_cv, BLAKE3_OUT_LEN);
+			std::memcpy(output.block + BLAKE3_OUT_LEN, right_cv, BLAKE3_OUT_LEN);
+			output.block_len = BLAKE3_BLOCK_LEN;
+			output.counter = 0;
+			output.flags = flags | flag_parent;
+			return output;
+		}
+
+		/**
+		 * @brief chaining value of a chunk that is known not to be the root of the tree
+		 */
+		inline chaining_value chunk_cv(blake3_chunk_state const &chunk) noexcept {
+			return chunk_output(chunk).chaining();
+		}
+
+		/**
+		 * @brief chaining value of a parent node that is known not to be the root of the tree
+		 */
+		inline chaining_value parent_cv(uint32_t const (&key)[8], uint8_t flags, uint8_t const *left_cv, uint8_t const *right_cv) noexcept {
+			return parent_output(key, flags, left_cv, right_cv).chaining();
+		}
+
+		/**
+		 * @brief Serializes a chaining value into the (little endian) byte representation used on the cv stack
+		 */
+		inline void store_cv(chaining_value const &cv, uint8_t *out) noexcept {
+			for (auto const word : cv) {
+				*out++ = static_cast<uint8_t>(word);
+				*out++ = static_cast<uint8_t>(word >> 8);
+				*out++ = static_cast<uint8_t>(word >> 16);
+				*out++ = static_cast<uint8_t>(word >> 24);
+			}
+		}
+
+		/**
+		 * @brief Deserializes a chaining value from the byte representation used on the cv stack
+		 */
+		inline chaining_value load_cv(uint8_t const *in) noexcept {
+			chaining_value cv;
+			for (auto &word : cv) {
+				word = static_cast<uint32_t>(in[0]) | (static_cast<uint32_t>(in[1]) << 8) | (static_cast<uint32_t>(in[2]) << 16) | (static_cast<uint32_t>(in[3]) << 24);
+				in += 4;
+			}
+			return cv;
+		}
+
+		/**
+		 * @brief Resets the chunk state of hasher to an empty chunk with the given counter
+		 */
+		inline void reset_chunk(blake3_hasher &hasher, uint64_t chunk_counter) noexcept {
+			std::copy(std::begin(hasher.key), std::end(hasher.key), std::begin(hasher.chunk.cv));
+			hasher.chunk.chunk_counter = chunk_counter;
+			std::fill(std::begin(hasher.chunk.buf), std::end(hasher.chunk.buf), uint8_t{0});
+			hasher.chunk.buf_len = 0;
+			hasher.chunk.blocks_compressed = 0;
+		}
+
+		/**
+		 * @brief Pushes the chaining value of a complete subtree starting at chunk_counter onto the cv stack of hasher.
+		 * 		Mirrors hasher_push_cv from blake3.c, i.e. merges lazily such that no node is merged before it is known
+		 * 		not to be the root.
+		 */
+		inline void push_cv(blake3_hasher &hasher, chaining_value const &cv, uint64_t chunk_counter) noexcept {
+			auto const post_merge_stack_len = static_cast<size_t>(std::popcount(chunk_counter));
+			while (hasher.cv_stack_len > post_merge_stack_len) {
+				uint8_t *const left = &hasher.cv_stack[(hasher.cv_stack_len - 2) * BLAKE3_OUT_LEN];
+				store_cv(parent_cv(hasher.key, hasher.chunk.flags, left, left + BLAKE3_OUT_LEN), left);
+				hasher.cv_stack_len -= 1;
+			}
+
+			store_cv(cv, &hasher.cv_stack[hasher.cv_stack_len * BLAKE3_OUT_LEN]);
+			hasher.cv_stack_len += 1;
+		}
+
+		/**
+		 * @brief Computes the chaining value of the (non-root) subtree consisting of the chunks in data.
+		 * @param data whole chunks, their number must be a power of two
+		 * @param chunk_counter index of the first chunk in data, must be a multiple of the number of chunks in data
+		 */
+		inline chaining_value subtree_cv(blake3_hasher const &parent, std::span<std::byte const> data, uint64_t chunk_counter) noexcept {
+			blake3_hasher hasher{};
+			std::copy(std::begin(parent.key), std::end(parent.key), std::begin(hasher.key));
+			hasher.chunk.flags = parent.chunk.flags;
+			reset_chunk(hasher, chunk_counter);
+
+			// blake3_hasher_update merges the cv stack down to popcount(chunk_counter) entries,
+			// so it must look like the preceding popcount(chunk_counter) complete subtrees are already on the stack.
+			// These placeholders are never merged because chunk_counter is aligned to the size of the subtree.
+			auto const base_stack_len = static_cast<uint8_t>(std::popcount(chunk_counter));
+			hasher.cv_stack_len = base_stack_len;
+
+			// the reference implementation already uses SIMD for whole subtrees, it only lacks the final non-root merge
+			blake3_hasher_update(&hasher, data.data(), data.size());
+
+			chaining_value cv;
+			if (chunk_state_len(hasher.chunk) > 0) {
+				cv = chunk_cv(hasher.chunk);
+			} else {
+				// the whole subtree was consumed by blake3_hasher_update
+				hasher.cv_stack_len -= 1;
+				cv = load_cv(&hasher.cv_stack[hasher.cv_stack_len * BLAKE3_OUT_LEN]);
+			}
+
+			uint8_t cv_bytes[BLAKE3_OUT_LEN];
+			while (hasher.cv_stack_len > base_stack_len) {
+				hasher.cv_stack_len -= 1;
+				store_cv(cv, cv_bytes);
+				cv = parent_cv(hasher.key, hasher.chunk.flags, &hasher.cv_stack[hasher.cv_stack_len * BLAKE3_OUT_LEN], cv_bytes);
+			}
+
+			return cv;
+		}
+
+		/**
+		 * @brief Multithreaded equivalent of blake3_hasher_update
+		 */
+		template<Executor E>
+		void hasher_update_parallel(blake3_hasher &hasher, std::span<std::byte const> data, E &executor) {
+			if (data.size() < parallel_min_input_len || executor.concurrency() <= 1) {
+				blake3_hasher_update(&hasher, data.data(), data.size());
+				return;
+			}
+
+			// complete the current chunk and flush it to the cv stack, it is known not to be the root because more data follows
+			if (auto const buffered = chunk_state_len(hasher.chunk); buffered > 0) {
+				auto const take = BLAKE3_CHUNK_LEN - buffered;
+				blake3_hasher_update(&hasher, data.data(), take);
+				data = data.subspan(take);
+
+				push_cv(hasher, chunk_cv(hasher.chunk), hasher.chunk.chunk_counter);
+				reset_chunk(hasher, hasher.chunk.chunk_counter + 1);
+			}
+
+			// the last (potentially partial) chunk stays in the chunk state, it might be the root
+			size_t const n_chunks = (data.size() - 1) / BLAKE3_CHUNK_LEN;
+			uint64_t const first_chunk = hasher.chunk.chunk_counter;
+
+			// split the chunks into subtrees that are aligned to their size,
+			// this is the only way their chaining values are nodes of the resulting tree
+			size_t const target_task_chunks = std::max(n_chunks / (4 * executor.concurrency()), parallel_min_task_len / BLAKE3_CHUNK_LEN);
+			size_t const max_task_chunks = std::bit_floor(target_task_chunks);
+
+			struct Subtree {
+				uint64_t chunk_counter;
+				size_t n_chunks;
+				chaining_value cv;
+			};
+
+			std::vector<Subtree> subtrees;
+			for (uint64_t counter = first_chunk; counter < first_chunk + n_chunks;) {
+				auto task_chunks = std::min<size_t>(max_task_chunks, std::bit_floor(first_chunk + n_chunks - counter));
+				while (counter % task_chunks != 0) {
+					task_chunks /= 2;
+				}
+
+				subtrees.push_back(Subtree{.chunk_counter = counter, .n_chunks = task_chunks, .cv = {}});
+				counter += task_chunks;
+			}
+
+			executor.parallel_for(subtrees.size(), [&](size_t ix) {
+				auto &subtree = subtrees[ix];
+				auto const offset = (subtree.chunk_counter - first_chunk) * BLAKE3_CHUNK_LEN;
+				subtree.cv = subtree_cv(hasher, data.subspan(offset, subtree.n_chunks * BLAKE3_CHUNK_LEN), subtree.chunk_counter);
+			});
+
+			for (auto const &subtree : subtrees) {
+				push_cv(hasher, subtree.cv, subtree.chunk_counter);
+			}
+
+			reset_chunk(hasher, first_chunk + n_chunks);
+			auto const rest = data.subspan(n_chunks * BLAKE3_CHUNK_LEN);
+			blake3_hasher_update(&hasher, rest.data(), rest.size());
+		}
+	} // namespace detail
+
+	/**
+	 * @brief Seekable reader for the extendable output of a finished BLAKE3 computation.
+	 * 		Any byte range of the output can be produced without computing the preceding output (see blake3_hasher_finalize_seek).
+	 */
+	struct OutputReader {
+	private:
+		blake3_hasher state_;
+		uint64_t position_ = 0;
+
+	public:
+		explicit OutputReader(blake3_hasher const &hasher) noexcept : state_{hasher} {
+		}
+
+		/**
+		 * @brief fills out with the output starting at position() and advances position() by out.size()
+		 */
+		void fill(std::span<std::byte> out) noexcept {
+			read_at(position_, out);
+			position_ += out.size();
+		}
+
+		/**
+		 * @brief fills out with the output starting at byte offset, does not change position()
+		 */
+		void read_at(uint64_t offset, std::span<std::byte> out) const noexcept {
+			blake3_hasher_finalize_seek(&state_, offset, reinterpret_cast<uint8_t *>(out.data()), out.size());
+		}
+
+		/**
+		 * @brief sets the position the next call to fill reads from
+		 */
+		void seek(uint64_t position) noexcept {
+			position_ = position;
+		}
+
+		[[nodiscard]] uint64_t position() const noexcept {
+			return position_;
+		}
+	};
+
 	template<size_t OutputExtent = dynamic_output_extent>
 	struct Blake3 {
 		/**
@@ -58,12 +398,56 @@ namespace dice::hash::blake3 {
 		}
 
 		/**
-		 * @brief digests data into the underlying BLAKE2Xb state
+		 * @brief Construct a BLAKE3 instance in key derivation mode
+		 * @param context a hardcoded, globally unique, application-specific context string (used for domain separation)
+		 */
+		explicit Blake3(std::string_view context) noexcept {
+			blake3_hasher_init_derive_key_raw(&state_, context.data(), context.size());
+		}
+
+		/**
+		 * @brief returns this instance to the state directly after construction (keeping the key), i.e. forgets all digested data
+		 */
+		void reset() noexcept {
+			blake3_hasher_reset(&state_);
+		}
+
+		/**
+		 * @brief returns this instance to the state directly after construction, but using a different key
+		 */
+		void reset(std::span<std::byte const, default_key_extent> key) noexcept {
+			blake3_hasher_init_keyed(&state_, reinterpret_cast<uint8_t const *>(key.data()));
+		}
+
+		/**
+		 * @brief digests data into the underlying BLAKE3 state
 		 */
 		void digest(std::span<std::byte const> data) noexcept {
 			blake3_hasher_update(&state_, data.data(), data.size());
 		}
 
+		/**
+		 * @brief digests data into the underlying BLAKE3 state, using executor to hash independent subtrees of large inputs in parallel.
+		 * 		The resulting state is identical to the one produced by digest(data).
+		 * @param executor executor to run the subtree hashing tasks on
+		 */
+		template<Executor E>
+		void digest_parallel(std::span<std::byte const> data, E &executor) {
+			detail::hasher_update_parallel(state_, data, executor);
+		}
+
+		/**
+		 * @brief digests data into the underlying BLAKE3 state, using ThreadPool::global() to hash independent subtrees of large inputs in parallel.
+		 * 		The resulting state is identical to the one produced by digest(data).
+		 */
+		void digest_parallel(std::span<std::byte const> data) {
+			if (data.size() < parallel_min_input_len) {
+				digest(data); // don't spin up the global pool for small inputs
+				return;
+			}
+			digest_parallel(data, ThreadPool::global());
+		}
+
 		/**
 		 * @brief produces the hash corresponding to the previously digested bytes
 		 * @param out location to write the hash to, if output_extent == dynamic_output_extent and the output length was specified on construction
@@ -73,6 +457,15 @@ namespace dice::hash::blake3 {
 			blake3_hasher_finalize(&state_, reinterpret_cast<uint8_t *>(out.data()), out.size());
 		}
 
+		/**
+		 * @brief returns a reader for the (extendable) hash corresponding to the previously digested bytes
+		 * 		that can produce arbitrary ranges of the output, starting at position 0.
+		 * @note the first output_extent bytes read from it are identical to the output of finish
+		 */
+		[[nodiscard]] OutputReader output_reader() const noexcept {
+			return OutputReader{state_};
+		}
+
 		/**
 		 * @brief convenience function to hash a single byte-span
 		 */
@@ -86,6 +86,24 @@ namespace dice::hash {
 	template<typename T>
 	constexpr bool is_ordered_container_v = is_ordered_container<T>::value;
 
+	/** Typetrait for checking if a type T is a contiguous container.
+	 * Examples would be vectors and strings that are not from the standard library,
+	 * e.g. boost::container::vector (used by metall::container::vector) or boost::container::basic_string.
+	 * A contiguous container needs the member type "value_type", data() and size().
+	 * std::vector, std::basic_string and std::array have their own overloads and must not be added.
+	 * The general version is always false, so it inherits from false_type.
+	 * @tparam T The type to check.
+	 */
+	template<typename T>
+	struct is_contiguous_container : std::false_type {};
+
+	/** Helper definition.
+	 * Enables the *_v usage of is_contiguous_container.
+	 * @tparam T The type to check.
+	 */
+	template<typename T>
+	constexpr bool is_contiguous_container_v = is_contiguous_container<T>::value;
+
 }// namespace dice::hash
 
 #endif
\ No newline at end of file
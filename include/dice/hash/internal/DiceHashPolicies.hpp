@@ -3,12 +3,96 @@
 
 #include "martinus_robinhood_hash.hpp"
 #include "wyhash.h"
-#ifdef __x86_64__
-#include "xxhash.hpp"
+#if !defined(XXH_CPU_LITTLE_ENDIAN) && defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define XXH_CPU_LITTLE_ENDIAN 0
 #endif
+#include "xxhash.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <span>
 #include <type_traits>
 
 namespace dice::hash::Policies {
+	namespace detail {
+		/** Normalizes the object representation of a fundamental value to little endian byte order.
+		 * Policies hash the bytes of the result instead of the bytes of x, so that hash values do not depend on the
+		 * endianness of the platform. On little endian platforms this is a no-op.
+		 * @tparam T A fundamental (or pointer) type.
+		 * @param x The value.
+		 * @return x with its bytes in little endian order.
+		 */
+		template<typename T>
+		[[nodiscard]] T to_little_endian(T x) noexcept {
+			if constexpr (std::endian::native == std::endian::big && sizeof(T) > 1) {
+				auto bytes = std::bit_cast<std::array<std::byte, sizeof(T)>>(x);
+				std::ranges::reverse(bytes);
+				return std::bit_cast<T>(bytes);
+			} else {
+				return x;
+			}
+		}
+
+		/** Size of the stack buffer in which hash_little_endian_chunks converts elements to little endian. */
+		inline constexpr std::size_t element_chunk_len = 4096;
+
+		/** Hashes the little endian representation of len bytes of ElemSize byte elements that are stored in byte order Order,
+		 * for policies whose kernel cannot read the elements in place but that have a streaming state with the same result.
+		 * The elements are converted in a stack buffer of element_chunk_len bytes. If they fit into it, they are hashed with
+		 * hash_bytes, otherwise the converted chunks are streamed into the state returned by make_state.
+		 * @param hash_bytes hashes bytes in one call
+		 * @param make_state returns a state with update(ptr, len) and digest() that produces the same value as hash_bytes
+		 */
+		template<std::size_t ElemSize, std::endian Order, typename HashBytes, typename MakeState>
+		[[nodiscard]] std::size_t hash_little_endian_chunks(void const *ptr, std::size_t len, HashBytes &&hash_bytes, MakeState &&make_state) noexcept {
+			static constexpr std::size_t chunk_len = element_chunk_len / ElemSize * ElemSize;
+			alignas(8) std::array<unsigned char, chunk_len> chunk;
+			auto const *const bytes = static_cast<unsigned char const *>(ptr);
+			auto const convert = [&](std::size_t first, std::size_t n) noexcept {
+				for (std::size_t elem = 0; elem < n; elem += ElemSize) {
+					std::reverse_copy(bytes + first + elem, bytes + first + elem + ElemSize, chunk.begin() + elem);
+				}
+			};
+
+			if (len <= chunk_len) {
+				convert(0, len);
+				return hash_bytes(chunk.data(), len);
+			}
+
+			auto state = make_state();
+			for (std::size_t first = 0; first < len; first += chunk_len) {
+				auto const n = std::min(chunk_len, len - first);
+				convert(first, n);
+				state.update(chunk.data(), n);
+			}
+			return static_cast<std::size_t>(state.digest());
+		}
+	}// namespace detail
+
+	/** Up to this many bytes, the hash_bytes_fixed<N> functions of the policies use unrolled kernels without branches on the length.
+	 * Policies may provide hash_bytes_fixed<N>(ptr) (optional, equal to hash_bytes(ptr, N)), DiceHash uses it for data with a length known at compile time.
+	 * Policies may also provide hash_elements<ElemSize, Order>(ptr, len) (optional), the hash_bytes of the little endian representation
+	 * of a sequence of ElemSize byte elements stored in byte order Order. DiceHash uses it for sequences of fundamentals on big endian platforms.
+	 */
+	inline constexpr std::size_t max_fixed_len = 64;
+
+	/** Policy version of a policy, i.e. Policy::version if it declares one and 0 otherwise.
+	 * Policies that declare a version guarantee that their hash values (on 64-bit platforms) only change together with the version,
+	 * so hash values that were persisted with the same version remain valid.
+	 * @tparam Policy The policy.
+	 */
+	template<typename Policy>
+	inline constexpr std::uint32_t policy_version_v = [] {
+		if constexpr (requires { { Policy::version } -> std::convertible_to<std::uint32_t>; }) {
+			return static_cast<std::uint32_t>(Policy::version);
+		} else {
+			return std::uint32_t{0};
+		}
+	}();
     template<typename T>
     concept HashPolicy =
     std::is_convertible_v<decltype(T::ErrorValue), std::size_t>
@@ -22,7 +106,32 @@ namespace dice::hash::Policies {
     &&std::is_nothrow_invocable_r_v<void, decltype(&T::HashState::add), typename T::HashState &, std::size_t>
     &&std::is_nothrow_invocable_r_v<std::size_t, decltype(&T::HashState::digest), typename T::HashState &>;
 
+	/** A policy that is keyed at runtime, e.g. by a random seed, to make the hash values unpredictable (hash-flooding resistance).
+	 * In contrast to a HashPolicy its functions are members, i.e. they are called on a policy object that holds the key,
+	 * and its HashState is constructed from the policy object.
+	 */
+	template<typename T>
+	concept KeyedHashPolicy =
+			std::is_nothrow_constructible_v<T, std::uint64_t>
+			&& std::is_nothrow_copy_constructible_v<T>
+			&& std::is_convertible_v<decltype(T::ErrorValue), std::size_t>
+			&& requires(T const &policy, void const *ptr, std::size_t len, std::initializer_list<std::size_t> hashes) {
+				   { policy.hash_fundamental(int{}) } noexcept -> std::convertible_to<std::size_t>;
+				   { policy.hash_fundamental(long{}) } noexcept -> std::convertible_to<std::size_t>;
+				   { policy.hash_fundamental(std::size_t{}) } noexcept -> std::convertible_to<std::size_t>;
+				   { policy.hash_bytes(ptr, len) } noexcept -> std::convertible_to<std::size_t>;
+				   { policy.hash_combine(hashes) } noexcept -> std::convertible_to<std::size_t>;
+				   { policy.hash_invertible_combine(hashes) } noexcept -> std::convertible_to<std::size_t>;
+			   }
+			&& std::is_nothrow_constructible_v<typename T::HashState, T const &, std::size_t>
+			&& requires(typename T::HashState &state, std::size_t hash) {
+				   { state.add(hash) } noexcept;
+				   { state.digest() } noexcept -> std::convertible_to<std::size_t>;
+			   };
+
 	struct wyhash {
+		/** Version of the hash values, see policy_version_v. */
+		inline static constexpr std::uint32_t version = 1;
 		inline static constexpr uint64_t kSeed = 0xe17a1465UL;
 		inline static constexpr uint64_t kWyhashSalt[4] = {
 				dice::hash::wyhash::_wyp[0],
@@ -37,13 +146,30 @@ namespace dice::hash::Policies {
 			if constexpr (std::is_integral_v<T>) {
 				return static_cast<std::size_t>(dice::hash::wyhash::wyhash64(kSeed, x));
 			}
-			return static_cast<std::size_t>(dice::hash::wyhash::wyhash(&x, sizeof(T), kSeed, kWyhashSalt));
+			auto const bytes = detail::to_little_endian(x);
+			return hash_bytes_fixed<sizeof(T)>(&bytes);
 		}
 
 		static std::size_t hash_bytes(void const *ptr, std::size_t len) noexcept {
 			return static_cast<std::size_t>(dice::hash::wyhash::wyhash(ptr, len, kSeed, kWyhashSalt));
 		}
 
+		/** hash_bytes of the little endian representation of len bytes of ElemSize byte elements that are stored in byte order Order. */
+		template<std::size_t ElemSize, std::endian Order = std::endian::native>
+		static std::size_t hash_elements(void const *ptr, std::size_t len) noexcept {
+			return static_cast<std::size_t>(dice::hash::wyhash::wyhash_elements<ElemSize, Order>(ptr, len, kSeed, kWyhashSalt));
+		}
+
+		/** hash_bytes(ptr, N) for a length known at compile time, without branches on the length up to max_fixed_len bytes. */
+		template<std::size_t N>
+		static std::size_t hash_bytes_fixed(void const *ptr) noexcept {
+			if constexpr (N <= max_fixed_len) {
+				return static_cast<std::size_t>(dice::hash::wyhash::wyhash_fixed<N>(ptr, kSeed, kWyhashSalt));
+			} else {
+				return hash_bytes(ptr, N);
+			}
+		}
+
 		static std::size_t hash_combine(std::initializer_list<size_t> hashes) noexcept {
 			uint64_t state = kSeed;
 			for (auto hash : hashes) {
@@ -74,19 +200,32 @@ namespace dice::hash::Policies {
 		};
 	};
 
-#ifdef __x86_64__
 	struct xxh3 {
+		/** Version of the hash values, see policy_version_v. */
+		inline static constexpr std::uint32_t version = 1;
 		inline static constexpr std::size_t size_t_bits = 8 * sizeof(std::size_t);
 		inline static constexpr std::size_t seed = std::size_t(0xA24BAED4963EE407UL);
 		inline static constexpr std::size_t ErrorValue = seed;
 
 		template<typename T>
 		static std::size_t hash_fundamental(T x) noexcept {
-			return hash_bytes(&x, sizeof(x));
+			auto const bytes = detail::to_little_endian(x);
+			return hash_bytes(&bytes, sizeof(bytes));
 		}
 		static std::size_t hash_bytes(void const *ptr, std::size_t len) noexcept {
 			return xxh::xxhash3<size_t_bits>(ptr, len, seed);
 		}
+
+		/** hash_bytes of the little endian representation of len bytes of ElemSize byte elements that are stored in byte order Order. */
+		template<std::size_t ElemSize, std::endian Order = std::endian::native>
+		static std::size_t hash_elements(void const *ptr, std::size_t len) noexcept {
+			if constexpr (Order == std::endian::little || ElemSize == 1) {
+				return hash_bytes(ptr, len);
+			} else {
+				return detail::hash_little_endian_chunks<ElemSize, Order>(ptr, len, &hash_bytes,
+																		  [] { return xxh::hash3_state_t<size_t_bits>{seed}; });
+			}
+		}
 		static std::size_t hash_combine(std::initializer_list<std::size_t> hashes) noexcept {
 			return xxh::xxhash3<size_t_bits>(hashes, seed);
 		}
@@ -105,6 +244,7 @@ namespace dice::hash::Policies {
             explicit HashState(std::size_t) noexcept {}
 
 			void add(std::size_t hash) noexcept {
+				hash = detail::to_little_endian(hash);
 				hash_state.update(&hash, sizeof(std::size_t));
 			}
             [[nodiscard]] std::size_t digest() noexcept {
@@ -112,16 +252,18 @@ namespace dice::hash::Policies {
 			}
 		};
 	};
-#endif
 
 	struct Martinus {
+		/** Version of the hash values, see policy_version_v. */
+		static constexpr std::uint32_t version = 1;
 		static constexpr std::size_t ErrorValue = dice::hash::martinus::seed;
 		template<typename T>
 		static std::size_t hash_fundamental(T x) noexcept {
 			if constexpr (sizeof(std::decay_t<T>) == sizeof(size_t)) {
-				return dice::hash::martinus::hash_int(*reinterpret_cast<size_t const *>(&x));
+				return dice::hash::martinus::hash_int(std::bit_cast<size_t>(x));
 			} else if constexpr (sizeof(std::decay_t<T>) > sizeof(size_t) or std::is_floating_point_v<std::decay_t<T>>) {
-				return hash_bytes(&x, sizeof(x));
+				auto const bytes = detail::to_little_endian(x);
+				return hash_bytes_fixed<sizeof(bytes)>(&bytes);
 			} else {
 				return dice::hash::martinus::hash_int(static_cast<size_t>(x));
 			}
@@ -129,6 +271,22 @@ namespace dice::hash::Policies {
 		static std::size_t hash_bytes(void const *ptr, std::size_t len) noexcept {
 			return dice::hash::martinus::hash_bytes(ptr, len);
 		}
+
+		/** hash_bytes of the little endian representation of len bytes of ElemSize byte elements that are stored in byte order Order. */
+		template<std::size_t ElemSize, std::endian Order = std::endian::native>
+		static std::size_t hash_elements(void const *ptr, std::size_t len) noexcept {
+			return dice::hash::martinus::hash_elements<ElemSize, Order>(ptr, len);
+		}
+
+		/** hash_bytes(ptr, N) for a length known at compile time, without branches on the length up to max_fixed_len bytes. */
+		template<std::size_t N>
+		static std::size_t hash_bytes_fixed(void const *ptr) noexcept {
+			if constexpr (N <= max_fixed_len) {
+				return dice::hash::martinus::hash_bytes<N>(ptr);
+			} else {
+				return hash_bytes(ptr, N);
+			}
+		}
 		static std::size_t hash_combine(std::initializer_list<size_t> hashes) noexcept {
 			return dice::hash::martinus::hash_combine(hashes);
 		}
@@ -153,5 +311,171 @@ namespace dice::hash::Policies {
 			}
 		};
 	};
+
+	/** wyhash keyed with a runtime seed (see KeyedHashPolicy).
+	 * The secret (the salt of wyhash) is derived from the seed with wyhash's make_secret, so hashing does exactly the same work as
+	 * Policies::wyhash, just with the seed and secret loaded from the policy object instead of compile time constants.
+	 * The hash values are different from Policies::wyhash (and not stable, the policy is meant for in-memory hash tables).
+	 */
+	class seeded_wyhash {
+		uint64_t seed_;
+		uint64_t secret_[4];
+		uint64_t state_seed_;// initial state of hash_combine and HashState, also the seed of hash_fundamental for integrals
+
+		/** Mixes a hash into state; both are masked with secret words so that small values (e.g. 0 or 1) do not cancel the multiplication. */
+		[[nodiscard]] static uint64_t mix(uint64_t state, uint64_t hash, uint64_t state_mask, uint64_t hash_mask) noexcept {
+			return dice::hash::wyhash::_wymix(state ^ state_mask, hash ^ hash_mask);
+		}
+
+	public:
+		inline static constexpr std::size_t ErrorValue = wyhash::ErrorValue;
+
+		explicit seeded_wyhash(uint64_t seed) noexcept : seed_{seed} {
+			dice::hash::wyhash::make_secret(seed, secret_);
+			state_seed_ = seed_ ^ secret_[0];
+		}
+
+		template<typename T>
+		[[nodiscard]] std::size_t hash_fundamental(T x) const noexcept {
+			if constexpr (std::is_integral_v<T>) {
+				return static_cast<std::size_t>(dice::hash::wyhash::wyhash64(state_seed_, x));
+			}
+			auto const bytes = detail::to_little_endian(x);
+			return hash_bytes_fixed<sizeof(T)>(&bytes);
+		}
+
+		[[nodiscard]] std::size_t hash_bytes(void const *ptr, std::size_t len) const noexcept {
+			return static_cast<std::size_t>(dice::hash::wyhash::wyhash(ptr, len, seed_, secret_));
+		}
+
+		/** hash_bytes of the little endian representation of len bytes of ElemSize byte elements that are stored in byte order Order. */
+		template<std::size_t ElemSize, std::endian Order = std::endian::native>
+		[[nodiscard]] std::size_t hash_elements(void const *ptr, std::size_t len) const noexcept {
+			return static_cast<std::size_t>(dice::hash::wyhash::wyhash_elements<ElemSize, Order>(ptr, len, seed_, secret_));
+		}
+
+		template<std::size_t N>
+		[[nodiscard]] std::size_t hash_bytes_fixed(void const *ptr) const noexcept {
+			if constexpr (N <= max_fixed_len) {
+				return static_cast<std::size_t>(dice::hash::wyhash::wyhash_fixed<N>(ptr, seed_, secret_));
+			} else {
+				return hash_bytes(ptr, N);
+			}
+		}
+
+		[[nodiscard]] std::size_t hash_combine(std::initializer_list<size_t> hashes) const noexcept {
+			uint64_t state = state_seed_;
+			for (auto hash : hashes) {
+				state = mix(state, hash, secret_[1], secret_[2]);
+			}
+			return static_cast<std::size_t>(state);
+		}
+
+		[[nodiscard]] static std::size_t hash_invertible_combine(std::initializer_list<size_t> hashes) noexcept {
+			return wyhash::hash_invertible_combine(hashes);
+		}
+
+		class HashState {
+		private:
+			uint64_t state;
+			uint64_t state_mask;
+			uint64_t hash_mask;
+
+		public:
+			HashState(seeded_wyhash const &policy, std::size_t) noexcept
+				: state{policy.state_seed_}, state_mask{policy.secret_[1]}, hash_mask{policy.secret_[2]} {}
+			void add(std::size_t hash) noexcept {
+				state = mix(state, static_cast<uint64_t>(hash), state_mask, hash_mask);
+			}
+			[[nodiscard]] std::size_t digest() noexcept {
+				return static_cast<std::size_t>(state);
+			}
+		};
+	};
+
+	/** xxh3 keyed with a custom secret (see KeyedHashPolicy).
+	 * The secret is either generated from a runtime seed or provided by the caller.
+	 * Unlike a seeded xxh3 call (as in Policies::xxh3), hashing with a custom secret does not derive a secret from the seed on every call,
+	 * so it is at least as fast as Policies::xxh3.
+	 * The hash values are different from Policies::xxh3 (and not stable, the policy is meant for in-memory hash tables).
+	 */
+	class seeded_xxh3 {
+	public:
+		/** Size of the secret in bytes (the size of xxh3's default secret). */
+		inline static constexpr std::size_t secret_size = xxh::detail3::secret_default_size;
+
+	private:
+		alignas(8) std::array<std::byte, secret_size> secret_;
+
+	public:
+		inline static constexpr std::size_t ErrorValue = xxh3::ErrorValue;
+
+		/** Generates the secret from seed (with splitmix64).
+		 * @param seed the seed
+		 */
+		explicit seeded_xxh3(uint64_t seed) noexcept {
+			for (std::size_t i = 0; i < secret_size; i += sizeof(uint64_t)) {
+				seed += 0x9E3779B97F4A7C15UL;
+				uint64_t z = seed;
+				z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9UL;
+				z = (z ^ (z >> 27)) * 0x94D049BB133111EBUL;
+				z = detail::to_little_endian(z ^ (z >> 31));
+				std::memcpy(secret_.data() + i, &z, sizeof(z));
+			}
+		}
+
+		/** Uses secret as the xxh3 secret. It must be random (e.g. from a CSPRNG), see the xxHash documentation.
+		 * @param secret the secret
+		 */
+		explicit seeded_xxh3(std::span<std::byte const, secret_size> secret) noexcept {
+			std::ranges::copy(secret, secret_.begin());
+		}
+
+		template<typename T>
+		[[nodiscard]] std::size_t hash_fundamental(T x) const noexcept {
+			auto const bytes = detail::to_little_endian(x);
+			return hash_bytes(&bytes, sizeof(bytes));
+		}
+
+		[[nodiscard]] std::size_t hash_bytes(void const *ptr, std::size_t len) const noexcept {
+			return xxh::xxhash3<xxh3::size_t_bits>(ptr, len, secret_.data(), secret_size);
+		}
+
+		/** hash_bytes of the little endian representation of len bytes of ElemSize byte elements that are stored in byte order Order. */
+		template<std::size_t ElemSize, std::endian Order = std::endian::native>
+		[[nodiscard]] std::size_t hash_elements(void const *ptr, std::size_t len) const noexcept {
+			if constexpr (Order == std::endian::little || ElemSize == 1) {
+				return hash_bytes(ptr, len);
+			} else {
+				return detail::hash_little_endian_chunks<ElemSize, Order>(
+						ptr, len, [this](void const *bytes, std::size_t n) noexcept { return hash_bytes(bytes, n); },
+						[this] { return xxh::hash3_state_t<xxh3::size_t_bits>{secret_.data(), secret_size}; });
+			}
+		}
+
+		[[nodiscard]] std::size_t hash_combine(std::initializer_list<std::size_t> hashes) const noexcept {
+			return xxh::xxhash3<xxh3::size_t_bits>(hashes, secret_.data(), secret_size);
+		}
+
+		[[nodiscard]] static std::size_t hash_invertible_combine(std::initializer_list<size_t> hashes) noexcept {
+			return xxh3::hash_invertible_combine(hashes);
+		}
+
+		class HashState {
+		private:
+			xxh::hash3_state64_t hash_state;
+
+		public:
+			HashState(seeded_xxh3 const &policy, std::size_t) noexcept : hash_state{policy.secret_.data(), secret_size} {}
+
+			void add(std::size_t hash) noexcept {
+				hash = detail::to_little_endian(hash);
+				hash_state.update(&hash, sizeof(std::size_t));
+			}
+			[[nodiscard]] std::size_t digest() noexcept {
+				return hash_state.digest();
+			}
+		};
+	};
 }// namespace dice::hash::Policies
 #endif//DICE_HASH_DICEHASHPOLICIES_HPP
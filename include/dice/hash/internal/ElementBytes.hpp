@@ -0,0 +1,42 @@
+#ifndef DICE_HASH_ELEMENTBYTES_HPP
+#define DICE_HASH_ELEMENTBYTES_HPP
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+namespace dice::hash::detail {
+
+	/** The bytes of a sequence of ElemSize byte elements that are stored in byte order Order, read as if the elements were stored
+	 * in little endian byte order. The hash_elements kernels load their input through it, so that the hash values of sequences of
+	 * fundamentals do not depend on the endianness of the platform, without converting the sequence first.
+	 * @tparam ElemSize size of an element in bytes
+	 * @tparam Order byte order of the stored elements
+	 */
+	template<std::size_t ElemSize, std::endian Order>
+	struct ElementBytes {
+		std::uint8_t const *data;
+
+		/** @return byte i of the little endian representation */
+		[[nodiscard]] std::uint8_t operator[](std::size_t i) const noexcept {
+			if constexpr (Order == std::endian::little || ElemSize == 1) {
+				return data[i];
+			} else {
+				auto const in_elem = i % ElemSize;
+				return data[i - in_elem + (ElemSize - 1 - in_elem)];
+			}
+		}
+
+		/** @return the n (at most 8) bytes of the little endian representation starting at byte i as a little endian integer */
+		[[nodiscard]] std::uint64_t load_le(std::size_t i, std::size_t n) const noexcept {
+			std::uint64_t x = 0;
+			for (std::size_t j = 0; j < n; ++j) {
+				x |= static_cast<std::uint64_t>((*this)[i + j]) << (8 * j);
+			}
+			return x;
+		}
+	};
+
+}// namespace dice::hash::detail
+
+#endif//DICE_HASH_ELEMENTBYTES_HPP
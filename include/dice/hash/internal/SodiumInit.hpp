@@ -0,0 +1,53 @@
+#ifndef DICE_HASH_SODIUMINIT_HPP
+#define DICE_HASH_SODIUMINIT_HPP
+
+/**
+ * @brief One-time initialization of libsodium
+ */
+
+#if __has_include(<sodium.h>)
+
+#include <sodium.h>
+
+#include <stdexcept>
+
+namespace dice::hash {
+
+	namespace detail {
+		/**
+		 * @brief Calls sodium_init exactly once per process (thread-safe)
+		 * @return true if libsodium was initialized successfully
+		 * @note if initialization fails libsodium still works correctly, it just cannot select
+		 * 		the fastest implementations for the current CPU
+		 */
+		inline bool sodium_init_once() noexcept {
+			static bool const initialized = sodium_init() != -1;
+			return initialized;
+		}
+
+		/**
+		 * @brief forces initialization of libsodium during static initialization,
+		 * 		so that the first hash computation does not pay for it
+		 */
+		inline bool const sodium_eagerly_initialized = sodium_init_once();
+	} // namespace detail
+
+	/**
+	 * @brief Explicitly initializes the libraries dice-hash depends on.
+	 * 		Calling this is optional, initialization happens automatically (and exactly once) otherwise.
+	 * 		It is idempotent and thread-safe.
+	 * @throws std::runtime_error if libsodium could not be initialized
+	 */
+	inline void init() {
+		if (!detail::sodium_init_once()) {
+			throw std::runtime_error{"Could not initialize sodium"};
+		}
+	}
+
+} // namespace dice::hash
+
+#else
+#error "Cannot include SodiumInit.hpp if sodium is not available"
+#endif // __has_include(<sodium.h>)
+
+#endif // DICE_HASH_SODIUMINIT_HPP
@@ -32,10 +32,14 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#include "ElementBytes.hpp"
+
+#include <bit>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
 #include <initializer_list>
+#include <utility>
 
 
 namespace dice::hash::martinus {
@@ -54,22 +58,52 @@ namespace dice::hash::martinus {
 		return t;
 	}
 
+	/** Loads 8 bytes as a little endian integer, so that hash_bytes does not depend on the endianness of the platform.
+	 */
+	inline uint64_t unaligned_load_le64(void const *ptr) noexcept {
+		auto x = unaligned_load<uint64_t>(ptr);
+		if constexpr (std::endian::native == std::endian::big) {
+			x = ((x & 0x00000000FFFFFFFFULL) << 32) | ((x & 0xFFFFFFFF00000000ULL) >> 32);
+			x = ((x & 0x0000FFFF0000FFFFULL) << 16) | ((x & 0xFFFF0000FFFF0000ULL) >> 16);
+			x = ((x & 0x00FF00FF00FF00FFULL) << 8) | ((x & 0xFF00FF00FF00FF00ULL) >> 8);
+		}
+		return x;
+	}
+
 	template<typename T>
 	inline T rotr(T x, unsigned k) {
 		return (x >> k) | (x << (8U * sizeof(T) - k));
 	}
 
-	inline std::size_t hash_bytes(void const *ptr, std::size_t len) noexcept {
+	/** Reads the input bytes of hash_bytes_impl. */
+	struct NativeBytes {
+		uint8_t const *data;
+
+		[[nodiscard]] uint8_t operator[](std::size_t i) const noexcept {
+			return data[i];
+		}
 
+		[[nodiscard]] uint64_t load_le64(std::size_t i) const noexcept {
+			return unaligned_load_le64(data + i);
+		}
+	};
 
-		static constexpr unsigned int r = 47;
+	/** Reads the input of hash_bytes_impl, a sequence of elements, as if the elements were stored in little endian byte order. */
+	template<std::size_t elem_size, std::endian order>
+	struct ElementBytes : dice::hash::detail::ElementBytes<elem_size, order> {
+		[[nodiscard]] uint64_t load_le64(std::size_t i) const noexcept {
+			return this->load_le(i, 8);
+		}
+	};
 
-		auto const *const data64 = static_cast<uint64_t const *>(ptr);
+	/** hash_bytes, reading the len input bytes through bytes. */
+	template<typename Bytes>
+	inline std::size_t hash_bytes_impl(Bytes const &bytes, std::size_t len) noexcept {
 		uint64_t h = seed ^ (len * m);
 
 		size_t const n_blocks = len / 8;
 		for (std::size_t i = 0; i < n_blocks; ++i) {
-			auto k = unaligned_load<uint64_t>(data64 + i);
+			auto k = bytes.load_le64(8 * i);
 
 			k *= m;
 			k ^= k >> r;
@@ -79,28 +113,28 @@ namespace dice::hash::martinus {
 			h *= m;
 		}
 
-		auto const *const data8 = reinterpret_cast<uint8_t const *>(data64 + n_blocks);
+		auto const tail = 8 * n_blocks;
 		switch (len & 7U) {
 			case 7:
-				h ^= static_cast<uint64_t>(data8[6]) << 48U;
+				h ^= static_cast<uint64_t>(bytes[tail + 6]) << 48U;
 				[[fallthrough]];
 			case 6:
-				h ^= static_cast<uint64_t>(data8[5]) << 40U;
+				h ^= static_cast<uint64_t>(bytes[tail + 5]) << 40U;
 				[[fallthrough]];
 			case 5:
-				h ^= static_cast<uint64_t>(data8[4]) << 32U;
+				h ^= static_cast<uint64_t>(bytes[tail + 4]) << 32U;
 				[[fallthrough]];
 			case 4:
-				h ^= static_cast<uint64_t>(data8[3]) << 24U;
+				h ^= static_cast<uint64_t>(bytes[tail + 3]) << 24U;
 				[[fallthrough]];
 			case 3:
-				h ^= static_cast<uint64_t>(data8[2]) << 16U;
+				h ^= static_cast<uint64_t>(bytes[tail + 2]) << 16U;
 				[[fallthrough]];
 			case 2:
-				h ^= static_cast<uint64_t>(data8[1]) << 8U;
+				h ^= static_cast<uint64_t>(bytes[tail + 1]) << 8U;
 				[[fallthrough]];
 			case 1:
-				h ^= static_cast<uint64_t>(data8[0]);
+				h ^= static_cast<uint64_t>(bytes[tail]);
 				h *= m;
 				[[fallthrough]];
 			default:
@@ -113,6 +147,58 @@ namespace dice::hash::martinus {
 		return static_cast<size_t>(h);
 	}
 
+	inline std::size_t hash_bytes(void const *ptr, std::size_t len) noexcept {
+		return hash_bytes_impl(NativeBytes{static_cast<uint8_t const *>(ptr)}, len);
+	}
+
+	/** hash_bytes of the little endian representation of len bytes of elem_size byte elements that are stored in byte order order.
+	 */
+	template<std::size_t elem_size, std::endian order>
+	inline std::size_t hash_elements(void const *ptr, std::size_t len) noexcept {
+		if constexpr (order == std::endian::little || elem_size == 1) {
+			return hash_bytes(ptr, len);
+		} else {
+			return hash_bytes_impl(ElementBytes<elem_size, order>{{static_cast<uint8_t const *>(ptr)}}, len);
+		}
+	}
+
+	/** hash_bytes for a length that is known at compile time.
+	 * Returns the same value as hash_bytes(ptr, len), but the block loop is unrolled and the tail is
+	 * combined without the switch, i.e. the code does not branch on the length.
+	 * @tparam len number of bytes
+	 */
+	template<std::size_t len>
+	inline std::size_t hash_bytes(void const *ptr) noexcept {
+		auto const *const data8 = static_cast<uint8_t const *>(ptr);
+		uint64_t h = seed ^ (len * m);
+
+		if constexpr (len >= 8) {
+			[&]<std::size_t... blocks>(std::index_sequence<blocks...>) {
+				auto const add_block = [&h](uint64_t k) {
+					k *= m;
+					k ^= k >> r;
+					k *= m;
+
+					h ^= k;
+					h *= m;
+				};
+				(add_block(unaligned_load_le64(data8 + 8 * blocks)), ...);
+			}(std::make_index_sequence<len / 8>{});
+		}
+
+		if constexpr (constexpr std::size_t tail = len & 7U; tail != 0) {
+			[&]<std::size_t... bytes>(std::index_sequence<bytes...>) {
+				((h ^= static_cast<uint64_t>(data8[len - tail + bytes]) << (8U * bytes)), ...);
+			}(std::make_index_sequence<tail>{});
+			h *= m;
+		}
+
+		h ^= h >> r;
+		h *= m;
+		h ^= h >> r;
+		return static_cast<size_t>(h);
+	}
+
 	inline std::size_t hash_combine(std::initializer_list<size_t> hashes) {
 
 
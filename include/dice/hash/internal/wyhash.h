@@ -29,6 +29,7 @@
 //includes
 #include <stdint.h>
 #include <string.h>
+#include "ElementBytes.hpp"
 #if defined(_MSC_VER) && defined(_M_X64)
 #include <intrin.h>
 #pragma intrinsic(_umul128)
@@ -155,17 +156,36 @@ namespace dice::hash::wyhash {
 	}
 #endif
 	static inline uint64_t _wyr3(const uint8_t *p, size_t k) { return (((uint64_t) p[0]) << 16) | (((uint64_t) p[k >> 1]) << 8) | p[k - 1]; }
-	//wyhash main function
-	static inline uint64_t wyhash(const void *key, size_t len, uint64_t seed, const uint64_t *secret) {
-		const uint8_t *p = (const uint8_t *) key;
+
+	//reader of the input bytes of _wyhash
+	struct _wybytes {
+		const uint8_t *p;
+		uint64_t r8(size_t i) const { return _wyr8(p + i); }
+		uint64_t r4(size_t i) const { return _wyr4(p + i); }
+		uint64_t r3(size_t i, size_t k) const { return _wyr3(p + i, k); }
+	};
+
+	//reader of the input of _wyhash that reads a sequence of elements as if they were stored in little endian byte order
+	template<size_t elem_size, std::endian order>
+	struct _wyelements {
+		dice::hash::detail::ElementBytes<elem_size, order> bytes;
+		uint64_t r8(size_t i) const { return bytes.load_le(i, 8); }
+		uint64_t r4(size_t i) const { return bytes.load_le(i, 4); }
+		uint64_t r3(size_t i, size_t k) const { return (((uint64_t) bytes[i]) << 16) | (((uint64_t) bytes[i + (k >> 1)]) << 8) | bytes[i + k - 1]; }
+	};
+
+	//wyhash main function, reading the len input bytes through in
+	template<typename Reader>
+	static inline uint64_t _wyhash(Reader in, size_t len, uint64_t seed, const uint64_t *secret) {
+		size_t p = 0;
 		seed ^= *secret;
 		uint64_t a, b;
 		if (_likely_(len <= 16)) {
 			if (_likely_(len >= 4)) {
-				a = (_wyr4(p) << 32) | _wyr4(p + ((len >> 3) << 2));
-				b = (_wyr4(p + len - 4) << 32) | _wyr4(p + len - 4 - ((len >> 3) << 2));
+				a = (in.r4(p) << 32) | in.r4(p + ((len >> 3) << 2));
+				b = (in.r4(p + len - 4) << 32) | in.r4(p + len - 4 - ((len >> 3) << 2));
 			} else if (_likely_(len > 0)) {
-				a = _wyr3(p, len);
+				a = in.r3(p, len);
 				b = 0;
 			} else
 				a = b = 0;
@@ -174,19 +194,75 @@ namespace dice::hash::wyhash {
 			if (_unlikely_(i > 48)) {
 				uint64_t see1 = seed, see2 = seed;
 				do {
-					seed = _wymix(_wyr8(p) ^ secret[1], _wyr8(p + 8) ^ seed);
-					see1 = _wymix(_wyr8(p + 16) ^ secret[2], _wyr8(p + 24) ^ see1);
-					see2 = _wymix(_wyr8(p + 32) ^ secret[3], _wyr8(p + 40) ^ see2);
+					seed = _wymix(in.r8(p) ^ secret[1], in.r8(p + 8) ^ seed);
+					see1 = _wymix(in.r8(p + 16) ^ secret[2], in.r8(p + 24) ^ see1);
+					see2 = _wymix(in.r8(p + 32) ^ secret[3], in.r8(p + 40) ^ see2);
 					p += 48;
 					i -= 48;
 				} while (_likely_(i > 48));
 				seed ^= see1 ^ see2;
 			}
 			while (_unlikely_(i > 16)) {
-				seed = _wymix(_wyr8(p) ^ secret[1], _wyr8(p + 8) ^ seed);
+				seed = _wymix(in.r8(p) ^ secret[1], in.r8(p + 8) ^ seed);
 				i -= 16;
 				p += 16;
 			}
+			a = in.r8(p + i - 16);
+			b = in.r8(p + i - 8);
+		}
+		return _wymix(secret[1] ^ len, _wymix(a ^ secret[1], b ^ seed));
+	}
+
+	static inline uint64_t wyhash(const void *key, size_t len, uint64_t seed, const uint64_t *secret) {
+		return _wyhash(_wybytes{(const uint8_t *) key}, len, seed, secret);
+	}
+
+	//wyhash of the little endian representation of len bytes of elem_size byte elements that are stored in byte order order
+	template<size_t elem_size, std::endian order>
+	static inline uint64_t wyhash_elements(const void *key, size_t len, uint64_t seed, const uint64_t *secret) {
+		if constexpr (order == std::endian::little || elem_size == 1) {
+			return wyhash(key, len, seed, secret);
+		} else {
+			return _wyhash(_wyelements<elem_size, order>{{(const uint8_t *) key}}, len, seed, secret);
+		}
+	}
+
+	//wyhash for a length that is known at compile time: the same result as wyhash(key, len, seed, secret), without branches on the length.
+	//the loops are unrolled, so it is meant for short keys (dice-hash uses it up to 64 bytes)
+	template<size_t len>
+	static inline uint64_t wyhash_fixed(const void *key, uint64_t seed, const uint64_t *secret) {
+		const uint8_t *p = (const uint8_t *) key;
+		seed ^= *secret;
+		uint64_t a, b;
+		if constexpr (len <= 16) {
+			if constexpr (len >= 4) {
+				constexpr size_t offset = (len >> 3) << 2;
+				a = (_wyr4(p) << 32) | _wyr4(p + offset);
+				b = (_wyr4(p + len - 4) << 32) | _wyr4(p + len - 4 - offset);
+			} else if constexpr (len > 0) {
+				a = _wyr3(p, len);
+				b = 0;
+			} else {
+				a = b = 0;
+			}
+		} else {
+			//number of iterations of the 48 and 16 byte loops of wyhash
+			constexpr size_t n48 = len > 48 ? (len - 1) / 48 : 0;
+			constexpr size_t rest = len - 48 * n48;
+			constexpr size_t n16 = rest > 16 ? (rest - 1) / 16 : 0;
+			if constexpr (n48 > 0) {
+				uint64_t see1 = seed, see2 = seed;
+				for (size_t k = 0; k < n48; ++k, p += 48) {
+					seed = _wymix(_wyr8(p) ^ secret[1], _wyr8(p + 8) ^ seed);
+					see1 = _wymix(_wyr8(p + 16) ^ secret[2], _wyr8(p + 24) ^ see1);
+					see2 = _wymix(_wyr8(p + 32) ^ secret[3], _wyr8(p + 40) ^ see2);
+				}
+				seed ^= see1 ^ see2;
+			}
+			for (size_t k = 0; k < n16; ++k, p += 16) {
+				seed = _wymix(_wyr8(p) ^ secret[1], _wyr8(p + 8) ^ seed);
+			}
+			constexpr size_t i = rest - 16 * n16;
 			a = _wyr8(p + i - 16);
 			b = _wyr8(p + i - 8);
 		}
@@ -1,4 +1,5 @@
 #pragma once
+#include <algorithm>
 #include <array>
 #include <cstdint>
 #include <cstring>
@@ -42,7 +43,12 @@ You can contact the author at :
 /* Intrinsics
 * Sadly has to be included in the global namespace or literally everything breaks
 */
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define XXH_X86_INTRINSICS 1
 #include <immintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#endif
 
 namespace xxh {
     /* *************************************
@@ -119,22 +125,25 @@ namespace xxh {
 
 
         /* Vectorization Detection
-        * NOTE: XXH_NEON and XXH_VSX aren't supported in this C++ port.
-        * The primary reason is that I don't have access to an ARM and PowerPC
-        * machines to test them, and the secondary reason is that I even doubt anyone writing
-        * code for such machines would bother using a C++ port rather than the original C version.
+        * NOTE: XXH_VSX isn't supported in this C++ port.
+        * XXH_NEON (AArch64 only) uses the 128 bit code path of SSE2 with NEON implementations of the vector operations.
+        * SVE is not used: its vectors have no compile time size, so they cannot be stored in the accumulator arrays of this port;
+        * AArch64 CPUs with SVE also have NEON.
         */
 #ifndef XXH_VECTOR /* can be predefined on command line */
 #if defined(__AVX2__)
 #define XXH_VECTOR 2 /* AVX2 for Haswell and Bulldozer */
 #elif defined(__SSE2__) || defined(_M_AMD64) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP == 2))
 #define XXH_VECTOR 1 /* SSE2 for Pentium 4 and all x86_64 */
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define XXH_VECTOR 3 /* NEON for AArch64 */
 #else
 #define XXH_VECTOR 0 /* Portable scalar version */
 #endif
 #endif
 
-        constexpr int vector_mode = XXH_VECTOR;
+        // NEON uses the 128 bit (SSE2) code path
+        constexpr int vector_mode = XXH_VECTOR == 3 ? 1 : XXH_VECTOR;
 
 #if XXH_VECTOR == 2 /* AVX2 for Haswell and Bulldozer */
         constexpr int acc_align = 32;
@@ -144,6 +153,10 @@ namespace xxh {
         using avx2_underlying = void;//std::array<__m128i, 2>;
         using sse2_underlying = __m128i;
         constexpr int acc_align = 16;
+#elif XXH_VECTOR == 3 /* NEON for AArch64 */
+        using avx2_underlying = void;
+        using sse2_underlying = uint64x2_t;
+        constexpr int acc_align = 16;
 #else /* Portable scalar version */
         using avx2_underlying = void;//std::array<uint64_t, 4>;
 		using sse2_underlying = void;//std::array<uint64_t, 2>;
@@ -169,7 +182,9 @@ namespace xxh {
 #elif defined(__GNUC__) /* Clang / GCC */
 #define XXH_FORCE_INLINE static inline __attribute__((always_inline))
 #define XXH_NO_INLINE static __attribute__((noinline))
+#ifdef XXH_X86_INTRINSICS
 #include <mmintrin.h>
+#endif
 #else
         #define XXH_FORCE_INLINE static inline
 #define XXH_NO_INLINE static
@@ -509,11 +524,17 @@ namespace xxh {
             static_assert(!(N != 128 && N != 256 && N != 64), "Invalid template argument passed to xxh::vec_ops::loadu");
 
             if constexpr (N == 128) {
+#if XXH_VECTOR == 3
+                return vld1q_u64(reinterpret_cast<uint64_t const *>(input));
+#elif defined(XXH_X86_INTRINSICS)
                 return _mm_loadu_si128(input);
+#endif
             }
 
             if constexpr (N == 256) {
+#ifdef XXH_X86_INTRINSICS
                 return _mm256_loadu_si256(input);
+#endif
             }
 
             if constexpr (N == 64) {
@@ -528,11 +549,17 @@ namespace xxh {
             static_assert(!(N != 128 && N != 256 && N != 64), "Invalid argument passed to xxh::vec_ops::xorv");
 
             if constexpr (N == 128) {
+#if XXH_VECTOR == 3
+                return veorq_u64(a, b);
+#elif defined(XXH_X86_INTRINSICS)
                 return _mm_xor_si128(a, b);
+#endif
             }
 
             if constexpr (N == 256) {
+#ifdef XXH_X86_INTRINSICS
                 return _mm256_xor_si256(a, b);
+#endif
             }
 
             if constexpr (N == 64) {
@@ -546,11 +573,17 @@ namespace xxh {
             static_assert(!(N != 128 && N != 256 && N != 64), "Invalid argument passed to xxh::vec_ops::mul");
 
             if constexpr (N == 128) {
+#if XXH_VECTOR == 3
+                return vmull_u32(vmovn_u64(a), vmovn_u64(b));
+#elif defined(XXH_X86_INTRINSICS)
                 return _mm_mul_epu32(a, b);
+#endif
             }
 
             if constexpr (N == 256) {
+#ifdef XXH_X86_INTRINSICS
                 return _mm256_mul_epu32(a, b);
+#endif
             }
 
             if constexpr (N == 64) {
@@ -564,11 +597,17 @@ namespace xxh {
             static_assert(!(N != 128 && N != 256 && N != 64), "Invalid argument passed to xxh::vec_ops::add");
 
             if constexpr (N == 128) {
+#if XXH_VECTOR == 3
+                return vaddq_u64(a, b);
+#elif defined(XXH_X86_INTRINSICS)
                 return _mm_add_epi64(a, b);
+#endif
             }
 
             if constexpr (N == 256) {
+#ifdef XXH_X86_INTRINSICS
                 return _mm256_add_epi64(a, b);
+#endif
             }
 
             if constexpr (N == 64) {
@@ -582,11 +621,23 @@ namespace xxh {
             static_assert(!(N != 128 && N != 256 && N != 64), "Invalid argument passed to xxh::vec_ops::shuffle");
 
             if constexpr (N == 128) {
+#if XXH_VECTOR == 3
+                // same semantics as _mm_shuffle_epi32(a, _MM_SHUFFLE(S1, S2, S3, S4)): 32 bit lane i of the result is lane S(4 - i) of a
+                alignas(16) static constexpr uint8_t indices[16]{
+                        4 * S4, 4 * S4 + 1, 4 * S4 + 2, 4 * S4 + 3,
+                        4 * S3, 4 * S3 + 1, 4 * S3 + 2, 4 * S3 + 3,
+                        4 * S2, 4 * S2 + 1, 4 * S2 + 2, 4 * S2 + 3,
+                        4 * S1, 4 * S1 + 1, 4 * S1 + 2, 4 * S1 + 3};
+                return vreinterpretq_u64_u8(vqtbl1q_u8(vreinterpretq_u8_u64(a), vld1q_u8(indices)));
+#elif defined(XXH_X86_INTRINSICS)
                 return _mm_shuffle_epi32(a, _MM_SHUFFLE(S1, S2, S3, S4));
+#endif
             }
 
             if constexpr (N == 256) {
+#ifdef XXH_X86_INTRINSICS
                 return _mm256_shuffle_epi32(a, _MM_SHUFFLE(S1, S2, S3, S4));
+#endif
             }
 
             if constexpr (N == 64) {
@@ -600,11 +651,17 @@ namespace xxh {
             static_assert(!(N != 128 && N != 256 && N != 64), "Invalid argument passed to xxh::vec_ops::set1");
 
             if constexpr (N == 128) {
+#if XXH_VECTOR == 3
+                return vreinterpretq_u64_u32(vdupq_n_u32(static_cast<uint32_t>(a)));
+#elif defined(XXH_X86_INTRINSICS)
                 return _mm_set1_epi32(a);
+#endif
             }
 
             if constexpr (N == 256) {
+#ifdef XXH_X86_INTRINSICS
                 return _mm256_set1_epi32(a);
+#endif
             }
 
             if constexpr (N == 64) {
@@ -618,11 +675,17 @@ namespace xxh {
             static_assert(!(N != 128 && N != 256 && N != 64), "Invalid argument passed to xxh::vec_ops::srli");
 
             if constexpr (N == 128) {
+#if XXH_VECTOR == 3
+                return vshlq_u64(n, vdupq_n_s64(-a));
+#elif defined(XXH_X86_INTRINSICS)
                 return _mm_srli_epi64(n, a);
+#endif
             }
 
             if constexpr (N == 256) {
+#ifdef XXH_X86_INTRINSICS
                 return _mm256_srli_epi64(n, a);
+#endif
             }
 
             if constexpr (N == 64) {
@@ -636,11 +699,17 @@ namespace xxh {
             static_assert(!(N != 128 && N != 256 && N != 64), "Invalid argument passed to xxh::vec_ops::slli");
 
             if constexpr (N == 128) {
+#if XXH_VECTOR == 3
+                return vshlq_u64(n, vdupq_n_s64(a));
+#elif defined(XXH_X86_INTRINSICS)
                 return _mm_slli_epi64(n, a);
+#endif
             }
 
             if constexpr (N == 256) {
+#ifdef XXH_X86_INTRINSICS
                 return _mm256_slli_epi64(n, a);
+#endif
             }
 
             if constexpr (N == 64) {
@@ -1802,10 +1871,15 @@ namespace xxh {
             if (input + internal_buffer_size <= bEnd) {
                 const uint8_t *const limit = bEnd - internal_buffer_size;
 
+                const uint8_t *last_stripe;
                 do {
                     consume_stripes(acc, nbStripesSoFar, internal_buffer_stripes, input, accWidth);
+                    last_stripe = input + internal_buffer_size - detail3::stripe_len;
                     input += internal_buffer_size;
                 } while (input <= limit);
+
+                /* digest_long reads the last stripe before a short remainder from the end of the buffer (as in upstream xxHash) */
+                std::copy_n(last_stripe, detail3::stripe_len, buffer + sizeof(buffer) - detail3::stripe_len);
             }
 
             if (input < bEnd) { /* some remaining input input : buffer it */
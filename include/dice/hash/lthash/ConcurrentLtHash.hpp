@@ -0,0 +1,217 @@
+#ifndef DICE_HASH_CONCURRENTLTHASH_HPP
+#define DICE_HASH_CONCURRENTLTHASH_HPP
+
+#include "dice/hash/lthash/LtHash.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <thread>
+
+namespace dice::hash::lthash {
+
+	/**
+	 * @brief An LtHash that many threads can add objects to (and remove objects from) at the same time.
+	 *
+	 * The state is split into shards, every thread is assigned to one shard (round-robin on first use).
+	 * add/remove hash the object without holding any lock and then only lock the shard of the calling thread for
+	 * the (short, vectorized) addition of the object hash, so threads on different shards never contend.
+	 * checksum()/snapshot() sum up all shards.
+	 *
+	 * @note the resulting checksum is identical to adding/removing the same objects (in any order) to a single LtHash
+	 * @note set_key and clear must not be called concurrently with other member functions
+	 */
+	template<size_t n_bits_per_elem, size_t n_elems, template<size_t> typename HashT = blake3::Blake3, template<typename> typename MathEngineT = DefaultMathEngine>
+	struct ConcurrentLtHash {
+		using lthash_type = LtHash<n_bits_per_elem, n_elems, HashT, MathEngineT>;
+
+		static constexpr bool needs_padding = lthash_type::needs_padding;
+		static constexpr size_t element_bits = lthash_type::element_bits;
+		static constexpr size_t element_count = lthash_type::element_count;
+		static constexpr size_t checksum_len = lthash_type::checksum_len;
+
+	private:
+		using Bits = detail::Bits<n_bits_per_elem>;
+		using MathEngine = MathEngineT<Bits>;
+		using Hash = HashT<checksum_len>;
+
+		static constexpr size_t cache_line_size = 64;
+
+		struct alignas(cache_line_size) Shard {
+			std::mutex mutex;
+			alignas(MathEngine::min_buffer_align) std::array<std::byte, checksum_len> sum{};
+		};
+
+		std::unique_ptr<Shard[]> shards_;
+		size_t shard_mask_;
+		detail::Key<Hash::min_key_extent, Hash::max_key_extent> key_;
+
+		static size_t thread_slot() noexcept {
+			static std::atomic<size_t> next_slot{0};
+			static thread_local size_t const slot = next_slot.fetch_add(1, std::memory_order_relaxed);
+			return slot;
+		}
+
+		[[nodiscard]] Shard &local_shard() const noexcept {
+			return shards_[thread_slot() & shard_mask_];
+		}
+
+		void hash_object(std::span<std::byte, checksum_len> out, std::span<std::byte const> obj) const noexcept {
+			Hash::hash_single(obj, out, key_.get());
+
+			if constexpr (needs_padding) {
+				MathEngine::clear_padding_bits(out);
+			}
+		}
+
+		/**
+		 * @brief adds (or subtracts if subtract) value to the shard of the calling thread
+		 * @throws std::system_error if the shard cannot be locked
+		 */
+		void update_local_shard(std::span<std::byte const, checksum_len> value, bool subtract) const {
+			auto &shard = local_shard();
+			std::lock_guard lock{shard.mutex};
+			if (subtract) {
+				MathEngine::sub(std::span<std::byte, checksum_len>{shard.sum}, value);
+			} else {
+				MathEngine::add(std::span<std::byte, checksum_len>{shard.sum}, value);
+			}
+		}
+
+		void combine(lthash_type const &other, bool subtract) const {
+			if (!other.key_equal(key_.get())) [[unlikely]] {
+				throw std::invalid_argument{"Cannot combine hashes with different keys"};
+			}
+
+			update_local_shard(other.checksum(), subtract);
+		}
+
+	public:
+		/**
+		 * @brief Creates an empty ConcurrentLtHash
+		 * @param concurrency expected number of concurrently writing threads, rounded up to a power of two to get the number of shards
+		 */
+		explicit ConcurrentLtHash(size_t concurrency = std::thread::hardware_concurrency())
+			: shards_{std::make_unique<Shard[]>(std::bit_ceil(std::max<size_t>(concurrency, 1)))},
+			  shard_mask_{std::bit_ceil(std::max<size_t>(concurrency, 1)) - 1} {
+		}
+
+		ConcurrentLtHash(ConcurrentLtHash const &) = delete;
+		ConcurrentLtHash &operator=(ConcurrentLtHash const &) = delete;
+
+		~ConcurrentLtHash() noexcept {
+			key_.clear();
+		}
+
+		/**
+		 * @return number of shards
+		 */
+		[[nodiscard]] size_t shard_count() const noexcept {
+			return shard_mask_ + 1;
+		}
+
+		/**
+		 * @brief Sets the key used to hash objects; securely erases the old key
+		 * @throws std::invalid_argument if key.size() is not in Hash::min_key_extent..Hash::max_key_extent (inclusive); only if supplied_key_len == std::dynamic_extent
+		 */
+		template<size_t supplied_key_len>
+			requires (supplied_key_len == std::dynamic_extent || (supplied_key_len >= Hash::min_key_extent
+																 && supplied_key_len <= Hash::max_key_extent))
+		void set_key(std::span<std::byte const, supplied_key_len> key) noexcept(supplied_key_len != std::dynamic_extent) {
+			if constexpr (supplied_key_len == std::dynamic_extent) {
+				if (key.size() < Hash::min_key_extent || key.size() > Hash::max_key_extent) [[unlikely]] {
+					throw std::invalid_argument{"Invalid key size"};
+				}
+			}
+
+			key_.set_unchecked(key);
+		}
+
+		/**
+		 * @brief Adds a single object; may be called concurrently from any number of threads
+		 * @throws std::system_error if the shard cannot be locked
+		 */
+		void add(std::span<std::byte const> obj) {
+			alignas(MathEngine::min_buffer_align) std::array<std::byte, checksum_len> obj_hash;
+			hash_object(obj_hash, obj);
+			update_local_shard(obj_hash, false);
+		}
+
+		/**
+		 * @brief Removes a single object; may be called concurrently from any number of threads
+		 * @throws std::system_error if the shard cannot be locked
+		 */
+		void remove(std::span<std::byte const> obj) {
+			alignas(MathEngine::min_buffer_align) std::array<std::byte, checksum_len> obj_hash;
+			hash_object(obj_hash, obj);
+			update_local_shard(obj_hash, true);
+		}
+
+		/**
+		 * @brief Adds an LtHash (with the same key) to *this; may be called concurrently with add/remove
+		 * @throws std::invalid_argument if other has a different key
+		 * @throws std::system_error if the shard cannot be locked
+		 */
+		void combine_add(lthash_type const &other) {
+			combine(other, false);
+		}
+
+		/**
+		 * @brief Removes an LtHash (with the same key) from *this; may be called concurrently with add/remove
+		 * @throws std::invalid_argument if other has a different key
+		 * @throws std::system_error if the shard cannot be locked
+		 */
+		void combine_remove(lthash_type const &other) {
+			combine(other, true);
+		}
+
+		/**
+		 * @brief Sums up all shards
+		 * @note each shard is read consistently, but adds that happen concurrently with this call may or may not be included
+		 * @throws std::system_error if a shard cannot be locked
+		 */
+		[[nodiscard]] std::array<std::byte, checksum_len> checksum() const {
+			alignas(MathEngine::min_buffer_align) std::array<std::byte, checksum_len> sum{};
+			alignas(MathEngine::min_buffer_align) std::array<std::byte, checksum_len> shard_sum;
+
+			for (size_t ix = 0; ix <= shard_mask_; ++ix) {
+				{
+					std::lock_guard lock{shards_[ix].mutex};
+					shard_sum = shards_[ix].sum;
+				}
+				MathEngine::add(std::span<std::byte, checksum_len>{sum}, std::span<std::byte const, checksum_len>{shard_sum});
+			}
+
+			return sum;
+		}
+
+		/**
+		 * @return an LtHash with the key and current checksum of *this
+		 * @throws std::system_error if a shard cannot be locked
+		 */
+		[[nodiscard]] lthash_type snapshot() const {
+			auto const sum = checksum();
+			lthash_type ret{sum};
+			ret.set_key(key_.get());
+			return ret;
+		}
+
+		/**
+		 * @brief Clears the checksum
+		 */
+		void clear() noexcept {
+			for (size_t ix = 0; ix <= shard_mask_; ++ix) {
+				shards_[ix].sum.fill(std::byte{0}); // not called concurrently, no synchronization needed
+			}
+		}
+	};
+
+} // namespace dice::hash::lthash
+
+#endif//DICE_HASH_CONCURRENTLTHASH_HPP
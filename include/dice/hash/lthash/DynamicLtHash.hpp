@@ -0,0 +1,488 @@
+#ifndef DICE_HASH_DYNAMICLTHASH_HPP
+#define DICE_HASH_DYNAMICLTHASH_HPP
+
+#include "dice/hash/lthash/LtHash.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace dice::hash::lthash {
+
+	/**
+	 * @brief LtHash whose element width and element count are chosen at runtime.
+	 * 		The checksum lives in a heap buffer obtained from Allocator (e.g. a metall allocator), so moves are O(1)
+	 * 		and differently sized instances share a single instantiation.
+	 * 		Objects are hashed in pieces of object_hash_piece_len bytes on the stack if HashT provides an output_reader (like Blake3),
+	 * 		otherwise into a thread local buffer.
+	 *
+	 * @note DynamicLtHash{bits, count} produces the same checksums as LtHash<bits, count> (with the same HashT and key)
+	 * @note a moved-from DynamicLtHash has element_count() == 0 and an empty checksum, it may only be assigned to or destroyed
+	 * @tparam HashT the hash function used to hash objects, instantiated with dynamic output extent
+	 * @tparam MathEngineT the math engine/instruction set to use for computations
+	 * @tparam Allocator allocator used for the checksum buffer, rebound to uint64_t
+	 */
+	template<template<size_t> typename HashT = blake3::Blake3, template<typename> typename MathEngineT = DefaultMathEngine, typename Allocator = std::allocator<std::byte>>
+	struct DynamicLtHash {
+		using allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<uint64_t>;
+
+	private:
+		using alloc_traits = std::allocator_traits<allocator_type>;
+		using pointer = typename alloc_traits::pointer;
+		using Hash = HashT<std::dynamic_extent>;
+
+		static_assert(MathEngine<MathEngineT, detail::Bits<16>> && MathEngine<MathEngineT, detail::Bits<20>> && MathEngine<MathEngineT, detail::Bits<32>>);
+
+		/**
+		 * @brief true if the hash of an object can be produced piece by piece, i.e. without a buffer of checksum_len() bytes
+		 */
+		static constexpr bool streams_object_hashes = requires (Hash const &hash) {
+			hash.output_reader();
+		};
+
+		/**
+		 * @brief number of bytes of an object hash that are computed and applied at a time (if streams_object_hashes)
+		 */
+		static constexpr size_t object_hash_piece_len = 1024;
+
+		using Piece = std::array<uint64_t, object_hash_piece_len / sizeof(uint64_t)>;
+
+		[[no_unique_address]] allocator_type alloc_;
+		pointer words_ = nullptr;
+		size_t element_bits_;
+		size_t element_count_;
+		detail::Key<Hash::min_key_extent, Hash::max_key_extent> key_;
+
+		/**
+		 * @brief calls f with detail::Bits<element_bits_>
+		 */
+		template<typename F>
+		decltype(auto) visit_bits(F &&f) const {
+			switch (element_bits_) {
+				case 16:
+					return std::forward<F>(f)(detail::Bits<16>{});
+				case 20:
+					return std::forward<F>(f)(detail::Bits<20>{});
+				default:
+					assert(element_bits_ == 32);
+					return std::forward<F>(f)(detail::Bits<32>{});
+			}
+		}
+
+		static size_t elements_per_uint64(size_t element_bits) noexcept {
+			return element_bits == 20 ? (sizeof(uint64_t) * 8) / (element_bits + 1)
+									  : (sizeof(uint64_t) * 8) / element_bits;
+		}
+
+		static void validate(size_t element_bits, size_t element_count) {
+			if ((element_bits != 16 || element_count % 32 != 0)
+				&& (element_bits != 20 || element_count % 24 != 0)
+				&& (element_bits != 32 || element_count % 16 != 0)) [[unlikely]] {
+				throw std::invalid_argument{"Invalid LtHash dimensions: element_bits must be 16, 20 or 32 and element_count a multiple of 32, 24 or 16 respectively"};
+			}
+
+			if (element_count == 0) [[unlikely]] {
+				throw std::invalid_argument{"Invalid LtHash dimensions: element_count must not be 0"};
+			}
+		}
+
+		[[nodiscard]] size_t n_words() const noexcept {
+			return element_count_ / elements_per_uint64(element_bits_);
+		}
+
+		[[nodiscard]] std::span<uint64_t> words() noexcept {
+			return {std::to_address(words_), n_words()};
+		}
+
+		[[nodiscard]] std::span<uint64_t const> words() const noexcept {
+			return {std::to_address(words_), n_words()};
+		}
+
+		[[nodiscard]] std::span<std::byte> checksum_mut() noexcept {
+			return std::as_writable_bytes(words());
+		}
+
+		/**
+		 * @brief allocates and zeroes a checksum of n_words words from alloc
+		 */
+		[[nodiscard]] static pointer allocate(allocator_type &alloc, size_t n_words) {
+			auto const words = alloc_traits::allocate(alloc, n_words);
+			std::uninitialized_fill_n(std::to_address(words), n_words, uint64_t{0});
+			return words;
+		}
+
+		void deallocate() noexcept {
+			if (words_ != nullptr) {
+				alloc_traits::deallocate(alloc_, words_, n_words());
+				words_ = nullptr;
+			}
+		}
+
+		/**
+		 * @brief hashes obj and calls f(checksum_part, hash_part) for consecutive parts of the checksum and the corresponding parts of the object hash
+		 */
+		template<typename F>
+		void apply_object_hash(std::span<std::byte const> obj, F &&f) noexcept(streams_object_hashes) {
+			auto const clear_padding = [this](std::span<std::byte> hash_part) noexcept {
+				visit_bits([&]<typename Bits>(Bits) {
+					if constexpr (Bits::needs_padding) {
+						MathEngineT<Bits>::clear_padding_bits(hash_part);
+					}
+				});
+			};
+
+			auto const checksum = checksum_mut();
+
+			if constexpr (streams_object_hashes) {
+				Hash hash{key_.get()};
+				hash.digest(obj);
+				auto reader = hash.output_reader();
+
+				Piece piece;
+				for (size_t offset = 0; offset < checksum.size(); offset += object_hash_piece_len) {
+					auto const len = std::min(object_hash_piece_len, checksum.size() - offset);
+					auto const hash_part = std::as_writable_bytes(std::span{piece}).first(len);
+					reader.fill(hash_part);
+					clear_padding(hash_part);
+					f(checksum.subspan(offset, len), std::span<std::byte const>{hash_part});
+				}
+			} else {
+				static thread_local std::vector<uint64_t> buffer;
+				buffer.resize(std::max(buffer.size(), n_words()));
+
+				auto const hash_part = std::as_writable_bytes(std::span{buffer.data(), n_words()});
+				Hash::hash_single(obj, hash_part, key_.get());
+				clear_padding(hash_part);
+				f(checksum, std::span<std::byte const>{hash_part});
+			}
+		}
+
+		void check_compatible(DynamicLtHash const &other) const {
+			if (element_bits_ != other.element_bits_ || element_count_ != other.element_count_) [[unlikely]] {
+				throw std::invalid_argument{"Cannot combine hashes with different dimensions"};
+			}
+
+			if (!key_equal(other)) [[unlikely]] {
+				throw std::invalid_argument{"Cannot combine hashes with different keys"};
+			}
+		}
+
+	public:
+		/**
+		 * @brief construct an empty DynamicLtHash with the given dimensions
+		 * @throws std::invalid_argument if the dimensions are not supported (see LtHash)
+		 */
+		DynamicLtHash(size_t element_bits, size_t element_count, Allocator const &alloc = Allocator{})
+			: alloc_{alloc}, element_bits_{element_bits}, element_count_{element_count} {
+			validate(element_bits, element_count);
+			words_ = allocate(alloc_, n_words());
+		}
+
+		/**
+		 * @brief construct a DynamicLtHash with the given dimensions and initial_checksum
+		 * @throws std::invalid_argument if the dimensions are not supported or the checksum does not fit them
+		 */
+		DynamicLtHash(size_t element_bits, size_t element_count, std::span<std::byte const> initial_checksum, Allocator const &alloc = Allocator{})
+			: DynamicLtHash{element_bits, element_count, alloc} {
+			set_checksum(initial_checksum);
+		}
+
+		DynamicLtHash(DynamicLtHash const &other)
+			: alloc_{alloc_traits::select_on_container_copy_construction(other.alloc_)},
+			  element_bits_{other.element_bits_},
+			  element_count_{other.element_count_},
+			  key_{other.key_} {
+			words_ = allocate(alloc_, n_words());
+			std::ranges::copy(other.words(), words().begin());
+		}
+
+		DynamicLtHash(DynamicLtHash &&other) noexcept
+			: alloc_{std::move(other.alloc_)},
+			  words_{std::exchange(other.words_, nullptr)},
+			  element_bits_{other.element_bits_},
+			  element_count_{std::exchange(other.element_count_, 0)},
+			  key_{other.key_} {
+			other.clear_key();
+		}
+
+		DynamicLtHash &operator=(DynamicLtHash const &other) {
+			if (this == &other) [[unlikely]] {
+				return *this;
+			}
+
+			bool const propagate_alloc = alloc_traits::propagate_on_container_copy_assignment::value && alloc_ != other.alloc_;
+			if (propagate_alloc || words_ == nullptr || n_words() != other.n_words()) {
+				// allocate the new buffer before releasing the old one, so that *this is unchanged if allocation throws
+				auto new_alloc = propagate_alloc ? other.alloc_ : alloc_;
+				auto const new_words = allocate(new_alloc, other.n_words());
+
+				deallocate();
+				if (propagate_alloc) {
+					alloc_ = std::move(new_alloc);
+				}
+				words_ = new_words;
+			}
+
+			element_bits_ = other.element_bits_;
+			element_count_ = other.element_count_;
+			std::ranges::copy(other.words(), words().begin());
+
+			clear_key();
+			key_ = other.key_;
+			return *this;
+		}
+
+		DynamicLtHash &operator=(DynamicLtHash &&other) noexcept(alloc_traits::propagate_on_container_move_assignment::value
+																 || alloc_traits::is_always_equal::value) {
+			assert(this != &other);
+
+			if constexpr (alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value) {
+				deallocate();
+				if constexpr (alloc_traits::propagate_on_container_move_assignment::value) {
+					alloc_ = std::move(other.alloc_);
+				}
+				words_ = std::exchange(other.words_, nullptr);
+				element_bits_ = other.element_bits_;
+				element_count_ = std::exchange(other.element_count_, 0);
+			} else {
+				if (alloc_ == other.alloc_) {
+					deallocate();
+					words_ = std::exchange(other.words_, nullptr);
+					element_bits_ = other.element_bits_;
+					element_count_ = std::exchange(other.element_count_, 0);
+				} else {
+					*this = static_cast<DynamicLtHash const &>(other); // cannot steal memory from a different allocator
+				}
+			}
+
+			clear_key();
+			key_ = other.key_;
+			other.clear_key();
+			return *this;
+		}
+
+		~DynamicLtHash() noexcept {
+			clear_key();
+			deallocate();
+		}
+
+		[[nodiscard]] allocator_type get_allocator() const noexcept {
+			return alloc_;
+		}
+
+		[[nodiscard]] size_t element_bits() const noexcept {
+			return element_bits_;
+		}
+
+		[[nodiscard]] size_t element_count() const noexcept {
+			return element_count_;
+		}
+
+		[[nodiscard]] bool needs_padding() const noexcept {
+			return element_bits_ == 20;
+		}
+
+		[[nodiscard]] size_t checksum_len() const noexcept {
+			return n_words() * sizeof(uint64_t);
+		}
+
+		/**
+		 * @brief Checks if the internal key is equal to the given key
+		 * @note this function is not secured against timing attacks
+		 */
+		[[nodiscard]] bool key_equal(std::span<std::byte const> other_key) const noexcept {
+			auto const this_key = key_.get();
+			return std::equal(this_key.begin(), this_key.end(), other_key.begin(), other_key.end());
+		}
+
+		/**
+		 * @brief Checks if *this and other have the same key
+		 * @note this functions is not secured against timing attacks
+		 */
+		[[nodiscard]] bool key_equal(DynamicLtHash const &other) const noexcept {
+			return key_equal(other.key_.get());
+		}
+
+		/**
+		 * @brief Sets the internal key for the hash function to the given key; securely erases the old key
+		 * @throws std::invalid_argument if key.size() is not in Hash::min_key_extent..Hash::max_key_extent (inclusive); only if supplied_key_len == std::dynamic_extent
+		 */
+		template<size_t supplied_key_len>
+			requires (supplied_key_len == std::dynamic_extent || (supplied_key_len >= Hash::min_key_extent
+																 && supplied_key_len <= Hash::max_key_extent))
+		void set_key(std::span<std::byte const, supplied_key_len> key) noexcept(supplied_key_len != std::dynamic_extent) {
+			if constexpr (supplied_key_len == std::dynamic_extent) {
+				if (key.size() < Hash::min_key_extent || key.size() > Hash::max_key_extent) [[unlikely]] {
+					throw std::invalid_argument{"Invalid key size"};
+				}
+			}
+
+			key_.set_unchecked(key);
+		}
+
+		/**
+		 * @brief Clears the internal key by securely erasing it
+		 */
+		void clear_key() noexcept {
+			key_.clear();
+		}
+
+		[[nodiscard]] std::span<std::byte const> checksum() const noexcept {
+			return std::as_bytes(words());
+		}
+
+		/**
+		 * @brief Checks if this->checksum() is equal to other_checksum (i.e. represent the same multiset)
+		 * @note this function is _not_ secured against timing attacks
+		 */
+		[[nodiscard]] bool checksum_equal(std::span<std::byte const> other_checksum) const noexcept {
+			return std::ranges::equal(checksum(), other_checksum);
+		}
+
+		/**
+		 * @brief Checks if *this and other have the same checksum (i.e. represent the same multiset)
+		 * @note this function is _not_ secured against timing attacks
+		 */
+		[[nodiscard]] bool checksum_equal(DynamicLtHash const &other) const noexcept {
+			return checksum_equal(other.checksum());
+		}
+
+		/**
+		 * @brief Checks if this->checksum() is equal to other_checksum (i.e. represent the same multiset)
+		 * @note this function is secured against timing attacks (but not against leaking the checksum length)
+		 */
+		[[nodiscard]] bool checksum_equal_constant_time(std::span<std::byte const> other_checksum) const noexcept {
+			auto const this_checksum = checksum();
+			return this_checksum.size() == other_checksum.size()
+				   && sodium_memcmp(this_checksum.data(), other_checksum.data(), this_checksum.size()) == 0;
+		}
+
+		/**
+		 * @brief Checks if *this and other have the same checksum (i.e. represent the same multiset)
+		 * @note this function is secured against timing attacks (but not against leaking the checksum length)
+		 */
+		[[nodiscard]] bool checksum_equal_constant_time(DynamicLtHash const &other) const noexcept {
+			return checksum_equal_constant_time(other.checksum());
+		}
+
+		/**
+		 * @brief Explicitly sets the current checksum to the given one
+		 * @throws std::invalid_argument if new_checksum.size() != checksum_len() or new_checksum has invalid padding
+		 */
+		void set_checksum(std::span<std::byte const> new_checksum) {
+			if (new_checksum.size() != checksum_len()) [[unlikely]] {
+				throw std::invalid_argument{"Invalid checksum: wrong length"};
+			}
+
+			auto const valid = visit_bits([&]<typename Bits>(Bits) {
+				if constexpr (Bits::needs_padding) {
+					// check piecewise on an aligned copy to not require alignment from the caller
+					Piece piece;
+					for (size_t offset = 0; offset < new_checksum.size(); offset += object_hash_piece_len) {
+						auto const part = new_checksum.subspan(offset, std::min(object_hash_piece_len, new_checksum.size() - offset));
+						auto const aligned = std::as_writable_bytes(std::span{piece}).first(part.size());
+						std::ranges::copy(part, aligned.begin());
+						if (!MathEngineT<Bits>::check_padding_bits(std::span<std::byte const>{aligned})) {
+							return false;
+						}
+					}
+					return true;
+				} else {
+					return true;
+				}
+			});
+
+			if (!valid) [[unlikely]] {
+				throw std::invalid_argument{"Invalid checksum: found non-zero padding bits"};
+			}
+
+			std::ranges::copy(new_checksum, checksum_mut().begin());
+		}
+
+		/**
+		 * @brief Clears the current checksum
+		 */
+		void clear_checksum() noexcept {
+			std::ranges::fill(words(), uint64_t{0});
+		}
+
+		/**
+		 * @brief Adds another DynamicLtHash to *this (via multiset-union)
+		 * @param other another DynamicLtHash instance with the same dimensions and key as *this
+		 * @return reference to *this
+		 * @throws std::invalid_argument if the dimensions or keys differ
+		 */
+		DynamicLtHash &combine_add(DynamicLtHash const &other) {
+			check_compatible(other);
+			visit_bits([&]<typename Bits>(Bits) {
+				MathEngineT<Bits>::add(checksum_mut(), other.checksum());
+			});
+			return *this;
+		}
+
+		/**
+		 * @brief Removes another DynamicLtHash from *this (via multiset-minus)
+		 * @param other another DynamicLtHash instance with the same dimensions and key as *this
+		 * @return reference to *this
+		 * @throws std::invalid_argument if the dimensions or keys differ
+		 */
+		DynamicLtHash &combine_remove(DynamicLtHash const &other) {
+			check_compatible(other);
+			visit_bits([&]<typename Bits>(Bits) {
+				MathEngineT<Bits>::sub(checksum_mut(), other.checksum());
+			});
+			return *this;
+		}
+
+		/**
+		 * @brief Adds a single object to this DynamicLtHash instance
+		 * @param obj object to add
+		 * @return reference to *this
+		 * @throws std::bad_alloc if HashT cannot stream its output and the thread local buffer cannot grow to checksum_len()
+		 */
+		DynamicLtHash &add(std::span<std::byte const> obj) noexcept(streams_object_hashes) {
+			apply_object_hash(obj, [&](std::span<std::byte> checksum_part, std::span<std::byte const> hash_part) {
+				visit_bits([&]<typename Bits>(Bits) {
+					MathEngineT<Bits>::add(checksum_part, hash_part);
+				});
+			});
+			return *this;
+		}
+
+		/**
+		 * @brief Removes a single object from this DynamicLtHash instance
+		 * @param obj object to remove
+		 * @return reference to *this
+		 * @throws std::bad_alloc if HashT cannot stream its output and the thread local buffer cannot grow to checksum_len()
+		 */
+		DynamicLtHash &remove(std::span<std::byte const> obj) noexcept(streams_object_hashes) {
+			apply_object_hash(obj, [&](std::span<std::byte> checksum_part, std::span<std::byte const> hash_part) {
+				visit_bits([&]<typename Bits>(Bits) {
+					MathEngineT<Bits>::sub(checksum_part, hash_part);
+				});
+			});
+			return *this;
+		}
+
+		/**
+		 * @brief Checks if *this and other have the same dimensions and checksum (i.e. represent the same multiset)
+		 * @note this function is _not_ secured against timing attacks
+		 */
+		bool operator==(DynamicLtHash const &other) const noexcept {
+			return element_bits_ == other.element_bits_ && checksum_equal(other);
+		}
+
+		bool operator!=(DynamicLtHash const &other) const noexcept {
+			return !DynamicLtHash::operator==(other);
+		}
+	};
+
+} // namespace dice::hash::lthash
+
+#endif//DICE_HASH_DYNAMICLTHASH_HPP
@@ -0,0 +1,116 @@
+#ifndef DICE_HASH_HUGEPAGEALLOCATOR_HPP
+#define DICE_HASH_HUGEPAGEALLOCATOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <type_traits>
+
+#if __has_include(<sys/mman.h>)
+#include <sys/mman.h>
+#endif
+
+namespace dice::hash::lthash {
+
+	/**
+	 * @brief Stateless allocator for large, long-lived arrays (e.g. LtHashArray).
+	 * 		Allocations of at least huge_page_size bytes are served directly by mmap, rounded up to whole huge pages and aligned to huge_page_size,
+	 * 		and the kernel is asked to back them with transparent huge pages (this reduces TLB misses when walking large arrays).
+	 * 		Smaller allocations are served by aligned operator new.
+	 *
+	 * @note all allocations are aligned to at least cache_line_size bytes and zero initialized if mmap is used
+	 */
+	template<typename T>
+	struct HugePageAllocator {
+		using value_type = T;
+		using is_always_equal = std::true_type;
+
+		static constexpr size_t huge_page_size = size_t{2} << 20;
+		static constexpr size_t cache_line_size = 64;
+
+	private:
+		static constexpr std::align_val_t alignment{alignof(T) > cache_line_size ? alignof(T) : cache_line_size};
+
+		static constexpr size_t mapping_size(size_t bytes) noexcept {
+			return (bytes + huge_page_size - 1) / huge_page_size * huge_page_size;
+		}
+
+		static constexpr bool use_mmap([[maybe_unused]] size_t bytes) noexcept {
+#if __has_include(<sys/mman.h>)
+			return bytes >= huge_page_size;
+#else
+			return false;
+#endif
+		}
+
+	public:
+		constexpr HugePageAllocator() noexcept = default;
+
+		template<typename U>
+		constexpr HugePageAllocator(HugePageAllocator<U> const &) noexcept {
+		}
+
+		[[nodiscard]] T *allocate(size_t n) {
+			if (n > std::numeric_limits<size_t>::max() / sizeof(T)) [[unlikely]] {
+				throw std::bad_array_new_length{};
+			}
+
+			auto const bytes = n * sizeof(T);
+
+#if __has_include(<sys/mman.h>)
+			if (use_mmap(bytes)) {
+				auto const size = mapping_size(bytes);
+				if (size > std::numeric_limits<size_t>::max() - huge_page_size) [[unlikely]] {
+					throw std::bad_alloc{};
+				}
+
+				// mmap only guarantees page alignment, but the kernel can only back huge page aligned ranges with huge pages.
+				// Therefore, map one huge page more than needed and unmap the unaligned head and the tail.
+				void *raw = ::mmap(nullptr, size + huge_page_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+				if (raw == MAP_FAILED) [[unlikely]] {
+					throw std::bad_alloc{};
+				}
+
+				auto *const raw_begin = static_cast<std::byte *>(raw);
+				auto const head = (huge_page_size - reinterpret_cast<uintptr_t>(raw_begin) % huge_page_size) % huge_page_size;
+				auto *const ptr = raw_begin + head;
+				if (head != 0) {
+					::munmap(raw_begin, head);
+				}
+				if (auto const tail = huge_page_size - head; tail != 0) {
+					::munmap(ptr + size, tail);
+				}
+
+#ifdef MADV_HUGEPAGE
+				::madvise(ptr, size, MADV_HUGEPAGE); // only a hint, failure is irrelevant
+#endif
+				return reinterpret_cast<T *>(ptr);
+			}
+#endif
+
+			return static_cast<T *>(::operator new(bytes, alignment));
+		}
+
+		void deallocate(T *ptr, size_t n) noexcept {
+			auto const bytes = n * sizeof(T);
+
+#if __has_include(<sys/mman.h>)
+			if (use_mmap(bytes)) {
+				::munmap(ptr, mapping_size(bytes));
+				return;
+			}
+#endif
+
+			::operator delete(ptr, alignment);
+		}
+
+		template<typename U>
+		constexpr bool operator==(HugePageAllocator<U> const &) const noexcept {
+			return true;
+		}
+	};
+
+} // namespace dice::hash::lthash
+
+#endif//DICE_HASH_HUGEPAGEALLOCATOR_HPP
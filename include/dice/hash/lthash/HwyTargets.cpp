@@ -0,0 +1,119 @@
+#include "HwyTargets.hpp"
+
+#include <hwy/highway.h>
+#include <hwy/targets.h>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cctype>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+
+namespace dice::hash::lthash::hwy_targets {
+	namespace {
+		std::atomic<int64_t> disabled_targets{0};
+
+		/**
+		 * @return the individual target bits of targets, lower bits (i.e. better targets) first
+		 */
+		std::vector<int64_t> split_targets(int64_t targets) {
+			std::vector<int64_t> ret;
+			for (; targets != 0; targets &= targets - 1) {
+				ret.push_back(targets & ~(targets - 1));
+			}
+			return ret;
+		}
+
+		int64_t available_targets() noexcept {
+			return hwy::SupportedTargets() & HWY_TARGETS;
+		}
+	} // namespace
+
+	int64_t active_target() noexcept {
+		auto const targets = available_targets();
+		if (targets == 0) [[unlikely]] {
+			return HWY_STATIC_TARGET;
+		}
+		return targets & ~(targets - 1); // dynamic dispatch always picks the best available target
+	}
+
+	std::vector<int64_t> compiled_targets() {
+		return split_targets(HWY_TARGETS);
+	}
+
+	std::vector<int64_t> supported_targets() {
+		return split_targets(available_targets());
+	}
+
+	std::string_view target_name(int64_t target) noexcept {
+		return hwy::TargetName(target);
+	}
+
+	int64_t target_by_name(std::string_view name) noexcept {
+		auto const iequal = [](char a, char b) {
+			return std::tolower(static_cast<unsigned char>(a)) == std::tolower(static_cast<unsigned char>(b));
+		};
+
+		for (int64_t targets = HWY_TARGETS; targets != 0; targets &= targets - 1) {
+			auto const target = targets & ~(targets - 1);
+			if (std::ranges::equal(target_name(target), name, iequal)) {
+				return target;
+			}
+		}
+		return 0;
+	}
+
+	void force_target(int64_t target) {
+		if (std::popcount(static_cast<uint64_t>(target)) != 1 || (target & HWY_TARGETS) == 0) [[unlikely]] {
+			throw std::invalid_argument{"Highway target was not compiled"};
+		}
+
+		hwy::SetSupportedTargetsForTest(0); // undo any previous force to get the targets supported by the CPU
+		if ((hwy::SupportedTargets() & target) == 0) [[unlikely]] {
+			throw std::invalid_argument{"Highway target " + std::string{target_name(target)} + " is not supported by the CPU or disabled"};
+		}
+
+		hwy::SetSupportedTargetsForTest(target);
+	}
+
+	void disable_targets(int64_t targets) {
+		hwy::DisableTargets(disabled_targets.fetch_or(targets) | targets);
+	}
+
+	void reset_targets() {
+		disabled_targets.store(0);
+		hwy::SetSupportedTargetsForTest(0);
+		hwy::DisableTargets(0);
+	}
+
+	bool apply_env_target() {
+		char const *value = std::getenv(env_var);
+		if (value == nullptr || *value == '\0') {
+			return false;
+		}
+
+		auto const target = target_by_name(value);
+		if (target == 0) [[unlikely]] {
+			throw std::invalid_argument{std::string{"Unknown Highway target in "} + env_var + ": " + value};
+		}
+
+		force_target(target);
+		return true;
+	}
+
+	namespace detail {
+		bool apply_env_target_once() noexcept {
+			static bool const applied = []() noexcept {
+				try {
+					return apply_env_target();
+				} catch (...) {
+					return false;
+				}
+			}();
+			return applied;
+		}
+	} // namespace detail
+
+} // namespace dice::hash::lthash::hwy_targets
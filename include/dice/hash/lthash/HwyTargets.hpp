@@ -0,0 +1,83 @@
+#ifndef DICE_HASH_HWYTARGETS_HPP
+#define DICE_HASH_HWYTARGETS_HPP
+
+/** @file
+ * @brief Reporting and selection of the Highway target (instruction set) used by MathEngine_Hwy and MathEngine_HwyNative.
+ *
+ * Targets are identified by their Highway target bit (e.g. HWY_AVX2), names are the ones returned by hwy::TargetName (e.g. "AVX2").
+ * The target can also be pinned at startup by setting the environment variable DICE_HASH_HWY_TARGET to a target name.
+ *
+ * @note the selection is process wide, it also affects any other code in the process that uses Highway dynamic dispatch
+ */
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace dice::hash::lthash::hwy_targets {
+
+	/**
+	 * @brief name of the environment variable that is used to pin a target at startup
+	 */
+	inline constexpr char env_var[] = "DICE_HASH_HWY_TARGET";
+
+	/**
+	 * @return the target that is currently used for dynamic dispatch
+	 */
+	[[nodiscard]] int64_t active_target() noexcept;
+
+	/**
+	 * @return all targets this library was compiled for, best first
+	 */
+	[[nodiscard]] std::vector<int64_t> compiled_targets();
+
+	/**
+	 * @return all targets this library was compiled for that are supported by the CPU and not disabled, best first
+	 */
+	[[nodiscard]] std::vector<int64_t> supported_targets();
+
+	/**
+	 * @return the name of target (e.g. "AVX2")
+	 */
+	[[nodiscard]] std::string_view target_name(int64_t target) noexcept;
+
+	/**
+	 * @return the target with the given name (case insensitive) or 0 if there is no compiled target with this name
+	 */
+	[[nodiscard]] int64_t target_by_name(std::string_view name) noexcept;
+
+	/**
+	 * @brief Uses exactly target for all following calls
+	 * @throws std::invalid_argument if target was not compiled or is not supported by the CPU
+	 */
+	void force_target(int64_t target);
+
+	/**
+	 * @brief Excludes the given targets (bitwise or of target bits) from dispatch.
+	 * 		The baseline target (the one the library was compiled for without dynamic dispatch) cannot be disabled.
+	 */
+	void disable_targets(int64_t targets);
+
+	/**
+	 * @brief Undoes force_target and disable_targets, i.e. the best target supported by the CPU is used again
+	 */
+	void reset_targets();
+
+	/**
+	 * @brief Forces the target named by the environment variable DICE_HASH_HWY_TARGET (if it is set).
+	 * 		This is done automatically on startup (ignoring invalid values), call it again if the environment variable was changed.
+	 * @return true if a target was forced
+	 * @throws std::invalid_argument if the environment variable names an unknown or unsupported target
+	 */
+	bool apply_env_target();
+
+	namespace detail {
+		/**
+		 * @brief Calls apply_env_target() the first time it is called, ignoring errors
+		 */
+		bool apply_env_target_once() noexcept;
+	} // namespace detail
+
+} // namespace dice::hash::lthash::hwy_targets
+
+#endif//DICE_HASH_HWYTARGETS_HPP
@@ -14,13 +14,17 @@
 #if __has_include(<sodium.h>)
 
 #include <array>
+#include <cstdint>
 #include <cstring>
+#include <string_view>
+#include <type_traits>
 #include <vector>
 #include <utility>
 #include <memory>
 
 #include <sodium.h>
 
+#include "dice/hash/DiceHash.hpp"
 #include "dice/hash/blake/Blake3.hpp"
 #include "dice/hash/lthash/MathEngine.hpp"
 
@@ -105,6 +109,15 @@ namespace dice::hash::lthash {
 		};
 	} // namespace detail
 
+	template<typename LtHashT>
+	struct LtHashAccumulator;
+
+	template<typename LtHashT>
+	struct SeqLockLtHash;
+
+	template<typename LtHashT>
+	struct LtHashDelta;
+
 	/**
 	 * @brief LtHash ported from folly::experimental::crypto
 	 * @tparam n_bits_per_elem how many bits the individual state elements occupy
@@ -123,6 +136,15 @@ namespace dice::hash::lthash {
 		template<size_t, size_t, template<size_t> typename, template<typename> typename>
 		friend struct LtHash;
 
+		template<typename>
+		friend struct LtHashAccumulator;
+
+		template<typename>
+		friend struct SeqLockLtHash;
+
+		template<typename>
+		friend struct LtHashDelta;
+
 		using Bits = detail::Bits<n_bits_per_elem>;
 		using MathEngine = MathEngineT<Bits>;
 
@@ -140,13 +162,22 @@ namespace dice::hash::lthash {
 
 		static constexpr std::array<std::byte, checksum_len> default_checksum{};
 
+		/**
+		 * @brief length of the fingerprint produced by digest()
+		 */
+		static constexpr size_t digest_len = 32;
+
+		/**
+		 * @brief BLAKE3 key derivation context used by digest()
+		 */
+		static constexpr std::string_view digest_context = "dice-hash LtHash digest v1";
+
 	private:
 		using Hash = HashT<checksum_len>;
 
 		detail::Key<Hash::min_key_extent, Hash::max_key_extent> key_;
 		alignas(checksum_align) std::array<std::byte, checksum_len> checksum_;
 
-
 		constexpr void set_checksum_unchecked(std::span<std::byte const, checksum_len> new_checksum) noexcept {
 			std::copy(new_checksum.begin(), new_checksum.end(), checksum_.begin());
 		}
@@ -171,7 +202,9 @@ namespace dice::hash::lthash {
 			set_checksum_unchecked(initial_checksum);
 		}
 
-		constexpr LtHash(LtHash const &other) noexcept = default;
+		constexpr LtHash(LtHash const &other) noexcept : key_{other.key_},
+														 checksum_{other.checksum_} {
+		}
 
 		template<template<typename> typename MathEngineT2>
 		constexpr LtHash(LtHash<n_bits_per_elem, n_elems, HashT, MathEngineT2> const &other) noexcept : key_{other.key_},
@@ -265,6 +298,11 @@ namespace dice::hash::lthash {
 		 * @note this function is _not_ secured against timing attacks
 		 */
 		[[nodiscard]] constexpr bool checksum_equal(std::span<std::byte const, checksum_len> other_checksum) const noexcept {
+			if constexpr (ComparingMathEngine<MathEngine>) {
+				if (!std::is_constant_evaluated() && reinterpret_cast<uintptr_t>(other_checksum.data()) % checksum_align == 0) {
+					return MathEngine::equal(checksum(), other_checksum);
+				}
+			}
 			return std::equal(checksum_.begin(), checksum_.end(), other_checksum.begin());
 		}
 
@@ -281,7 +319,12 @@ namespace dice::hash::lthash {
 		 * @note this function is secured against timing attacks
 		 */
 		[[nodiscard]] bool checksum_equal_constant_time(std::span<std::byte const, checksum_len> other_checksum) const noexcept {
-			return sodium_memcmp(checksum_, other_checksum.data(), checksum_len) == 0;
+			if constexpr (ComparingMathEngine<MathEngine>) {
+				if (reinterpret_cast<uintptr_t>(other_checksum.data()) % checksum_align == 0) {
+					return MathEngine::equal_constant_time(checksum(), other_checksum);
+				}
+			}
+			return sodium_memcmp(checksum_.data(), other_checksum.data(), checksum_len) == 0;
 		}
 
 		/**
@@ -292,6 +335,38 @@ namespace dice::hash::lthash {
 			return checksum_equal_constant_time(other.checksum());
 		}
 
+		/**
+		 * @brief Condenses the checksum into a collision resistant digest_len byte fingerprint (BLAKE3 in key derivation mode over
+		 * 		the dimensions and the checksum), e.g. to index checksums or to compare them before exchanging the full checksum.
+		 * @note the fingerprint is computed on every call (it is not cached, so that a const LtHash can be shared between threads);
+		 * 		keep the result around if it is needed multiple times
+		 */
+		[[nodiscard]] std::array<std::byte, digest_len> digest() const noexcept {
+			// element_bits and element_count as little endian uint64_t
+			std::array<std::byte, 2 * sizeof(uint64_t)> dimensions;
+			for (size_t ix = 0; ix < sizeof(uint64_t); ++ix) {
+				dimensions[ix] = static_cast<std::byte>(uint64_t{element_bits} >> (8 * ix));
+				dimensions[sizeof(uint64_t) + ix] = static_cast<std::byte>(uint64_t{element_count} >> (8 * ix));
+			}
+
+			std::array<std::byte, digest_len> ret;
+			blake3::Blake3<digest_len> hasher{digest_context};
+			hasher.digest(dimensions);
+			hasher.digest(checksum());
+			std::move(hasher).finish(ret);
+			return ret;
+		}
+
+		/**
+		 * @brief Checks if *this and other have the same digest(), which (with overwhelming probability) means they have the same checksum
+		 * @note this function is _not_ secured against timing attacks
+		 */
+		[[nodiscard]] bool digest_equal(LtHash const &other) const noexcept {
+			auto const this_digest = digest();
+			auto const other_digest = other.digest();
+			return std::equal(this_digest.begin(), this_digest.end(), other_digest.begin());
+		}
+
 		/**
 		 * @brief Explicitly sets the current checksum to the given one
 		 * @throws std::invalid_argument if new_checksum has invalid padding; only if needs_padding
@@ -389,6 +464,19 @@ namespace dice::hash::lthash {
 
 } // namespace dice::hash::lthash
 
+namespace dice::hash {
+	/**
+	 * @brief (Seeded)DiceHash of an LtHash: the hash of its digest() with the policy of the hasher
+	 */
+	template<size_t n_bits_per_elem, size_t n_elems, template<size_t> typename HashT, template<typename> typename MathEngineT>
+	struct dice_hash_representation<lthash::LtHash<n_bits_per_elem, n_elems, HashT, MathEngineT>> {
+		static std::array<std::byte, lthash::LtHash<n_bits_per_elem, n_elems, HashT, MathEngineT>::digest_len>
+		represent(lthash::LtHash<n_bits_per_elem, n_elems, HashT, MathEngineT> const &h) noexcept {
+			return h.digest();
+		}
+	};
+} // namespace dice::hash
+
 #else
 #error "Cannot include LtHash.hpp if sodium is not available"
 #endif
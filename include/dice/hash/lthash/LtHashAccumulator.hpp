@@ -0,0 +1,222 @@
+#ifndef DICE_HASH_LTHASHACCUMULATOR_HPP
+#define DICE_HASH_LTHASHACCUMULATOR_HPP
+
+#include "dice/hash/lthash/LtHash.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+
+namespace dice::hash::lthash {
+
+	namespace detail {
+		/**
+		 * @brief Splits the elements packed into a uint64_t into two groups (even and odd elements)
+		 * 		such that each element of one group has enough free bits above it to absorb the carries of many additions.
+		 *
+		 * Summing the even elements (masked) and the whole words separately, the sum of the odd elements is
+		 * recovered as (sum of words) - (sum of even elements). Both sums only need plain 64-bit additions.
+		 */
+		template<size_t n_bits_per_elem>
+		struct LazyCarryMasks;
+
+		template<>
+		struct LazyCarryMasks<16> {
+			// elements 0 and 2 can carry into elements 1 and 3 (16 bits each) => 2^16 additions
+			static constexpr uint64_t even = 0x0000ffff0000ffffULL;
+			static constexpr uint64_t odd = ~even;
+			static constexpr size_t max_pending = size_t{1} << 16;
+		};
+
+		template<>
+		struct LazyCarryMasks<20> {
+			// element 0 can carry into padding bit + element 1 + padding bit (22 bits) => 2^22 additions, element 2 carries out of the word
+			static constexpr uint64_t even = 0x3FFFFC00000FFFFFULL;
+			static constexpr uint64_t odd = 0x000001FFFFE00000ULL;
+			static constexpr size_t max_pending = size_t{1} << 22;
+		};
+
+		template<>
+		struct LazyCarryMasks<32> {
+			// element 0 can carry into element 1 (32 bits) => 2^32 additions
+			static constexpr uint64_t even = 0x00000000ffffffffULL;
+			static constexpr uint64_t odd = ~even;
+			static constexpr size_t max_pending = static_cast<size_t>(std::min<uint64_t>(uint64_t{1} << 32, SIZE_MAX));
+		};
+
+		/**
+		 * @brief Sums of object hashes with deferred modular reduction
+		 */
+		template<size_t n_bits_per_elem, size_t n_words>
+		struct LazyCarrySum {
+			using Masks = LazyCarryMasks<n_bits_per_elem>;
+
+			std::array<uint64_t, n_words> even_sum_{}; ///< sum of (word & even)
+			std::array<uint64_t, n_words> full_sum_{}; ///< sum of word
+			size_t pending_ = 0;
+
+			void add(std::span<uint64_t const, n_words> words) noexcept {
+				for (size_t ix = 0; ix < n_words; ++ix) {
+					auto const w = little_endian(words[ix]);
+					even_sum_[ix] += w & Masks::even;
+					full_sum_[ix] += w;
+				}
+				++pending_;
+			}
+
+			[[nodiscard]] bool full() const noexcept {
+				return pending_ == Masks::max_pending;
+			}
+
+			/**
+			 * @brief Writes the element-wise sums (mod 2^n_bits_per_elem) in the regular little endian checksum format to out and resets *this
+			 */
+			void reduce(std::span<uint64_t, n_words> out) noexcept {
+				for (size_t ix = 0; ix < n_words; ++ix) {
+					auto const even = even_sum_[ix] & Masks::even;
+					auto const odd = (full_sum_[ix] - even_sum_[ix]) & Masks::odd;
+					out[ix] = little_endian(even | odd);
+				}
+
+				even_sum_.fill(0);
+				full_sum_.fill(0);
+				pending_ = 0;
+			}
+		};
+	} // namespace detail
+
+	/**
+	 * @brief Accumulates many object hashes into an LtHash without reducing every element modulo 2^element_bits on every add/remove.
+	 * 		The object hashes are summed using plain 64-bit additions, the reduction (and the application to the underlying LtHash)
+	 * 		only happens when flush(), checksum(), get() or finalize() is called or when an element could overflow.
+	 *
+	 * @note The resulting checksum is identical to calling add/remove on the underlying LtHash directly.
+	 * @note Uses 4 times the memory of the underlying LtHash, so it is meant for bulk loads and should not be kept around.
+	 * @tparam LtHashT the LtHash instantiation to accumulate into
+	 */
+	template<typename LtHashT>
+	struct LtHashAccumulator {
+		using lthash_type = LtHashT;
+
+		static constexpr size_t checksum_len = LtHashT::checksum_len;
+
+		/**
+		 * @brief the maximum number of adds (or removes) after which the pending sums are flushed automatically
+		 */
+		static constexpr size_t max_pending = detail::LazyCarryMasks<LtHashT::element_bits>::max_pending;
+
+	private:
+		static constexpr size_t n_words = checksum_len / sizeof(uint64_t);
+
+		using MathEngine = typename LtHashT::MathEngine;
+		using Sum = detail::LazyCarrySum<LtHashT::element_bits, n_words>;
+
+		LtHashT lthash_;
+		Sum added_;
+		Sum removed_;
+
+		void hash_object(std::span<uint64_t, n_words> out, std::span<std::byte const> obj) const noexcept {
+			lthash_.hash_object(std::as_writable_bytes(out), obj);
+		}
+
+		static void apply(Sum &sum, LtHashT &lthash, bool remove) noexcept {
+			if (sum.pending_ == 0) {
+				return;
+			}
+
+			alignas(LtHashT::checksum_align) std::array<uint64_t, n_words> reduced;
+			sum.reduce(reduced);
+
+			std::span<std::byte const, checksum_len> const bytes{reinterpret_cast<std::byte const *>(reduced.data()), checksum_len};
+			if (remove) {
+				MathEngine::sub(lthash.checksum_mut(), bytes);
+			} else {
+				MathEngine::add(lthash.checksum_mut(), bytes);
+			}
+		}
+
+	public:
+		/**
+		 * @brief Creates an accumulator on top of initial; the key of initial is used to hash the objects
+		 */
+		explicit LtHashAccumulator(LtHashT initial = LtHashT{}) noexcept : lthash_{std::move(initial)} {
+		}
+
+		/**
+		 * @brief Adds a single object
+		 * @param obj object to add
+		 * @return reference to *this
+		 */
+		LtHashAccumulator &add(std::span<std::byte const> obj) noexcept {
+			alignas(LtHashT::checksum_align) std::array<uint64_t, n_words> obj_hash;
+			hash_object(obj_hash, obj);
+			added_.add(obj_hash);
+
+			if (added_.full()) [[unlikely]] {
+				apply(added_, lthash_, false);
+			}
+			return *this;
+		}
+
+		/**
+		 * @brief Removes a single object
+		 * @param obj object to remove
+		 * @return reference to *this
+		 */
+		LtHashAccumulator &remove(std::span<std::byte const> obj) noexcept {
+			alignas(LtHashT::checksum_align) std::array<uint64_t, n_words> obj_hash;
+			hash_object(obj_hash, obj);
+			removed_.add(obj_hash);
+
+			if (removed_.full()) [[unlikely]] {
+				apply(removed_, lthash_, true);
+			}
+			return *this;
+		}
+
+		/**
+		 * @return number of adds and removes that were not yet applied to the underlying LtHash
+		 */
+		[[nodiscard]] size_t pending() const noexcept {
+			return added_.pending_ + removed_.pending_;
+		}
+
+		/**
+		 * @brief Applies all pending adds and removes to the underlying LtHash
+		 */
+		void flush() noexcept {
+			apply(added_, lthash_, false);
+			apply(removed_, lthash_, true);
+		}
+
+		/**
+		 * @brief Flushes and returns the checksum of the underlying LtHash
+		 */
+		[[nodiscard]] std::span<std::byte const, checksum_len> checksum() noexcept {
+			flush();
+			return lthash_.checksum();
+		}
+
+		/**
+		 * @brief Flushes and returns the underlying LtHash
+		 */
+		[[nodiscard]] LtHashT const &get() noexcept {
+			flush();
+			return lthash_;
+		}
+
+		/**
+		 * @brief Flushes and moves the underlying LtHash out of *this
+		 */
+		[[nodiscard]] LtHashT finalize() && noexcept {
+			flush();
+			return std::move(lthash_);
+		}
+	};
+
+} // namespace dice::hash::lthash
+
+#endif//DICE_HASH_LTHASHACCUMULATOR_HPP
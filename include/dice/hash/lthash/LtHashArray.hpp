@@ -0,0 +1,355 @@
+#ifndef DICE_HASH_LTHASHARRAY_HPP
+#define DICE_HASH_LTHASHARRAY_HPP
+
+#include "dice/hash/lthash/HugePageAllocator.hpp"
+#include "dice/hash/lthash/LtHash.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <utility>
+
+namespace dice::hash::lthash {
+
+	/**
+	 * @brief A fixed number of LtHash checksums ("rows") that share a single key.
+	 * 		The checksums are stored contiguously (each row aligned to a cache line) in a single allocation,
+	 * 		by default in huge page backed memory (see HugePageAllocator).
+	 *
+	 * Compared to std::vector<LtHash<...>> this saves the per-instance key (and its secure erasure on every move)
+	 * and makes operations across rows (combine_add, aggregate) cache friendly.
+	 *
+	 * @note every row produces the same checksum as an LtHash<n_bits_per_elem, n_elems, HashT, MathEngineT> with the same key
+	 * 		that saw the same operations
+	 */
+	template<size_t n_bits_per_elem, size_t n_elems, template<size_t> typename HashT = blake3::Blake3,
+			 template<typename> typename MathEngineT = DefaultMathEngine, typename Allocator = HugePageAllocator<std::byte>>
+	struct LtHashArray {
+		using lthash_type = LtHash<n_bits_per_elem, n_elems, HashT, MathEngineT>;
+		using allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<std::byte>;
+
+		static constexpr bool needs_padding = lthash_type::needs_padding;
+		static constexpr size_t element_bits = lthash_type::element_bits;
+		static constexpr size_t element_count = lthash_type::element_count;
+		static constexpr size_t checksum_len = lthash_type::checksum_len;
+
+		/**
+		 * @brief distance between two rows in bytes
+		 */
+		static constexpr size_t row_stride = (checksum_len + HugePageAllocator<std::byte>::cache_line_size - 1)
+											 / HugePageAllocator<std::byte>::cache_line_size * HugePageAllocator<std::byte>::cache_line_size;
+
+	private:
+		using alloc_traits = std::allocator_traits<allocator_type>;
+		using pointer = typename alloc_traits::pointer;
+		using Bits = detail::Bits<n_bits_per_elem>;
+		using MathEngine = MathEngineT<Bits>;
+		using Hash = HashT<checksum_len>;
+
+		static constexpr size_t prefetch_bytes = 512;
+
+		[[no_unique_address]] allocator_type alloc_;
+		pointer data_ = nullptr;
+		size_t size_ = 0;
+		detail::Key<Hash::min_key_extent, Hash::max_key_extent> key_;
+
+		[[nodiscard]] std::span<std::byte, checksum_len> row_mut(size_t row) noexcept {
+			assert(row < size_);
+			return std::span<std::byte, checksum_len>{std::to_address(data_) + row * row_stride, checksum_len};
+		}
+
+		void hash_object(std::span<std::byte, checksum_len> out, std::span<std::byte const> obj) const noexcept {
+			Hash::hash_single(obj, out, key_.get());
+
+			if constexpr (needs_padding) {
+				MathEngine::clear_padding_bits(out);
+			}
+		}
+
+		/**
+		 * @brief hints the CPU to load the first cache lines of row (the rest is picked up by the hardware prefetcher)
+		 */
+		void prefetch_row([[maybe_unused]] size_t row) const noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+			auto const *const begin = std::to_address(data_) + row * row_stride;
+			for (size_t offset = 0; offset < std::min(row_stride, prefetch_bytes); offset += HugePageAllocator<std::byte>::cache_line_size) {
+				__builtin_prefetch(begin + offset, 1);
+			}
+#endif
+		}
+
+		/**
+		 * @brief applies update(row_mut(rows[i]), hash of objs[i]) for all i, prefetching the next row while hashing the current object
+		 */
+		template<typename Update>
+		void update_bulk(std::span<size_t const> rows, std::span<std::span<std::byte const> const> objs, Update update) {
+			if (rows.size() != objs.size()) [[unlikely]] {
+				throw std::invalid_argument{"rows and objs must have the same size"};
+			}
+
+			alignas(MathEngine::min_buffer_align) std::array<std::byte, checksum_len> obj_hash;
+			for (size_t i = 0; i < rows.size(); ++i) {
+				if (i + 1 < rows.size()) {
+					prefetch_row(rows[i + 1]);
+				}
+				hash_object(obj_hash, objs[i]);
+				update(row_mut(rows[i]), std::span<std::byte const, checksum_len>{obj_hash});
+			}
+		}
+
+		void deallocate() noexcept {
+			if (data_ != nullptr) {
+				alloc_traits::deallocate(alloc_, data_, size_ * row_stride);
+				data_ = nullptr;
+			}
+		}
+
+	public:
+		/**
+		 * @brief Creates an array of n_rows empty checksums
+		 */
+		explicit LtHashArray(size_t n_rows, Allocator const &alloc = Allocator{}) : alloc_{alloc}, size_{n_rows} {
+			if (size_ != 0) {
+				data_ = alloc_traits::allocate(alloc_, size_ * row_stride);
+				std::memset(std::to_address(data_), 0, size_ * row_stride);
+			}
+		}
+
+		LtHashArray(LtHashArray const &other)
+			: LtHashArray{other.size_, alloc_traits::select_on_container_copy_construction(other.alloc_)} {
+			key_ = other.key_;
+			if (size_ != 0) {
+				std::memcpy(std::to_address(data_), std::to_address(other.data_), size_ * row_stride);
+			}
+		}
+
+		LtHashArray(LtHashArray &&other) noexcept : alloc_{std::move(other.alloc_)},
+													 data_{std::exchange(other.data_, nullptr)},
+													 size_{std::exchange(other.size_, 0)},
+													 key_{other.key_} {
+			other.clear_key();
+		}
+
+		LtHashArray &operator=(LtHashArray const &other) {
+			if (this != &other) [[likely]] {
+				LtHashArray tmp{other};
+				swap(tmp);
+			}
+			return *this;
+		}
+
+		LtHashArray &operator=(LtHashArray &&other) noexcept {
+			assert(this != &other);
+			LtHashArray tmp{std::move(other)};
+			swap(tmp);
+			return *this;
+		}
+
+		~LtHashArray() noexcept {
+			clear_key();
+			deallocate();
+		}
+
+		void swap(LtHashArray &other) noexcept {
+			static_assert(alloc_traits::is_always_equal::value || alloc_traits::propagate_on_container_swap::value,
+						  "LtHashArray requires an allocator that can be swapped");
+
+			using std::swap;
+			swap(alloc_, other.alloc_);
+			swap(data_, other.data_);
+			swap(size_, other.size_);
+			swap(key_, other.key_);
+		}
+
+		[[nodiscard]] allocator_type get_allocator() const noexcept {
+			return alloc_;
+		}
+
+		/**
+		 * @return number of rows
+		 */
+		[[nodiscard]] size_t size() const noexcept {
+			return size_;
+		}
+
+		/**
+		 * @brief Checks if the shared key is equal to the given key
+		 * @note this function is not secured against timing attacks
+		 */
+		[[nodiscard]] bool key_equal(std::span<std::byte const> other_key) const noexcept {
+			auto const this_key = key_.get();
+			return std::equal(this_key.begin(), this_key.end(), other_key.begin(), other_key.end());
+		}
+
+		/**
+		 * @brief Sets the key shared by all rows; securely erases the old key
+		 * @throws std::invalid_argument if key.size() is not in Hash::min_key_extent..Hash::max_key_extent (inclusive); only if supplied_key_len == std::dynamic_extent
+		 */
+		template<size_t supplied_key_len>
+			requires (supplied_key_len == std::dynamic_extent || (supplied_key_len >= Hash::min_key_extent
+																 && supplied_key_len <= Hash::max_key_extent))
+		void set_key(std::span<std::byte const, supplied_key_len> key) noexcept(supplied_key_len != std::dynamic_extent) {
+			if constexpr (supplied_key_len == std::dynamic_extent) {
+				if (key.size() < Hash::min_key_extent || key.size() > Hash::max_key_extent) [[unlikely]] {
+					throw std::invalid_argument{"Invalid key size"};
+				}
+			}
+
+			key_.set_unchecked(key);
+		}
+
+		/**
+		 * @brief Clears the shared key by securely erasing it
+		 */
+		void clear_key() noexcept {
+			key_.clear();
+		}
+
+		[[nodiscard]] std::span<std::byte const, checksum_len> checksum(size_t row) const noexcept {
+			assert(row < size_);
+			return std::span<std::byte const, checksum_len>{std::to_address(data_) + row * row_stride, checksum_len};
+		}
+
+		/**
+		 * @brief Explicitly sets the checksum of row to the given one
+		 * @throws std::invalid_argument if new_checksum has invalid padding; only if needs_padding
+		 */
+		void set_checksum(size_t row, std::span<std::byte const, checksum_len> new_checksum) noexcept(!needs_padding) {
+			auto const dst = row_mut(row);
+			std::copy(new_checksum.begin(), new_checksum.end(), dst.begin());
+
+			if constexpr (needs_padding) {
+				if (!MathEngine::check_padding_bits(checksum(row))) [[unlikely]] {
+					throw std::invalid_argument{"Invalid checksum: found non-zero padding bits"};
+				}
+			}
+		}
+
+		void clear_checksum(size_t row) noexcept {
+			auto const dst = row_mut(row);
+			std::fill(dst.begin(), dst.end(), std::byte{0});
+		}
+
+		/**
+		 * @brief Adds a single object to row
+		 */
+		LtHashArray &add(size_t row, std::span<std::byte const> obj) noexcept {
+			alignas(MathEngine::min_buffer_align) std::array<std::byte, checksum_len> obj_hash;
+			hash_object(obj_hash, obj);
+			MathEngine::add(row_mut(row), std::span<std::byte const, checksum_len>{obj_hash});
+			return *this;
+		}
+
+		/**
+		 * @brief Removes a single object from row
+		 */
+		LtHashArray &remove(size_t row, std::span<std::byte const> obj) noexcept {
+			alignas(MathEngine::min_buffer_align) std::array<std::byte, checksum_len> obj_hash;
+			hash_object(obj_hash, obj);
+			MathEngine::sub(row_mut(row), std::span<std::byte const, checksum_len>{obj_hash});
+			return *this;
+		}
+
+		/**
+		 * @brief Adds every objs[i] to the row rows[i].
+		 * 		Equivalent to calling add(rows[i], objs[i]) for every i, but the row of the next object is prefetched while the current
+		 * 		object is hashed, so scattered updates over a large array do not wait for every row to arrive from memory.
+		 * @throws std::invalid_argument if rows.size() != objs.size()
+		 */
+		LtHashArray &add_bulk(std::span<size_t const> rows, std::span<std::span<std::byte const> const> objs) {
+			update_bulk(rows, objs, [](auto dst, auto obj_hash) noexcept { MathEngine::add(dst, obj_hash); });
+			return *this;
+		}
+
+		/**
+		 * @brief Removes every objs[i] from the row rows[i], see add_bulk
+		 * @throws std::invalid_argument if rows.size() != objs.size()
+		 */
+		LtHashArray &remove_bulk(std::span<size_t const> rows, std::span<std::span<std::byte const> const> objs) {
+			update_bulk(rows, objs, [](auto dst, auto obj_hash) noexcept { MathEngine::sub(dst, obj_hash); });
+			return *this;
+		}
+
+		/**
+		 * @brief Adds the multiset of row src to row dst (in place)
+		 */
+		LtHashArray &combine_add(size_t dst, size_t src) noexcept {
+			MathEngine::add(row_mut(dst), checksum(src));
+			return *this;
+		}
+
+		/**
+		 * @brief Removes the multiset of row src from row dst (in place)
+		 */
+		LtHashArray &combine_remove(size_t dst, size_t src) noexcept {
+			MathEngine::sub(row_mut(dst), checksum(src));
+			return *this;
+		}
+
+		/**
+		 * @brief Adds other to row dst
+		 * @throws std::invalid_argument if other does not have the same key as *this
+		 */
+		LtHashArray &combine_add(size_t dst, lthash_type const &other) {
+			if (!other.key_equal(key_.get())) [[unlikely]] {
+				throw std::invalid_argument{"Cannot combine hashes with different keys"};
+			}
+
+			MathEngine::add(row_mut(dst), other.checksum());
+			return *this;
+		}
+
+		/**
+		 * @brief Removes other from row dst
+		 * @throws std::invalid_argument if other does not have the same key as *this
+		 */
+		LtHashArray &combine_remove(size_t dst, lthash_type const &other) {
+			if (!other.key_equal(key_.get())) [[unlikely]] {
+				throw std::invalid_argument{"Cannot combine hashes with different keys"};
+			}
+
+			MathEngine::sub(row_mut(dst), other.checksum());
+			return *this;
+		}
+
+		/**
+		 * @return an LtHash with the key of *this and the checksum of row
+		 */
+		[[nodiscard]] lthash_type get(size_t row) const noexcept {
+			lthash_type ret{checksum(row)};
+			ret.set_key(key_.get());
+			return ret;
+		}
+
+		/**
+		 * @return an LtHash with the key of *this representing the union of the rows [first_row, last_row)
+		 */
+		[[nodiscard]] lthash_type aggregate(size_t first_row, size_t last_row) const noexcept {
+			assert(first_row <= last_row && last_row <= size_);
+
+			alignas(MathEngine::min_buffer_align) std::array<std::byte, checksum_len> sum{};
+			for (size_t row = first_row; row < last_row; ++row) {
+				MathEngine::add(std::span<std::byte, checksum_len>{sum}, checksum(row));
+			}
+
+			lthash_type ret{sum};
+			ret.set_key(key_.get());
+			return ret;
+		}
+
+		/**
+		 * @return an LtHash with the key of *this representing the union of all rows
+		 */
+		[[nodiscard]] lthash_type aggregate() const noexcept {
+			return aggregate(0, size_);
+		}
+	};
+
+} // namespace dice::hash::lthash
+
+#endif//DICE_HASH_LTHASHARRAY_HPP
@@ -0,0 +1,266 @@
+#ifndef DICE_HASH_LTHASHDELTA_HPP
+#define DICE_HASH_LTHASHDELTA_HPP
+
+#include "dice/hash/lthash/LtHash.hpp"
+#include "dice/hash/lthash/LtHashSerialization.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+namespace dice::hash::lthash {
+
+	/**
+	 * @brief The accumulated difference of an LtHash since a base checksum, for shipping changes to replicas.
+	 *
+	 * As long as the recorded objects are small in total (at most max_sparse_len bytes) the delta is encoded sparsely,
+	 * i.e. as the list of added/removed objects, which the receiver hashes with its own key. Otherwise only the (bit-packed)
+	 * difference of the checksums is encoded.
+	 *
+	 * The encoding contains a one-way fingerprint of the key and the digest() of the base checksum, so that
+	 * decode/apply_to only accept deltas created with the same key and against the same base.
+	 *
+	 * Encoding (integers little endian):
+	 * 	- magic "DLTD" (4 bytes), format version (1 byte, dice::hash::pobr_version), element bits (1 byte),
+	 * 	  encoding (1 byte, 0 = dense, 1 = sparse), reserved (1 byte), element count (4 bytes), reserved (4 bytes)
+	 * 	- key fingerprint (32 bytes)
+	 * 	- digest() of the base checksum (32 bytes)
+	 * 	- dense: the difference as in serialization::SerializedLtHashView::payload()
+	 * 	- sparse: per object: operation (1 byte, 0 = add, 1 = remove), length (4 bytes), object bytes
+	 *
+	 * @tparam LtHashT the LtHash type, e.g. LtHash16
+	 */
+	template<typename LtHashT>
+	struct LtHashDelta {
+		static constexpr size_t fingerprint_len = 32;
+		static constexpr size_t header_len = serialization::header_len + 2 * fingerprint_len;
+
+		static constexpr std::array<std::byte, 4> magic{std::byte{'D'}, std::byte{'L'}, std::byte{'T'}, std::byte{'D'}};
+		static constexpr std::string_view key_fingerprint_context = "dice-hash LtHashDelta key fingerprint v1";
+
+	private:
+		static constexpr uint8_t encoding_dense = 0;
+		static constexpr uint8_t encoding_sparse = 1;
+		static constexpr uint8_t op_add = 0;
+		static constexpr uint8_t op_remove = 1;
+		static constexpr size_t op_header_len = 1 + 4;
+
+		LtHashT diff_;
+		std::array<std::byte, fingerprint_len> key_fingerprint_;
+		std::array<std::byte, fingerprint_len> base_digest_;
+		size_t max_sparse_len_;
+		bool sparse_ = true;
+		std::vector<std::byte> ops_; // sparse payload
+
+		static std::array<std::byte, fingerprint_len> key_fingerprint(LtHashT const &h) noexcept {
+			std::array<std::byte, fingerprint_len> ret;
+			blake3::Blake3<fingerprint_len> hasher{key_fingerprint_context};
+			hasher.digest(h.key_.get());
+			std::move(hasher).finish(ret);
+			return ret;
+		}
+
+		void record(uint8_t op, std::span<std::byte const> obj) {
+			if (!sparse_) {
+				return;
+			}
+
+			if (obj.size() > std::numeric_limits<uint32_t>::max() || ops_.size() + op_header_len + obj.size() > max_sparse_len_) {
+				// the dense difference is smaller from now on
+				sparse_ = false;
+				ops_.clear();
+				ops_.shrink_to_fit();
+				return;
+			}
+
+			auto const offset = ops_.size();
+			ops_.resize(offset + op_header_len + obj.size());
+			ops_[offset] = static_cast<std::byte>(op);
+			serialization::detail::store_le64(ops_.data() + offset + 1, obj.size(), 4);
+			std::copy(obj.begin(), obj.end(), ops_.begin() + static_cast<std::ptrdiff_t>(offset + op_header_len));
+		}
+
+		void replay(std::span<std::byte const> ops) {
+			while (!ops.empty()) {
+				if (ops.size() < op_header_len) [[unlikely]] {
+					throw std::invalid_argument{"Invalid LtHashDelta: truncated object"};
+				}
+
+				auto const op = static_cast<uint8_t>(ops[0]);
+				auto const len = serialization::detail::load_le64(ops.data() + 1, 4);
+				if (op > op_remove || ops.size() - op_header_len < len) [[unlikely]] {
+					throw std::invalid_argument{"Invalid LtHashDelta: invalid object"};
+				}
+
+				auto const obj = ops.subspan(op_header_len, len);
+				if (op == op_add) {
+					add(obj);
+				} else {
+					remove(obj);
+				}
+				ops = ops.subspan(op_header_len + len);
+			}
+		}
+
+	public:
+		/**
+		 * @brief Starts recording changes relative to base (using the key of base)
+		 * @param max_sparse_len maximum size of the sparse encoding, afterwards the dense encoding is used
+		 */
+		explicit LtHashDelta(LtHashT const &base, size_t max_sparse_len = serialization::payload_len<LtHashT>)
+			: diff_{base},
+			  key_fingerprint_{key_fingerprint(base)},
+			  max_sparse_len_{max_sparse_len} {
+			diff_.clear_checksum();
+			std::ranges::copy(base.digest(), base_digest_.begin());
+		}
+
+		/**
+		 * @brief Records the addition of obj
+		 */
+		LtHashDelta &add(std::span<std::byte const> obj) {
+			diff_.add(obj);
+			record(op_add, obj);
+			return *this;
+		}
+
+		/**
+		 * @brief Records the removal of obj
+		 */
+		LtHashDelta &remove(std::span<std::byte const> obj) {
+			diff_.remove(obj);
+			record(op_remove, obj);
+			return *this;
+		}
+
+		/**
+		 * @return true if encode() produces the sparse encoding (list of objects)
+		 */
+		[[nodiscard]] bool is_sparse() const noexcept {
+			return sparse_;
+		}
+
+		/**
+		 * @return the difference as an LtHash (with the key of the base)
+		 */
+		[[nodiscard]] LtHashT const &difference() const noexcept {
+			return diff_;
+		}
+
+		[[nodiscard]] std::span<std::byte const, fingerprint_len> base_digest() const noexcept {
+			return base_digest_;
+		}
+
+		/**
+		 * @return the size of encode()
+		 */
+		[[nodiscard]] size_t encoded_len() const noexcept {
+			return header_len + (sparse_ ? ops_.size() : serialization::payload_len<LtHashT>);
+		}
+
+		[[nodiscard]] std::vector<std::byte> encode() const {
+			std::vector<std::byte> ret(encoded_len());
+			std::span<std::byte> out{ret};
+
+			std::copy(magic.begin(), magic.end(), out.begin());
+			out[4] = static_cast<std::byte>(serialization::format_version);
+			out[5] = static_cast<std::byte>(LtHashT::element_bits);
+			out[6] = static_cast<std::byte>(sparse_ ? encoding_sparse : encoding_dense);
+			serialization::detail::store_le64(out.data() + 8, LtHashT::element_count, 4);
+
+			out = out.subspan(serialization::header_len);
+			std::copy(key_fingerprint_.begin(), key_fingerprint_.end(), out.begin());
+			std::copy(base_digest_.begin(), base_digest_.end(), out.begin() + fingerprint_len);
+
+			out = out.subspan(2 * fingerprint_len);
+			if (sparse_) {
+				std::copy(ops_.begin(), ops_.end(), out.begin());
+			} else {
+				serialization::detail::pack<LtHashT>(diff_.checksum(), out);
+			}
+
+			return ret;
+		}
+
+		/**
+		 * @brief Decodes a delta that was recorded relative to base
+		 * @param data the output of encode()
+		 * @param base the local checksum the delta will be applied to; provides the key (to hash objects of sparse deltas)
+		 * @throws std::invalid_argument if data is not a valid encoded delta, was created with a different key or relative to a different base
+		 */
+		[[nodiscard]] static LtHashDelta decode(std::span<std::byte const> data, LtHashT const &base) {
+			if (data.size() < header_len || !std::equal(magic.begin(), magic.end(), data.begin())) [[unlikely]] {
+				throw std::invalid_argument{"Not an encoded LtHashDelta"};
+			}
+
+			if (static_cast<uint8_t>(data[4]) != serialization::format_version) [[unlikely]] {
+				throw std::invalid_argument{"Unsupported LtHashDelta format version"};
+			}
+
+			auto const encoding = static_cast<uint8_t>(data[6]);
+			if (encoding > encoding_sparse || data[7] != std::byte{0} || serialization::detail::load_le64(data.data() + 12, 4) != 0) [[unlikely]] {
+				throw std::invalid_argument{"Invalid LtHashDelta header: unknown encoding or non-zero reserved bytes"};
+			}
+
+			if (static_cast<uint8_t>(data[5]) != LtHashT::element_bits
+				|| serialization::detail::load_le64(data.data() + 8, 4) != LtHashT::element_count) [[unlikely]] {
+				throw std::invalid_argument{"LtHashDelta has different dimensions"};
+			}
+
+			LtHashDelta ret{base, std::numeric_limits<size_t>::max()};
+
+			auto const fingerprints = data.subspan(serialization::header_len, 2 * fingerprint_len);
+			if (!std::equal(ret.key_fingerprint_.begin(), ret.key_fingerprint_.end(), fingerprints.begin())) [[unlikely]] {
+				throw std::invalid_argument{"LtHashDelta was created with a different key"};
+			}
+			if (!std::equal(ret.base_digest_.begin(), ret.base_digest_.end(), fingerprints.begin() + fingerprint_len)) [[unlikely]] {
+				throw std::invalid_argument{"LtHashDelta was created relative to a different base"};
+			}
+
+			auto const payload = data.subspan(header_len);
+			if (encoding == encoding_sparse) {
+				ret.replay(payload);
+			} else {
+				if (payload.size() != serialization::payload_len<LtHashT>) [[unlikely]] {
+					throw std::invalid_argument{"LtHashDelta has invalid length"};
+				}
+
+				alignas(LtHashT::checksum_align) std::array<std::byte, LtHashT::checksum_len> checksum;
+				serialization::detail::unpack<LtHashT>(payload, checksum);
+				ret.diff_.set_checksum(checksum);
+				ret.sparse_ = false;
+				ret.ops_.clear();
+			}
+
+			ret.max_sparse_len_ = serialization::payload_len<LtHashT>;
+			return ret;
+		}
+
+		/**
+		 * @brief Applies the delta to target, which must still be at the base checksum (i.e. afterwards target has the checksum
+		 * 		the sender had when encoding the delta)
+		 * @throws std::invalid_argument if target has a different key or is not at the base checksum
+		 */
+		void apply_to(LtHashT &target) const {
+			if (!target.key_equal(diff_)) [[unlikely]] {
+				throw std::invalid_argument{"Cannot apply an LtHashDelta to a hash with a different key"};
+			}
+
+			auto const target_digest = target.digest();
+			if (!std::equal(base_digest_.begin(), base_digest_.end(), target_digest.begin())) [[unlikely]] {
+				throw std::invalid_argument{"Cannot apply an LtHashDelta to a hash that is not at its base"};
+			}
+
+			target.combine_add(diff_);
+		}
+	};
+
+} // namespace dice::hash::lthash
+
+#endif//DICE_HASH_LTHASHDELTA_HPP
@@ -0,0 +1,311 @@
+#ifndef DICE_HASH_LTHASHSERIALIZATION_HPP
+#define DICE_HASH_LTHASHSERIALIZATION_HPP
+
+#include "dice/hash/lthash/LtHash.hpp"
+#include "dice/hash/version.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * Versioned binary representation of LtHash checksums.
+ *
+ * Layout (all integers little endian):
+ * 	- magic "DLTH" (4 bytes)
+ * 	- format version (1 byte, equal to dice::hash::pobr_version)
+ * 	- element bits (1 byte)
+ * 	- flags (1 byte, see flag_delta)
+ * 	- reserved (1 byte, 0)
+ * 	- element count (4 bytes)
+ * 	- reserved (4 bytes, 0)
+ * 	- only if flag_delta: digest() of the base checksum (32 bytes)
+ * 	- payload: the elements as a dense bit stream (element_bits per element, no padding bits)
+ *
+ * For 16 and 32 bit elements the payload is identical to the checksum bytes,
+ * 20 bit elements are packed from 21 to 20 bits each (i.e. 2 words = 6 elements => 15 bytes).
+ * The packed form has no padding bits, so unpacking always yields a checksum with valid padding.
+ */
+namespace dice::hash::lthash::serialization {
+
+	inline constexpr std::array<std::byte, 4> magic{std::byte{'D'}, std::byte{'L'}, std::byte{'T'}, std::byte{'H'}};
+	inline constexpr uint8_t format_version = static_cast<uint8_t>(::dice::hash::pobr_version);
+	inline constexpr uint8_t flag_delta = 1;
+
+	inline constexpr size_t header_len = 16;
+	inline constexpr size_t base_digest_len = 32;
+
+	namespace detail {
+		inline uint64_t load_le64(std::byte const *src, size_t n_bytes = sizeof(uint64_t)) noexcept {
+			uint64_t ret = 0;
+			for (size_t ix = 0; ix < n_bytes; ++ix) {
+				ret |= static_cast<uint64_t>(src[ix]) << (8 * ix);
+			}
+			return ret;
+		}
+
+		inline void store_le64(std::byte *dst, uint64_t value, size_t n_bytes = sizeof(uint64_t)) noexcept {
+			for (size_t ix = 0; ix < n_bytes; ++ix) {
+				dst[ix] = static_cast<std::byte>(value >> (8 * ix));
+			}
+		}
+
+		inline constexpr uint64_t mask20 = (uint64_t{1} << 20) - 1;
+
+		/**
+		 * @brief packs pairs of words with 3 padded 20 bit elements each (bits 0-19, 21-40, 42-61) into 15 bytes each
+		 */
+		inline void pack20(std::span<std::byte const> checksum, std::span<std::byte> out) noexcept {
+			assert(checksum.size() % 16 == 0);
+			assert(out.size() == checksum.size() / 16 * 15);
+
+			for (size_t in = 0, o = 0; in < checksum.size(); in += 16, o += 15) {
+				auto const w0 = load_le64(checksum.data() + in);
+				auto const w1 = load_le64(checksum.data() + in + 8);
+
+				auto const lo = (w0 & mask20) | (((w0 >> 21) & mask20) << 20) | (((w0 >> 42) & mask20) << 40) | ((w1 & mask20) << 60);
+				auto const hi = ((w1 & mask20) >> 4) | (((w1 >> 21) & mask20) << 16) | (((w1 >> 42) & mask20) << 36);
+
+				store_le64(out.data() + o, lo);
+				store_le64(out.data() + o + 8, hi, 7);
+			}
+		}
+
+		/**
+		 * @brief inverse of pack20
+		 */
+		inline void unpack20(std::span<std::byte const> packed, std::span<std::byte> checksum) noexcept {
+			assert(packed.size() % 15 == 0);
+			assert(checksum.size() == packed.size() / 15 * 16);
+
+			for (size_t in = 0, o = 0; in < packed.size(); in += 15, o += 16) {
+				auto const lo = load_le64(packed.data() + in);
+				auto const hi = load_le64(packed.data() + in + 8, 7);
+
+				auto const w0 = (lo & mask20) | (((lo >> 20) & mask20) << 21) | (((lo >> 40) & mask20) << 42);
+				auto const w1 = (((lo >> 60) | (hi << 4)) & mask20) | (((hi >> 16) & mask20) << 21) | (((hi >> 36) & mask20) << 42);
+
+				store_le64(checksum.data() + o, w0);
+				store_le64(checksum.data() + o + 8, w1);
+			}
+		}
+
+		template<typename LtHashT>
+		void write_header(std::span<std::byte> out, uint8_t flags) noexcept {
+			std::fill(out.begin(), out.begin() + header_len, std::byte{0});
+			std::copy(magic.begin(), magic.end(), out.begin());
+			out[4] = static_cast<std::byte>(format_version);
+			out[5] = static_cast<std::byte>(LtHashT::element_bits);
+			out[6] = static_cast<std::byte>(flags);
+			store_le64(out.data() + 8, LtHashT::element_count, 4);
+		}
+
+		template<typename LtHashT>
+		void pack(std::span<std::byte const, LtHashT::checksum_len> checksum, std::span<std::byte> out) noexcept {
+			if constexpr (LtHashT::needs_padding) {
+				static_assert(LtHashT::element_bits == 20);
+				pack20(checksum, out);
+			} else {
+				std::copy(checksum.begin(), checksum.end(), out.begin());
+			}
+		}
+
+		template<typename LtHashT>
+		void unpack(std::span<std::byte const> packed, std::span<std::byte, LtHashT::checksum_len> checksum) noexcept {
+			if constexpr (LtHashT::needs_padding) {
+				static_assert(LtHashT::element_bits == 20);
+				unpack20(packed, checksum);
+			} else {
+				std::copy(packed.begin(), packed.end(), checksum.begin());
+			}
+		}
+	} // namespace detail
+
+	/**
+	 * @brief size of the payload (i.e. without header) for LtHashT
+	 */
+	template<typename LtHashT>
+	inline constexpr size_t payload_len = LtHashT::element_count * LtHashT::element_bits / 8;
+
+	/**
+	 * @brief size of the serialized representation of LtHashT
+	 */
+	template<typename LtHashT>
+	inline constexpr size_t serialized_len(bool delta = false) noexcept {
+		return header_len + (delta ? base_digest_len : 0) + payload_len<LtHashT>;
+	}
+
+	/**
+	 * @brief A validated, non-owning view of a serialized checksum; the payload is only unpacked on request
+	 */
+	template<typename LtHashT>
+	class SerializedLtHashView {
+		std::span<std::byte const> data_;
+		bool delta_;
+
+	public:
+		/**
+		 * @brief Parses and validates the header of data
+		 * @throws std::invalid_argument if data is not a serialized checksum (of this format version) for LtHashT
+		 */
+		explicit SerializedLtHashView(std::span<std::byte const> data) : data_{data} {
+			if (data.size() < header_len || !std::equal(magic.begin(), magic.end(), data.begin())) [[unlikely]] {
+				throw std::invalid_argument{"Not a serialized LtHash checksum"};
+			}
+
+			if (static_cast<uint8_t>(data[4]) != format_version) [[unlikely]] {
+				throw std::invalid_argument{"Unsupported LtHash serialization format version"};
+			}
+
+			auto const flags = static_cast<uint8_t>(data[6]);
+			if ((flags & ~flag_delta) != 0 || data[7] != std::byte{0} || detail::load_le64(data.data() + 12, 4) != 0) [[unlikely]] {
+				throw std::invalid_argument{"Invalid LtHash serialization header: unknown flags or non-zero reserved bytes"};
+			}
+			delta_ = (flags & flag_delta) != 0;
+
+			if (static_cast<uint8_t>(data[5]) != LtHashT::element_bits || detail::load_le64(data.data() + 8, 4) != LtHashT::element_count) [[unlikely]] {
+				throw std::invalid_argument{"Serialized LtHash checksum has different dimensions"};
+			}
+
+			if (data.size() != serialized_len<LtHashT>(delta_)) [[unlikely]] {
+				throw std::invalid_argument{"Serialized LtHash checksum has invalid length"};
+			}
+		}
+
+		/**
+		 * @return true if this is a delta against a base checksum
+		 */
+		[[nodiscard]] bool is_delta() const noexcept {
+			return delta_;
+		}
+
+		/**
+		 * @return digest() of the base checksum; only if is_delta()
+		 */
+		[[nodiscard]] std::span<std::byte const, base_digest_len> base_digest() const noexcept {
+			assert(delta_);
+			return data_.subspan(header_len).template first<base_digest_len>();
+		}
+
+		/**
+		 * @return the packed elements
+		 */
+		[[nodiscard]] std::span<std::byte const, payload_len<LtHashT>> payload() const noexcept {
+			return data_.last(payload_len<LtHashT>).template first<payload_len<LtHashT>>();
+		}
+
+		/**
+		 * @brief Unpacks the payload (the checksum, or the difference to the base checksum if is_delta()) into out
+		 */
+		void unpack(std::span<std::byte, LtHashT::checksum_len> out) const noexcept {
+			detail::unpack<LtHashT>(payload(), out);
+		}
+	};
+
+	/**
+	 * @brief Writes the serialized representation of h.checksum() to out
+	 * @throws std::invalid_argument if out.size() != serialized_len<LtHashT>()
+	 */
+	template<typename LtHashT>
+	void serialize(LtHashT const &h, std::span<std::byte> out) {
+		if (out.size() != serialized_len<LtHashT>()) [[unlikely]] {
+			throw std::invalid_argument{"Invalid output size for serialized LtHash checksum"};
+		}
+
+		detail::write_header<LtHashT>(out, 0);
+		detail::pack<LtHashT>(h.checksum(), out.subspan(header_len));
+	}
+
+	template<typename LtHashT>
+	[[nodiscard]] std::vector<std::byte> serialize(LtHashT const &h) {
+		std::vector<std::byte> ret(serialized_len<LtHashT>());
+		serialize(h, std::span{ret});
+		return ret;
+	}
+
+	/**
+	 * @brief Writes the serialized representation of the difference between h and base (i.e. h - base) to out.
+	 * 		The digest of base is stored alongside, to make sure the delta is applied to the same base.
+	 * @throws std::invalid_argument if out.size() != serialized_len<LtHashT>(true) or h and base have different keys
+	 */
+	template<typename LtHashT>
+	void serialize_delta(LtHashT const &h, LtHashT const &base, std::span<std::byte> out) {
+		if (out.size() != serialized_len<LtHashT>(true)) [[unlikely]] {
+			throw std::invalid_argument{"Invalid output size for serialized LtHash checksum"};
+		}
+
+		LtHashT diff{h};
+		diff.combine_remove(base);
+
+		detail::write_header<LtHashT>(out, flag_delta);
+
+		auto const base_digest = base.digest();
+		std::copy(base_digest.begin(), base_digest.end(), out.begin() + header_len);
+
+		detail::pack<LtHashT>(diff.checksum(), out.subspan(header_len + base_digest_len));
+	}
+
+	template<typename LtHashT>
+	[[nodiscard]] std::vector<std::byte> serialize_delta(LtHashT const &h, LtHashT const &base) {
+		std::vector<std::byte> ret(serialized_len<LtHashT>(true));
+		serialize_delta(h, base, std::span{ret});
+		return ret;
+	}
+
+	/**
+	 * @brief Sets the checksum of h to the serialized one (the key of h is kept)
+	 * @throws std::invalid_argument if data is not a valid, non-delta serialized checksum for LtHashT
+	 */
+	template<typename LtHashT>
+	void deserialize(std::span<std::byte const> data, LtHashT &h) {
+		SerializedLtHashView<LtHashT> const view{data};
+		if (view.is_delta()) [[unlikely]] {
+			throw std::invalid_argument{"Serialized LtHash checksum is a delta, use deserialize_delta"};
+		}
+
+		alignas(LtHashT::checksum_align) std::array<std::byte, LtHashT::checksum_len> checksum;
+		view.unpack(checksum);
+		h.set_checksum(checksum);
+	}
+
+	/**
+	 * @brief Sets h to base + the serialized delta
+	 * @throws std::invalid_argument if data is not a valid serialized delta for LtHashT, if it was computed against a different base
+	 * 		or if h and base have different keys
+	 */
+	template<typename LtHashT>
+	void deserialize_delta(std::span<std::byte const> data, LtHashT const &base, LtHashT &h) {
+		SerializedLtHashView<LtHashT> const view{data};
+		if (!view.is_delta()) [[unlikely]] {
+			throw std::invalid_argument{"Serialized LtHash checksum is not a delta, use deserialize"};
+		}
+
+		auto const base_digest = base.digest();
+		if (!std::equal(base_digest.begin(), base_digest.end(), view.base_digest().begin())) [[unlikely]] {
+			throw std::invalid_argument{"Serialized LtHash delta was computed against a different base"};
+		}
+
+		if (!h.key_equal(base)) [[unlikely]] {
+			throw std::invalid_argument{"Cannot apply a delta to a hash with a different key"};
+		}
+
+		alignas(LtHashT::checksum_align) std::array<std::byte, LtHashT::checksum_len> checksum;
+		view.unpack(checksum);
+
+		LtHashT diff{base};
+		diff.set_checksum(checksum);
+
+		if (&h != &base) {
+			h.set_checksum(base.checksum());
+		}
+		h.combine_add(diff);
+	}
+
+} // namespace dice::hash::lthash::serialization
+
+#endif//DICE_HASH_LTHASHSERIALIZATION_HPP
@@ -2,6 +2,7 @@
 #define DICE_HASH_MATHENGINE_HPP
 
 #include "dice/hash/lthash/MathEngine_Hwy.hpp"
+#include "dice/hash/lthash/MathEngine_HwyNative.hpp"
 #include "dice/hash/lthash/MathEngine_Simple.hpp"
 
 namespace dice::hash::lthash {
@@ -35,6 +36,16 @@ namespace dice::hash::lthash {
 	template<template<typename> typename ME, typename B>
 	concept MathEngine = UnpaddedMathEngine<ME, B> && (!PaddedBits<B> || PaddedMathEngine<ME, B>);
 
+	/**
+	 * @brief Math engines can optionally provide (vectorized) checksum comparisons,
+	 * 		LtHash falls back to std::equal/sodium_memcmp otherwise
+	 */
+	template<typename ME>
+	concept ComparingMathEngine = requires (std::span<std::byte const, 8> a, std::span<std::byte const, 8> b) {
+		{ ME::equal(a, b) } -> std::convertible_to<bool>;
+		{ ME::equal_constant_time(a, b) } -> std::convertible_to<bool>;
+	};
+
 	template<typename Bits>
 	using DefaultMathEngine = MathEngine_Hwy<Bits>;
 } // namespace dice::hash::lthash
@@ -1,4 +1,5 @@
 #include "MathEngine_Hwy.hpp"
+#include "HwyTargets.hpp"
 
 #undef HWY_TARGET_INCLUDE
 #define HWY_TARGET_INCLUDE "dice/hash/lthash/MathEngine_Hwy.cpp"
@@ -117,6 +118,69 @@ namespace dice::hash::lthash::detail::HWY_NAMESPACE {
 
 		return r;
 	}
+	static bool equal_impl(std::span<uint64_t const> a, std::span<uint64_t const> b) {
+		using namespace hwy::HWY_NAMESPACE;
+
+		using D = ScalableTag<uint64_t>;
+		using V = Vec<D>;
+
+		D d;
+		size_t const n = Lanes(d);
+		V const zero = Zero(d);
+
+		size_t ix = 0;
+
+		// check 4 vectors at once to keep the number of (unpredictable) branches low
+		for (; ix + 4 * n <= a.size(); ix += 4 * n) {
+			V diff0 = Xor(LoadU(d, a.data() + ix), LoadU(d, b.data() + ix));
+			V diff1 = Xor(LoadU(d, a.data() + ix + n), LoadU(d, b.data() + ix + n));
+			V diff2 = Xor(LoadU(d, a.data() + ix + 2 * n), LoadU(d, b.data() + ix + 2 * n));
+			V diff3 = Xor(LoadU(d, a.data() + ix + 3 * n), LoadU(d, b.data() + ix + 3 * n));
+
+			if (!AllTrue(d, Eq(Or(Or(diff0, diff1), Or(diff2, diff3)), zero))) {
+				return false;
+			}
+		}
+
+		for (; ix + n <= a.size(); ix += n) {
+			if (!AllTrue(d, Eq(LoadU(d, a.data() + ix), LoadU(d, b.data() + ix)))) {
+				return false;
+			}
+		}
+
+		for (; ix < a.size(); ++ix) {
+			if (a[ix] != b[ix]) {
+				return false;
+			}
+		}
+
+		return true;
+	}
+	static bool equal_constant_time_impl(std::span<uint64_t const> a, std::span<uint64_t const> b) {
+		using namespace hwy::HWY_NAMESPACE;
+
+		using D = ScalableTag<uint64_t>;
+		using V = Vec<D>;
+
+		D d;
+		size_t const n = Lanes(d);
+
+		// no data dependent branches: OR together all differences and only look at the result at the end
+		V diff = Zero(d);
+
+		size_t ix = 0;
+		for (; ix + n <= a.size(); ix += n) {
+			diff = Or(diff, Xor(LoadU(d, a.data() + ix), LoadU(d, b.data() + ix)));
+		}
+
+		uint64_t tail_diff = 0;
+		for (; ix < a.size(); ++ix) {
+			tail_diff |= a[ix] ^ b[ix];
+		}
+
+		diff = Or(diff, Set(d, tail_diff));
+		return AllTrue(d, Eq(diff, Zero(d)));
+	}
 	static void clear_padding_bits_impl(std::span<uint64_t> data, uint64_t data_mask) {
 		using namespace hwy::HWY_NAMESPACE;
 
@@ -134,12 +198,17 @@ HWY_AFTER_NAMESPACE();
 
 #if HWY_ONCE
 namespace dice::hash::lthash::detail {
+	// pin the target given by DICE_HASH_HWY_TARGET before the first dispatch
+	[[maybe_unused]] static bool const env_target_applied = hwy_targets::detail::apply_env_target_once();
+
 	HWY_EXPORT(add_with_padding_impl);
 	HWY_EXPORT(add_no_padding_impl);
 	HWY_EXPORT(sub_with_padding_impl);
 	HWY_EXPORT(sub_no_padding_impl);
 	HWY_EXPORT(check_padding_bits_impl);
 	HWY_EXPORT(clear_padding_bits_impl);
+	HWY_EXPORT(equal_impl);
+	HWY_EXPORT(equal_constant_time_impl);
 
 	void add_with_padding(std::span<uint64_t> dst, std::span<uint64_t const> src, uint64_t data_mask) {
 		HWY_DYNAMIC_DISPATCH(add_with_padding_impl)(dst, src, data_mask);
@@ -159,5 +228,11 @@ namespace dice::hash::lthash::detail {
 	void clear_padding_bits(std::span<uint64_t> data, uint64_t data_mask) {
 		HWY_DYNAMIC_DISPATCH(clear_padding_bits_impl)(data, data_mask);
 	}
+	bool equal(std::span<uint64_t const> a, std::span<uint64_t const> b) {
+		return HWY_DYNAMIC_DISPATCH(equal_impl)(a, b);
+	}
+	bool equal_constant_time(std::span<uint64_t const> a, std::span<uint64_t const> b) {
+		return HWY_DYNAMIC_DISPATCH(equal_constant_time_impl)(a, b);
+	}
 }
 #endif
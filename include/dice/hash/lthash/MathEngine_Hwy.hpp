@@ -16,6 +16,8 @@ namespace dice::hash::lthash {
 		void sub_no_padding(std::span<uint64_t> dst, std::span<uint64_t const> src, uint64_t mask_group1, uint64_t mask_group2);
 		bool check_padding_bits(std::span<uint64_t const> data, uint64_t data_mask);
 		void clear_padding_bits(std::span<uint64_t> data, uint64_t data_mask);
+		bool equal(std::span<uint64_t const> a, std::span<uint64_t const> b);
+		bool equal_constant_time(std::span<uint64_t const> a, std::span<uint64_t const> b);
 	}
 
 	template<typename Bits>
@@ -91,6 +93,38 @@ namespace dice::hash::lthash {
 			std::span<uint64_t> data64{reinterpret_cast<uint64_t *>(data.data()), data.size() / sizeof(uint64_t)};
 			detail::clear_padding_bits(data64, Bits::data_mask);
 		}
+
+		/**
+		 * @brief Checks if a and b are equal, returns as soon as a difference is found
+		 * @note this function is _not_ secured against timing attacks
+		 */
+		template<size_t Extent>
+		static bool equal(std::span<std::byte const, Extent> a, std::span<std::byte const, Extent> b) noexcept {
+			assert(a.size() == b.size());
+			assert(a.size() % sizeof(uint64_t) == 0);
+			assert(reinterpret_cast<uintptr_t>(a.data()) % alignof(uint64_t) == 0);
+			assert(reinterpret_cast<uintptr_t>(b.data()) % alignof(uint64_t) == 0);
+
+			std::span<uint64_t const> a64{reinterpret_cast<uint64_t const *>(a.data()), a.size() / sizeof(uint64_t)};
+			std::span<uint64_t const> b64{reinterpret_cast<uint64_t const *>(b.data()), b.size() / sizeof(uint64_t)};
+			return detail::equal(a64, b64);
+		}
+
+		/**
+		 * @brief Checks if a and b are equal, always looks at all of the data
+		 * @note this function is secured against timing attacks
+		 */
+		template<size_t Extent>
+		static bool equal_constant_time(std::span<std::byte const, Extent> a, std::span<std::byte const, Extent> b) noexcept {
+			assert(a.size() == b.size());
+			assert(a.size() % sizeof(uint64_t) == 0);
+			assert(reinterpret_cast<uintptr_t>(a.data()) % alignof(uint64_t) == 0);
+			assert(reinterpret_cast<uintptr_t>(b.data()) % alignof(uint64_t) == 0);
+
+			std::span<uint64_t const> a64{reinterpret_cast<uint64_t const *>(a.data()), a.size() / sizeof(uint64_t)};
+			std::span<uint64_t const> b64{reinterpret_cast<uint64_t const *>(b.data()), b.size() / sizeof(uint64_t)};
+			return detail::equal_constant_time(a64, b64);
+		}
 	};
 
 } // namespace dice::hash::lthash
@@ -0,0 +1,125 @@
+#include "MathEngine_HwyNative.hpp"
+#include "HwyTargets.hpp"
+
+#undef HWY_TARGET_INCLUDE
+#define HWY_TARGET_INCLUDE "dice/hash/lthash/MathEngine_HwyNative.cpp"
+#include <hwy/foreach_target.h>
+
+#include <hwy/highway.h>
+#include <hwy/contrib/algo/transform-inl.h>
+
+
+HWY_BEFORE_NAMESPACE();  // at file scope
+namespace dice::hash::lthash::detail::HWY_NAMESPACE {
+	template<typename V>
+	static HWY_INLINE V little_endian_lanes(V data) {
+		using namespace hwy::HWY_NAMESPACE;
+
+		if constexpr (std::endian::native == std::endian::little) {
+			return data;
+		}
+		else {
+			return ReverseLaneBytes(data);
+		}
+	}
+
+	template<typename T>
+	static HWY_INLINE void add_lanes(std::span<T> dst, std::span<T const> src) {
+		using namespace hwy::HWY_NAMESPACE;
+
+		using D = ScalableTag<T>;
+		using V = Vec<D>;
+
+		// lanes have the width of the elements, Add already wraps around modulo 2^bits
+		Transform1(D{}, dst.data(), dst.size(), src.data(), [](D, V d, V s) HWY_ATTR {
+			return little_endian_lanes(Add(little_endian_lanes(d), little_endian_lanes(s)));
+		});
+	}
+
+	template<typename T>
+	static HWY_INLINE void sub_lanes(std::span<T> dst, std::span<T const> src) {
+		using namespace hwy::HWY_NAMESPACE;
+
+		using D = ScalableTag<T>;
+		using V = Vec<D>;
+
+		Transform1(D{}, dst.data(), dst.size(), src.data(), [](D, V d, V s) HWY_ATTR {
+			return little_endian_lanes(Sub(little_endian_lanes(d), little_endian_lanes(s)));
+		});
+	}
+
+	static void native_add_u16_impl(std::span<uint16_t> dst, std::span<uint16_t const> src) {
+		add_lanes(dst, src);
+	}
+	static void native_sub_u16_impl(std::span<uint16_t> dst, std::span<uint16_t const> src) {
+		sub_lanes(dst, src);
+	}
+	static void native_add_u32_impl(std::span<uint32_t> dst, std::span<uint32_t const> src) {
+		add_lanes(dst, src);
+	}
+	static void native_sub_u32_impl(std::span<uint32_t> dst, std::span<uint32_t const> src) {
+		sub_lanes(dst, src);
+	}
+	static void native_add_with_padding_impl(std::span<uint64_t> dst, std::span<uint64_t const> src, uint64_t data_mask) {
+		using namespace hwy::HWY_NAMESPACE;
+
+		using D = ScalableTag<uint64_t>;
+		using V = Vec<D>;
+
+		V mask = Set(D{}, data_mask);
+
+		// the carry out of each element lands in its padding bit and is masked away
+		Transform1(D{}, dst.data(), dst.size(), src.data(), [&](D, V d, V s) HWY_ATTR {
+			return little_endian_lanes(And(Add(little_endian_lanes(d), little_endian_lanes(s)), mask));
+		});
+	}
+	static void native_sub_with_padding_impl(std::span<uint64_t> dst, std::span<uint64_t const> src, uint64_t data_mask) {
+		using namespace hwy::HWY_NAMESPACE;
+
+		using D = ScalableTag<uint64_t>;
+		using V = Vec<D>;
+
+		V mask = Set(D{}, data_mask);
+		V padding = Not(mask);
+
+		// setting the padding bits of the minuend lets every element borrow from its own padding bit,
+		// so the borrow never reaches the next element
+		Transform1(D{}, dst.data(), dst.size(), src.data(), [&](D, V d, V s) HWY_ATTR {
+			return little_endian_lanes(And(Sub(Or(little_endian_lanes(d), padding), little_endian_lanes(s)), mask));
+		});
+	}
+}
+HWY_AFTER_NAMESPACE();
+
+#if HWY_ONCE
+namespace dice::hash::lthash::detail {
+	// pin the target given by DICE_HASH_HWY_TARGET before the first dispatch
+	[[maybe_unused]] static bool const env_target_applied = hwy_targets::detail::apply_env_target_once();
+
+	HWY_EXPORT(native_add_u16_impl);
+	HWY_EXPORT(native_sub_u16_impl);
+	HWY_EXPORT(native_add_u32_impl);
+	HWY_EXPORT(native_sub_u32_impl);
+	HWY_EXPORT(native_add_with_padding_impl);
+	HWY_EXPORT(native_sub_with_padding_impl);
+
+	void native_add_u16(std::span<uint16_t> dst, std::span<uint16_t const> src) {
+		HWY_DYNAMIC_DISPATCH(native_add_u16_impl)(dst, src);
+	}
+	void native_sub_u16(std::span<uint16_t> dst, std::span<uint16_t const> src) {
+		HWY_DYNAMIC_DISPATCH(native_sub_u16_impl)(dst, src);
+	}
+	void native_add_u32(std::span<uint32_t> dst, std::span<uint32_t const> src) {
+		HWY_DYNAMIC_DISPATCH(native_add_u32_impl)(dst, src);
+	}
+	void native_sub_u32(std::span<uint32_t> dst, std::span<uint32_t const> src) {
+		HWY_DYNAMIC_DISPATCH(native_sub_u32_impl)(dst, src);
+	}
+	void native_add_with_padding(std::span<uint64_t> dst, std::span<uint64_t const> src, uint64_t data_mask) {
+		HWY_DYNAMIC_DISPATCH(native_add_with_padding_impl)(dst, src, data_mask);
+	}
+	void native_sub_with_padding(std::span<uint64_t> dst, std::span<uint64_t const> src, uint64_t data_mask) {
+		HWY_DYNAMIC_DISPATCH(native_sub_with_padding_impl)(dst, src, data_mask);
+	}
+}
+#endif
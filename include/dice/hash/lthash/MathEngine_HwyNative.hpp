@@ -0,0 +1,111 @@
+#ifndef DICE_HASH_MATHENGINE_HWYNATIVE_HPP
+#define DICE_HASH_MATHENGINE_HWYNATIVE_HPP
+
+#include "dice/hash/lthash/MathEngine_Hwy.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace dice::hash::lthash {
+	namespace detail {
+		void native_add_u16(std::span<uint16_t> dst, std::span<uint16_t const> src);
+		void native_sub_u16(std::span<uint16_t> dst, std::span<uint16_t const> src);
+		void native_add_u32(std::span<uint32_t> dst, std::span<uint32_t const> src);
+		void native_sub_u32(std::span<uint32_t> dst, std::span<uint32_t const> src);
+		void native_add_with_padding(std::span<uint64_t> dst, std::span<uint64_t const> src, uint64_t data_mask);
+		void native_sub_with_padding(std::span<uint64_t> dst, std::span<uint64_t const> src, uint64_t data_mask);
+	} // namespace detail
+
+	/**
+	 * @brief Highway based math engine that uses vector lanes of the element width (u16 for 16 bit elements, u32 for 32 bit elements)
+	 * 		instead of emulating lane-wise wraparound on u64 lanes with mask groups, as MathEngine_Hwy does.
+	 * 		Padded elements (20 bit) are processed as 21 bit slots in u64 lanes, subtraction borrows from the padding bits instead of negating.
+	 *
+	 * @note produces bit-for-bit the same results as MathEngine_Simple and MathEngine_Hwy
+	 */
+	template<typename Bits>
+	struct MathEngine_HwyNative {
+		static constexpr size_t min_buffer_align = alignof(uint64_t);
+
+	private:
+		template<typename T, size_t Extent>
+		static std::span<T> lanes(std::span<std::byte, Extent> data) noexcept {
+			return {reinterpret_cast<T *>(data.data()), data.size() / sizeof(T)};
+		}
+
+		template<typename T, size_t Extent>
+		static std::span<T const> lanes(std::span<std::byte const, Extent> data) noexcept {
+			return {reinterpret_cast<T const *>(data.data()), data.size() / sizeof(T)};
+		}
+
+	public:
+		template<size_t DstExtent, size_t SrcExtent>
+		static void add(std::span<std::byte, DstExtent> dst, std::span<std::byte const, SrcExtent> src) noexcept {
+			assert(dst.size() == src.size());
+			assert(dst.size() % sizeof(uint64_t) == 0);
+			assert(reinterpret_cast<uintptr_t>(dst.data()) % alignof(uint64_t) == 0);
+			assert(reinterpret_cast<uintptr_t>(src.data()) % alignof(uint64_t) == 0);
+
+			if constexpr (!Bits::needs_padding) {
+				static_assert(Bits::bits_per_element == 16 || Bits::bits_per_element == 32,
+							  "Only 16 and 32 bit elements are implemented for non-padded data");
+
+				if constexpr (Bits::bits_per_element == 16) {
+					detail::native_add_u16(lanes<uint16_t>(dst), lanes<uint16_t>(src));
+				} else {
+					detail::native_add_u32(lanes<uint32_t>(dst), lanes<uint32_t>(src));
+				}
+			} else {
+				detail::native_add_with_padding(lanes<uint64_t>(dst), lanes<uint64_t>(src), Bits::data_mask);
+			}
+		}
+
+		template<size_t DstExtent, size_t SrcExtent>
+		static void sub(std::span<std::byte, DstExtent> dst, std::span<std::byte const, SrcExtent> src) noexcept {
+			assert(dst.size() == src.size());
+			assert(dst.size() % sizeof(uint64_t) == 0);
+			assert(reinterpret_cast<uintptr_t>(dst.data()) % alignof(uint64_t) == 0);
+			assert(reinterpret_cast<uintptr_t>(src.data()) % alignof(uint64_t) == 0);
+
+			if constexpr (!Bits::needs_padding) {
+				static_assert(Bits::bits_per_element == 16 || Bits::bits_per_element == 32,
+							  "Only 16 and 32 bit elements are implemented for non-padded data");
+
+				if constexpr (Bits::bits_per_element == 16) {
+					detail::native_sub_u16(lanes<uint16_t>(dst), lanes<uint16_t>(src));
+				} else {
+					detail::native_sub_u32(lanes<uint32_t>(dst), lanes<uint32_t>(src));
+				}
+			} else {
+				detail::native_sub_with_padding(lanes<uint64_t>(dst), lanes<uint64_t>(src), Bits::data_mask);
+			}
+		}
+
+		template<size_t Extent>
+			requires(Bits::needs_padding)
+		static bool check_padding_bits(std::span<std::byte const, Extent> data) noexcept {
+			return MathEngine_Hwy<Bits>::check_padding_bits(data);
+		}
+
+		template<size_t Extent>
+			requires(Bits::needs_padding)
+		static void clear_padding_bits(std::span<std::byte, Extent> data) noexcept {
+			MathEngine_Hwy<Bits>::clear_padding_bits(data);
+		}
+
+		template<size_t Extent>
+		static bool equal(std::span<std::byte const, Extent> a, std::span<std::byte const, Extent> b) noexcept {
+			return MathEngine_Hwy<Bits>::equal(a, b);
+		}
+
+		template<size_t Extent>
+		static bool equal_constant_time(std::span<std::byte const, Extent> a, std::span<std::byte const, Extent> b) noexcept {
+			return MathEngine_Hwy<Bits>::equal_constant_time(a, b);
+		}
+	};
+
+} // namespace dice::hash::lthash
+
+#endif//DICE_HASH_MATHENGINE_HWYNATIVE_HPP
@@ -0,0 +1,540 @@
+#ifndef DICE_HASH_PERSISTENTLTHASHMAP_HPP
+#define DICE_HASH_PERSISTENTLTHASHMAP_HPP
+
+#include "dice/hash/lthash/LtHash.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace dice::hash::lthash {
+
+	/**
+	 * @brief PersistBarrier for memory that does not need to be flushed explicitly (e.g. volatile memory, or if losing
+	 * 		updates that the OS has not written back yet is acceptable)
+	 */
+	struct NoPersistBarrier {
+		void operator()(std::span<std::byte const>) const noexcept {
+		}
+	};
+
+	/**
+	 * @brief A map from partition id to LtHash checksum (all sharing a single key) that is meant to live in a persistent
+	 * 		memory segment (e.g. constructed by a metall::manager with its allocator) and is updated in place.
+	 *
+	 * Every partition stores two checksum slots and an epoch word, slot (epoch & 1) holds the committed checksum.
+	 * An update writes the new checksum to the other slot and only then publishes it by incrementing the epoch
+	 * (a single aligned 8 byte store). Thus, if the process dies in the middle of an update, reopening the segment
+	 * finds either the old or the new checksum, never a torn one, and nothing has to be recomputed.
+	 *
+	 * If the segment must also survive power loss, PersistBarrier is used to write back the new slot before the epoch
+	 * is published and the epoch afterwards (e.g. with msync or clwb + sfence). It is called with the modified bytes.
+	 *
+	 * The table uses open addressing with linear probing and grows by rehashing into a new table, which is committed
+	 * by a single pointer store as well. The map records the table under construction and the table being replaced before
+	 * they are allocated or released, so that the next insertion (or the destructor) reclaims them if growing was interrupted.
+	 * A table is forgotten right before it is released (so it is never released twice), thus only an interruption inside
+	 * the allocator or between these two steps can leak it. A new partition is inserted in three ordered steps: the size of the table is marked
+	 * as being updated, the id is written to the entry and finally the incremented size is published (clearing the mark).
+	 * If the process dies in between, the next access finds the mark and recounts the occupied entries.
+	 *
+	 * @note the key is stored in the segment
+	 * @note not thread-safe; concurrent access has to be synchronized externally
+	 * @note every partition produces the same checksum as an LtHash<n_bits_per_elem, n_elems, HashT, MathEngineT> with the same key
+	 * 		that saw the same operations
+	 * @tparam Allocator allocator for the table, e.g. metall::manager::allocator_type<std::byte>
+	 * @tparam PersistBarrier callable with std::span<std::byte const>; invoked on every write that has to reach the backing storage in order
+	 */
+	template<size_t n_bits_per_elem, size_t n_elems, template<size_t> typename HashT = blake3::Blake3,
+			 template<typename> typename MathEngineT = DefaultMathEngine, typename Allocator = std::allocator<std::byte>,
+			 typename PersistBarrier = NoPersistBarrier>
+	struct PersistentLtHashMap {
+		using lthash_type = LtHash<n_bits_per_elem, n_elems, HashT, MathEngineT>;
+		using partition_id = uint64_t;
+
+		static constexpr bool needs_padding = lthash_type::needs_padding;
+		static constexpr size_t element_bits = lthash_type::element_bits;
+		static constexpr size_t element_count = lthash_type::element_count;
+		static constexpr size_t checksum_len = lthash_type::checksum_len;
+
+		static constexpr size_t default_initial_capacity = 16;
+
+	private:
+		using Bits = detail::Bits<n_bits_per_elem>;
+		using MathEngine = MathEngineT<Bits>;
+		using Hash = HashT<checksum_len>;
+
+		static constexpr partition_id empty_slot = 0; // entries store id + 1
+
+		static_assert(std::atomic<uint64_t>::is_always_lock_free);
+
+		// only needs the alignment of uint64_t, segment allocators do not necessarily support over-aligned types
+		struct Entry {
+			uint64_t stored_id = empty_slot;
+			std::atomic<uint64_t> epoch{0};
+			alignas(MathEngine::min_buffer_align) std::array<std::array<std::byte, checksum_len>, 2> slots{};
+
+			[[nodiscard]] std::span<std::byte const, checksum_len> committed() const noexcept {
+				return slots[epoch.load(std::memory_order_acquire) & 1];
+			}
+		};
+
+		using entry_alloc_traits = typename std::allocator_traits<Allocator>::template rebind_traits<Entry>;
+		using entry_allocator = typename entry_alloc_traits::allocator_type;
+		using entry_pointer = typename entry_alloc_traits::pointer;
+
+		struct Table {
+			entry_pointer entries;
+			size_t capacity; // power of two
+			size_t size;     // number of partitions, or'ed with size_update_pending while an insertion is in progress
+		};
+
+		static constexpr size_t size_update_pending = size_t{1} << (sizeof(size_t) * 8 - 1);
+
+		using table_alloc_traits = typename std::allocator_traits<Allocator>::template rebind_traits<Table>;
+		using table_allocator = typename table_alloc_traits::allocator_type;
+		using table_pointer = typename table_alloc_traits::pointer;
+
+		[[no_unique_address]] Allocator alloc_;
+		table_pointer table_ = nullptr;
+		table_pointer pending_table_ = nullptr; // table being built by grow(), owned by the map until it is published in table_
+		table_pointer retired_table_ = nullptr; // table being replaced by grow(), owned by the map once it is no longer table_
+		detail::Key<Hash::min_key_extent, Hash::max_key_extent> key_;
+
+		static void persist(void const *data, size_t len) noexcept(noexcept(PersistBarrier{}(std::span<std::byte const>{}))) {
+			PersistBarrier{}(std::span<std::byte const>{static_cast<std::byte const *>(data), len});
+		}
+
+		/**
+		 * @brief finalizer of splitmix64, spreads consecutive partition ids over the table
+		 */
+		static constexpr uint64_t mix(uint64_t x) noexcept {
+			x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9;
+			x = (x ^ (x >> 27)) * 0x94D049BB133111EB;
+			return x ^ (x >> 31);
+		}
+
+		[[nodiscard]] static Entry *entries(Table const &table) noexcept {
+			return std::to_address(table.entries);
+		}
+
+		/**
+		 * @return the entry of id or the empty entry where it would be inserted
+		 */
+		[[nodiscard]] static Entry &probe(Table const &table, partition_id id) noexcept {
+			auto const mask = table.capacity - 1;
+			for (auto ix = mix(id) & mask;; ix = (ix + 1) & mask) {
+				auto &entry = entries(table)[ix];
+				if (entry.stored_id == id + 1 || entry.stored_id == empty_slot) {
+					return entry;
+				}
+			}
+		}
+
+		/**
+		 * @brief allocates an empty table with the given capacity and stores it in owner.
+		 * 		owner is written (and persisted) before the entries are allocated, so that an interrupted allocation can be reclaimed.
+		 */
+		void allocate_table(table_pointer &owner, size_t capacity) {
+			table_allocator table_alloc{alloc_};
+			entry_allocator entry_alloc{alloc_};
+
+			auto const table = table_alloc_traits::allocate(table_alloc, 1);
+			table_alloc_traits::construct(table_alloc, std::to_address(table), Table{nullptr, capacity, 0});
+			owner = table;
+			persist(&owner, sizeof(owner));
+
+			try {
+				table->entries = entry_alloc_traits::allocate(entry_alloc, capacity);
+			} catch (...) {
+				owner = nullptr;
+				persist(&owner, sizeof(owner));
+				deallocate_table(table);
+				throw;
+			}
+			persist(std::to_address(table), sizeof(Table));
+
+			for (size_t ix = 0; ix < capacity; ++ix) {
+				entry_alloc_traits::construct(entry_alloc, entries(*table) + ix);
+			}
+		}
+
+		// tables may be reclaimed after an interruption before all of their entries were constructed
+		static_assert(std::is_trivially_destructible_v<Entry>);
+
+		void deallocate_table(table_pointer table) noexcept {
+			table_allocator table_alloc{alloc_};
+			entry_allocator entry_alloc{alloc_};
+
+			if (table->entries != nullptr) {
+				for (size_t ix = 0; ix < table->capacity; ++ix) {
+					entry_alloc_traits::destroy(entry_alloc, entries(*table) + ix);
+				}
+				entry_alloc_traits::deallocate(entry_alloc, table->entries, table->capacity);
+			}
+			table_alloc_traits::destroy(table_alloc, std::to_address(table));
+			table_alloc_traits::deallocate(table_alloc, table, 1);
+		}
+
+		/**
+		 * @brief releases owner if it is not the published table (and forgets it either way).
+		 * 		owner is cleared before the table is released, so that an interruption leaks the table instead of releasing it twice.
+		 */
+		void release_unless_published(table_pointer &owner) {
+			auto const table = std::exchange(owner, nullptr);
+			persist(&owner, sizeof(owner));
+			if (table != nullptr && table != table_) {
+				deallocate_table(table);
+			}
+		}
+
+		/**
+		 * @brief reclaims the tables of a grow() that was interrupted (i.e. the process died before it finished)
+		 */
+		void reclaim_tables() {
+			if (pending_table_ != nullptr || retired_table_ != nullptr) [[unlikely]] {
+				release_unless_published(pending_table_);
+				release_unless_published(retired_table_);
+			}
+		}
+
+		/**
+		 * @brief moves all partitions into a table with twice the capacity; the old table stays intact until the new one is published.
+		 * 		Both tables are recorded in the map, the one that is not table_ when grow is interrupted is reclaimed by reclaim_tables.
+		 */
+		void grow() {
+			auto const old_table = table_;
+			retired_table_ = old_table;
+			persist(&retired_table_, sizeof(retired_table_));
+
+			allocate_table(pending_table_, old_table->capacity * 2);
+			auto const new_table = pending_table_;
+
+			for (size_t ix = 0; ix < old_table->capacity; ++ix) {
+				auto const &src = entries(*old_table)[ix];
+				if (src.stored_id == empty_slot) {
+					continue;
+				}
+
+				auto const epoch = src.epoch.load(std::memory_order_relaxed);
+				auto &dst = probe(*new_table, src.stored_id - 1);
+				dst.stored_id = src.stored_id;
+				dst.slots[epoch & 1] = src.slots[epoch & 1];
+				dst.epoch.store(epoch, std::memory_order_relaxed);
+				++new_table->size;
+			}
+
+			persist(entries(*new_table), new_table->capacity * sizeof(Entry));
+			persist(std::to_address(new_table), sizeof(Table));
+
+			std::atomic_thread_fence(std::memory_order_release);
+			table_ = new_table;
+			persist(&table_, sizeof(table_));
+
+			release_unless_published(pending_table_);
+			release_unless_published(retired_table_);
+		}
+
+		[[nodiscard]] static size_t count_partitions(Table const &table) noexcept {
+			return static_cast<size_t>(std::count_if(entries(table), entries(table) + table.capacity, [](Entry const &entry) noexcept {
+				return entry.stored_id != empty_slot;
+			}));
+		}
+
+		/**
+		 * @brief recounts the partitions if an insertion was interrupted (i.e. the process died between writing the id and the size)
+		 */
+		void repair_size() {
+			if (table_->size & size_update_pending) [[unlikely]] {
+				table_->size = count_partitions(*table_);
+				persist(&table_->size, sizeof(table_->size));
+			}
+		}
+
+		/**
+		 * @return the entry of id, inserts an empty partition if there is none
+		 */
+		Entry &find_or_insert(partition_id id) {
+			if (id + 1 == empty_slot) [[unlikely]] {
+				throw std::invalid_argument{"Invalid partition id"};
+			}
+
+			if (auto &entry = probe(*table_, id); entry.stored_id != empty_slot) [[likely]] {
+				return entry;
+			}
+
+			reclaim_tables();
+			repair_size();
+
+			// keep the load factor <= 1/2
+			if ((table_->size + 1) * 2 > table_->capacity) {
+				grow();
+			}
+
+			// an unused entry holds two empty checksums, so it is a valid (empty) partition as soon as the id is set.
+			// The size is marked before and published after the id, so that an interruption at any point can be detected.
+			auto &entry = probe(*table_, id);
+			auto const size = table_->size;
+			table_->size = size | size_update_pending;
+			persist(&table_->size, sizeof(table_->size));
+
+			entry.stored_id = id + 1;
+			persist(&entry.stored_id, sizeof(entry.stored_id));
+
+			table_->size = size + 1;
+			persist(&table_->size, sizeof(table_->size));
+			return entry;
+		}
+
+		[[nodiscard]] Entry const &find(partition_id id) const {
+			auto const &entry = probe(*table_, id);
+			if (entry.stored_id == empty_slot || id + 1 == empty_slot) [[unlikely]] {
+				throw std::out_of_range{"Unknown partition id"};
+			}
+			return entry;
+		}
+
+		/**
+		 * @brief computes the next checksum of entry in the inactive slot and then publishes it
+		 */
+		template<typename F>
+		static void update(Entry &entry, F &&apply) noexcept(noexcept(persist(nullptr, 0))) {
+			auto const epoch = entry.epoch.load(std::memory_order_relaxed);
+			auto const &current = entry.slots[epoch & 1];
+			auto &next = entry.slots[(epoch + 1) & 1];
+
+			next = current;
+			std::forward<F>(apply)(std::span<std::byte, checksum_len>{next});
+			persist(next.data(), next.size());
+
+			entry.epoch.store(epoch + 1, std::memory_order_release);
+			persist(&entry.epoch, sizeof(entry.epoch));
+		}
+
+		void hash_object(std::span<std::byte, checksum_len> out, std::span<std::byte const> obj) const noexcept {
+			Hash::hash_single(obj, out, key_.get());
+
+			if constexpr (needs_padding) {
+				MathEngine::clear_padding_bits(out);
+			}
+		}
+
+		void check_key(lthash_type const &other) const {
+			if (!other.key_equal(key_.get())) [[unlikely]] {
+				throw std::invalid_argument{"Cannot combine hashes with different keys"};
+			}
+		}
+
+	public:
+		/**
+		 * @brief Creates an empty map
+		 * @param initial_capacity number of partitions the table has room for before it grows (rounded up to a power of two)
+		 */
+		explicit PersistentLtHashMap(Allocator const &alloc = Allocator{}, size_t initial_capacity = default_initial_capacity)
+			: alloc_{alloc} {
+			allocate_table(table_, std::bit_ceil(std::max<size_t>(initial_capacity, 1) * 2));
+		}
+
+		PersistentLtHashMap(PersistentLtHashMap const &) = delete;
+		PersistentLtHashMap &operator=(PersistentLtHashMap const &) = delete;
+
+		~PersistentLtHashMap() noexcept {
+			key_.clear();
+			// left over by an interrupted grow()
+			if (pending_table_ != nullptr && pending_table_ != table_) {
+				deallocate_table(pending_table_);
+			}
+			if (retired_table_ != nullptr && retired_table_ != table_) {
+				deallocate_table(retired_table_);
+			}
+			deallocate_table(table_);
+		}
+
+		[[nodiscard]] Allocator get_allocator() const noexcept {
+			return alloc_;
+		}
+
+		/**
+		 * @return number of partitions
+		 */
+		[[nodiscard]] size_t size() const noexcept {
+			if (table_->size & size_update_pending) [[unlikely]] {
+				return count_partitions(*table_); // an insertion was interrupted, the next insertion repairs the stored size
+			}
+			return table_->size;
+		}
+
+		[[nodiscard]] bool contains(partition_id id) const noexcept {
+			return id + 1 != empty_slot && probe(*table_, id).stored_id != empty_slot;
+		}
+
+		/**
+		 * @brief Checks if the shared key is equal to the given key
+		 * @note this function is not secured against timing attacks
+		 */
+		[[nodiscard]] bool key_equal(std::span<std::byte const> other_key) const noexcept {
+			auto const this_key = key_.get();
+			return std::equal(this_key.begin(), this_key.end(), other_key.begin(), other_key.end());
+		}
+
+		/**
+		 * @brief Sets the key shared by all partitions; securely erases the old key
+		 * @note existing checksums are not rehashed, so this should only be called while the map is empty
+		 * @throws std::invalid_argument if key.size() is not in Hash::min_key_extent..Hash::max_key_extent (inclusive); only if supplied_key_len == std::dynamic_extent
+		 */
+		template<size_t supplied_key_len>
+			requires (supplied_key_len == std::dynamic_extent || (supplied_key_len >= Hash::min_key_extent
+																 && supplied_key_len <= Hash::max_key_extent))
+		void set_key(std::span<std::byte const, supplied_key_len> key) noexcept(supplied_key_len != std::dynamic_extent) {
+			if constexpr (supplied_key_len == std::dynamic_extent) {
+				if (key.size() < Hash::min_key_extent || key.size() > Hash::max_key_extent) [[unlikely]] {
+					throw std::invalid_argument{"Invalid key size"};
+				}
+			}
+
+			key_.set_unchecked(key);
+			persist(&key_, sizeof(key_));
+		}
+
+		/**
+		 * @brief Creates an empty partition id if it does not exist yet
+		 * @throws std::invalid_argument if id is the maximum uint64_t
+		 */
+		void insert(partition_id id) {
+			find_or_insert(id);
+		}
+
+		/**
+		 * @brief Adds a single object to partition id (creating the partition if necessary)
+		 * @throws std::invalid_argument if id is the maximum uint64_t
+		 */
+		PersistentLtHashMap &add(partition_id id, std::span<std::byte const> obj) {
+			alignas(MathEngine::min_buffer_align) std::array<std::byte, checksum_len> obj_hash;
+			hash_object(obj_hash, obj);
+
+			update(find_or_insert(id), [&](std::span<std::byte, checksum_len> next) noexcept {
+				MathEngine::add(next, std::span<std::byte const, checksum_len>{obj_hash});
+			});
+			return *this;
+		}
+
+		/**
+		 * @brief Removes a single object from partition id (creating the partition if necessary)
+		 * @throws std::invalid_argument if id is the maximum uint64_t
+		 */
+		PersistentLtHashMap &remove(partition_id id, std::span<std::byte const> obj) {
+			alignas(MathEngine::min_buffer_align) std::array<std::byte, checksum_len> obj_hash;
+			hash_object(obj_hash, obj);
+
+			update(find_or_insert(id), [&](std::span<std::byte, checksum_len> next) noexcept {
+				MathEngine::sub(next, std::span<std::byte const, checksum_len>{obj_hash});
+			});
+			return *this;
+		}
+
+		/**
+		 * @brief Adds other to partition id (creating the partition if necessary)
+		 * @throws std::invalid_argument if other does not have the same key as *this or id is the maximum uint64_t
+		 */
+		PersistentLtHashMap &combine_add(partition_id id, lthash_type const &other) {
+			check_key(other);
+			update(find_or_insert(id), [&](std::span<std::byte, checksum_len> next) noexcept {
+				MathEngine::add(next, other.checksum());
+			});
+			return *this;
+		}
+
+		/**
+		 * @brief Removes other from partition id (creating the partition if necessary)
+		 * @throws std::invalid_argument if other does not have the same key as *this or id is the maximum uint64_t
+		 */
+		PersistentLtHashMap &combine_remove(partition_id id, lthash_type const &other) {
+			check_key(other);
+			update(find_or_insert(id), [&](std::span<std::byte, checksum_len> next) noexcept {
+				MathEngine::sub(next, other.checksum());
+			});
+			return *this;
+		}
+
+		/**
+		 * @brief Explicitly sets the checksum of partition id (creating the partition if necessary)
+		 * @throws std::invalid_argument if new_checksum has invalid padding or id is the maximum uint64_t
+		 */
+		void set_checksum(partition_id id, std::span<std::byte const, checksum_len> new_checksum) {
+			if constexpr (needs_padding) {
+				if (!MathEngine::check_padding_bits(new_checksum)) [[unlikely]] {
+					throw std::invalid_argument{"Invalid checksum: found non-zero padding bits"};
+				}
+			}
+
+			update(find_or_insert(id), [&](std::span<std::byte, checksum_len> next) noexcept {
+				std::copy(new_checksum.begin(), new_checksum.end(), next.begin());
+			});
+		}
+
+		/**
+		 * @return the committed checksum of partition id
+		 * @throws std::out_of_range if there is no partition id
+		 */
+		[[nodiscard]] std::span<std::byte const, checksum_len> checksum(partition_id id) const {
+			return find(id).committed();
+		}
+
+		/**
+		 * @return the number of committed updates of partition id
+		 * @throws std::out_of_range if there is no partition id
+		 */
+		[[nodiscard]] uint64_t epoch(partition_id id) const {
+			return find(id).epoch.load(std::memory_order_acquire);
+		}
+
+		/**
+		 * @return an LtHash with the key of *this and the checksum of partition id
+		 * @throws std::out_of_range if there is no partition id
+		 */
+		[[nodiscard]] lthash_type get(partition_id id) const {
+			lthash_type ret{checksum(id)};
+			ret.set_key(key_.get());
+			return ret;
+		}
+
+		/**
+		 * @brief Calls f(id, checksum) for every partition (in unspecified order)
+		 */
+		template<typename F>
+		void for_each(F &&f) const {
+			for (size_t ix = 0; ix < table_->capacity; ++ix) {
+				auto const &entry = entries(*table_)[ix];
+				if (entry.stored_id != empty_slot) {
+					f(entry.stored_id - 1, entry.committed());
+				}
+			}
+		}
+
+		/**
+		 * @return an LtHash with the key of *this representing the union of all partitions
+		 */
+		[[nodiscard]] lthash_type aggregate() const noexcept {
+			alignas(MathEngine::min_buffer_align) std::array<std::byte, checksum_len> sum{};
+			for_each([&](partition_id, std::span<std::byte const, checksum_len> checksum) noexcept {
+				MathEngine::add(std::span<std::byte, checksum_len>{sum}, checksum);
+			});
+
+			lthash_type ret{sum};
+			ret.set_key(key_.get());
+			return ret;
+		}
+	};
+
+} // namespace dice::hash::lthash
+
+#endif//DICE_HASH_PERSISTENTLTHASHMAP_HPP
@@ -0,0 +1,213 @@
+#ifndef DICE_HASH_SEQLOCKLTHASH_HPP
+#define DICE_HASH_SEQLOCKLTHASH_HPP
+
+#include "dice/hash/lthash/LtHash.hpp"
+
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <span>
+#include <utility>
+
+namespace dice::hash::lthash {
+
+	/**
+	 * @brief Wraps an LtHash such that any number of readers can take consistent copies of its checksum while it is being updated.
+	 *
+	 * Every update (add, remove, combine_add, combine_remove, set_checksum, update) publishes the new checksum
+	 * under a sequence lock and increments the epoch. Readers never block writers: a reader copies the published checksum
+	 * and retries if a publication happened during the copy. Updates are serialized among each other.
+	 *
+	 * epoch()/changed_since() allow pollers to skip copying the checksum if nothing happened since their last snapshot.
+	 *
+	 * @tparam LtHashT the LtHash type, e.g. LtHash16
+	 * @note the key of the wrapped LtHash is fixed at construction
+	 */
+	template<typename LtHashT>
+	struct SeqLockLtHash {
+		using lthash_type = LtHashT;
+		static constexpr size_t checksum_len = LtHashT::checksum_len;
+
+		/**
+		 * @brief a consistent copy of the checksum and the epoch it was published in
+		 */
+		struct Snapshot {
+			uint64_t epoch;
+			alignas(LtHashT::checksum_align) std::array<std::byte, checksum_len> checksum;
+		};
+
+	private:
+		static constexpr size_t n_words = checksum_len / sizeof(uint64_t);
+		static constexpr size_t cache_line_size = 64;
+
+		using MathEngine = typename LtHashT::MathEngine;
+
+		// seq_ is odd while a publication is in progress, seq_ / 2 is the epoch
+		alignas(cache_line_size) std::atomic<uint64_t> seq_{0};
+		alignas(cache_line_size) std::array<std::atomic<uint64_t>, n_words> published_;
+
+		alignas(cache_line_size) std::mutex writer_mutex_;
+		LtHashT lthash_; // only accessed with writer_mutex_ held (except for the key, which is immutable)
+
+		void store_published() noexcept {
+			auto const checksum = lthash_.checksum();
+			for (size_t ix = 0; ix < n_words; ++ix) {
+				uint64_t word;
+				std::memcpy(&word, checksum.data() + ix * sizeof(uint64_t), sizeof(uint64_t));
+				published_[ix].store(word, std::memory_order_relaxed);
+			}
+		}
+
+		void publish() noexcept {
+			auto const seq = seq_.load(std::memory_order_relaxed);
+			seq_.store(seq + 1, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_release);
+			store_published();
+			seq_.store(seq + 2, std::memory_order_release);
+		}
+
+	public:
+		/**
+		 * @brief Wraps initial, the key of initial is used to hash objects
+		 */
+		explicit SeqLockLtHash(LtHashT initial = LtHashT{}) noexcept : lthash_{std::move(initial)} {
+			store_published();
+		}
+
+		SeqLockLtHash(SeqLockLtHash const &) = delete;
+		SeqLockLtHash &operator=(SeqLockLtHash const &) = delete;
+
+		/**
+		 * @return the number of updates published so far
+		 */
+		[[nodiscard]] uint64_t epoch() const noexcept {
+			return seq_.load(std::memory_order_acquire) / 2;
+		}
+
+		/**
+		 * @return true if an update was published after epoch
+		 */
+		[[nodiscard]] bool changed_since(uint64_t epoch) const noexcept {
+			return this->epoch() != epoch;
+		}
+
+		/**
+		 * @brief Tries to copy the published checksum once
+		 * @return false if an update was published concurrently (out is unspecified in this case)
+		 */
+		[[nodiscard]] bool try_snapshot(Snapshot &out) const noexcept {
+			auto const seq_before = seq_.load(std::memory_order_acquire);
+			if (seq_before % 2 != 0) {
+				return false;
+			}
+
+			for (size_t ix = 0; ix < n_words; ++ix) {
+				auto const word = published_[ix].load(std::memory_order_relaxed);
+				std::memcpy(out.checksum.data() + ix * sizeof(uint64_t), &word, sizeof(uint64_t));
+			}
+
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if (seq_.load(std::memory_order_relaxed) != seq_before) {
+				return false;
+			}
+
+			out.epoch = seq_before / 2;
+			return true;
+		}
+
+		/**
+		 * @return a consistent copy of the most recently published checksum
+		 */
+		[[nodiscard]] Snapshot snapshot() const noexcept {
+			Snapshot ret;
+			while (!try_snapshot(ret)) {
+			}
+			return ret;
+		}
+
+		/**
+		 * @brief Takes a snapshot only if an update was published after epoch
+		 * @return true if out was updated
+		 */
+		[[nodiscard]] bool snapshot_if_changed(uint64_t epoch, Snapshot &out) const noexcept {
+			if (!changed_since(epoch)) {
+				return false;
+			}
+
+			out = snapshot();
+			return true;
+		}
+
+		/**
+		 * @return an LtHash with the key of the wrapped LtHash and the most recently published checksum
+		 */
+		[[nodiscard]] LtHashT get() const noexcept {
+			auto const snap = snapshot();
+			LtHashT ret{snap.checksum};
+			ret.key_ = lthash_.key_;
+			return ret;
+		}
+
+		/**
+		 * @brief Applies f to the wrapped LtHash and publishes the result once (i.e. as a single epoch)
+		 * @param f callable with signature void(LtHashT &); must not change the key
+		 * @throws std::system_error if the writer mutex cannot be locked; anything f throws
+		 */
+		template<typename F>
+		void update(F &&f) {
+			std::lock_guard lock{writer_mutex_};
+			try {
+				std::forward<F>(f)(lthash_);
+			} catch (...) {
+				publish(); // f might have modified the checksum before throwing
+				throw;
+			}
+			publish();
+		}
+
+		/**
+		 * @throws std::system_error if the writer mutex cannot be locked
+		 */
+		void add(std::span<std::byte const> obj) {
+			update([obj](LtHashT &h) noexcept { h.add(obj); });
+		}
+
+		/**
+		 * @throws std::system_error if the writer mutex cannot be locked
+		 */
+		void remove(std::span<std::byte const> obj) {
+			update([obj](LtHashT &h) noexcept { h.remove(obj); });
+		}
+
+		/**
+		 * @throws std::invalid_argument if other has a different key
+		 * @throws std::system_error if the writer mutex cannot be locked
+		 */
+		void combine_add(LtHashT const &other) {
+			update([&other](LtHashT &h) { h.combine_add(other); });
+		}
+
+		/**
+		 * @throws std::invalid_argument if other has a different key
+		 * @throws std::system_error if the writer mutex cannot be locked
+		 */
+		void combine_remove(LtHashT const &other) {
+			update([&other](LtHashT &h) { h.combine_remove(other); });
+		}
+
+		/**
+		 * @throws std::invalid_argument if new_checksum has invalid padding; only if LtHashT::needs_padding (the checksum is still set, like LtHash::set_checksum)
+		 * @throws std::system_error if the writer mutex cannot be locked
+		 */
+		void set_checksum(std::span<std::byte const, checksum_len> new_checksum) {
+			update([new_checksum](LtHashT &h) { h.set_checksum(new_checksum); });
+		}
+	};
+
+} // namespace dice::hash::lthash
+
+#endif//DICE_HASH_SEQLOCKLTHASH_HPP
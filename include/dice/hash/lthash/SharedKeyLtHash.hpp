@@ -0,0 +1,285 @@
+#ifndef DICE_HASH_SHAREDKEYLTHASH_HPP
+#define DICE_HASH_SHAREDKEYLTHASH_HPP
+
+#include "dice/hash/lthash/LtHash.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <utility>
+
+namespace dice::hash::lthash {
+
+	/**
+	 * @brief An immutable, reference counted key for SharedKeyLtHash.
+	 * 		The key material is securely erased exactly once, when the last reference is released.
+	 * 		A default constructed SharedKey represents the default key of LtHash (i.e. the key of an LtHash on which set_key was never called).
+	 */
+	template<size_t min_key_extent, size_t max_key_extent>
+	class SharedKey {
+		using Key = detail::Key<min_key_extent, max_key_extent>;
+
+		struct Storage {
+			Key key;
+
+			Storage() = default;
+			Storage(Storage const &) = delete;
+			Storage &operator=(Storage const &) = delete;
+
+			~Storage() {
+				key.clear();
+			}
+		};
+
+		static constexpr Key default_key{};
+
+		std::shared_ptr<Storage const> storage_;
+
+	public:
+		/**
+		 * @brief the default key
+		 */
+		SharedKey() noexcept = default;
+
+		/**
+		 * @brief Creates a new key object holding a copy of key
+		 * @throws std::invalid_argument if key.size() is not in min_key_extent..max_key_extent (inclusive); only if supplied_key_len == std::dynamic_extent
+		 * @throws std::bad_alloc if the key object cannot be allocated
+		 */
+		template<size_t supplied_key_len>
+			requires (supplied_key_len == std::dynamic_extent || (supplied_key_len >= min_key_extent
+																 && supplied_key_len <= max_key_extent))
+		explicit SharedKey(std::span<std::byte const, supplied_key_len> key) {
+			if constexpr (supplied_key_len == std::dynamic_extent) {
+				if (key.size() < min_key_extent || key.size() > max_key_extent) [[unlikely]] {
+					throw std::invalid_argument{"Invalid key size"};
+				}
+			}
+
+			auto storage = std::make_shared<Storage>();
+			if constexpr (min_key_extent == max_key_extent) {
+				storage->key.set_unchecked(std::span<std::byte const, max_key_extent>{key.data(), max_key_extent});
+			} else {
+				storage->key.set_unchecked(key);
+			}
+			storage_ = std::move(storage);
+		}
+
+		[[nodiscard]] auto get() const noexcept {
+			return storage_ != nullptr ? storage_->key.get() : default_key.get();
+		}
+
+		/**
+		 * @return true if *this and other refer to the same key object (or are both the default key)
+		 */
+		[[nodiscard]] bool same_object(SharedKey const &other) const noexcept {
+			return storage_ == other.storage_;
+		}
+
+		/**
+		 * @brief Checks if *this and other represent the same key.
+		 * 		This is a pointer comparison if both refer to the same key object, the bytes are only compared otherwise.
+		 * @note this function is not secured against timing attacks
+		 */
+		[[nodiscard]] bool operator==(SharedKey const &other) const noexcept {
+			if (same_object(other)) [[likely]] {
+				return true;
+			}
+
+			auto const this_key = get();
+			auto const other_key = other.get();
+			return std::equal(this_key.begin(), this_key.end(), other_key.begin(), other_key.end());
+		}
+	};
+
+	/**
+	 * @brief LtHash variant that refers to a SharedKey instead of embedding a copy of its key.
+	 * 		Copies and moves do not copy or erase key material and combine_add/combine_remove check
+	 * 		the keys with a pointer comparison in the common case (both hashes use the same key object).
+	 *
+	 * @note produces the same checksums as LtHash<n_bits_per_elem, n_elems, HashT, MathEngineT> with the same key
+	 */
+	template<size_t n_bits_per_elem, size_t n_elems, template<size_t> typename HashT = blake3::Blake3, template<typename> typename MathEngineT = DefaultMathEngine>
+	struct SharedKeyLtHash {
+		using lthash_type = LtHash<n_bits_per_elem, n_elems, HashT, MathEngineT>;
+
+		static constexpr bool needs_padding = lthash_type::needs_padding;
+		static constexpr size_t element_bits = lthash_type::element_bits;
+		static constexpr size_t element_count = lthash_type::element_count;
+		static constexpr size_t checksum_len = lthash_type::checksum_len;
+		static constexpr size_t checksum_align = lthash_type::checksum_align;
+
+		static constexpr std::array<std::byte, checksum_len> default_checksum{};
+
+	private:
+		using Bits = detail::Bits<n_bits_per_elem>;
+		using MathEngine = MathEngineT<Bits>;
+		using Hash = HashT<checksum_len>;
+
+	public:
+		using key_type = SharedKey<Hash::min_key_extent, Hash::max_key_extent>;
+
+	private:
+		key_type key_;
+		alignas(checksum_align) std::array<std::byte, checksum_len> checksum_;
+
+		void hash_object(std::span<std::byte, checksum_len> out, std::span<std::byte const> obj) const noexcept {
+			Hash::hash_single(obj, out, key_.get());
+
+			if constexpr (needs_padding) {
+				MathEngine::clear_padding_bits(out);
+			}
+		}
+
+		void check_key(SharedKeyLtHash const &other) const {
+			if (key_ != other.key_) [[unlikely]] {
+				throw std::invalid_argument{"Cannot combine hashes with different keys"};
+			}
+		}
+
+	public:
+		/**
+		 * @brief construct a SharedKeyLtHash using the (optionally) given key and initial_checksum
+		 */
+		explicit SharedKeyLtHash(key_type key = {}, std::span<std::byte const, checksum_len> initial_checksum = default_checksum) noexcept
+			: key_{std::move(key)} {
+			std::copy(initial_checksum.begin(), initial_checksum.end(), checksum_.begin());
+		}
+
+		[[nodiscard]] key_type const &key() const noexcept {
+			return key_;
+		}
+
+		/**
+		 * @brief Replaces the key; the old key object is erased if this was its last reference
+		 */
+		void set_key(key_type key) noexcept {
+			key_ = std::move(key);
+		}
+
+		/**
+		 * @brief Checks if *this and other have the same key
+		 * @note this function is not secured against timing attacks
+		 */
+		[[nodiscard]] bool key_equal(SharedKeyLtHash const &other) const noexcept {
+			return key_ == other.key_;
+		}
+
+		[[nodiscard]] std::span<std::byte const, checksum_len> checksum() const noexcept {
+			return checksum_;
+		}
+
+		/**
+		 * @brief Checks if this->checksum() is equal to other_checksum (i.e. represent the same multiset)
+		 * @note this function is _not_ secured against timing attacks
+		 */
+		[[nodiscard]] bool checksum_equal(std::span<std::byte const, checksum_len> other_checksum) const noexcept {
+			if constexpr (ComparingMathEngine<MathEngine>) {
+				if (reinterpret_cast<uintptr_t>(other_checksum.data()) % checksum_align == 0) {
+					return MathEngine::equal(checksum(), other_checksum);
+				}
+			}
+			return std::equal(checksum_.begin(), checksum_.end(), other_checksum.begin());
+		}
+
+		/**
+		 * @brief Checks if this->checksum() is equal to other_checksum (i.e. represent the same multiset)
+		 * @note this function is secured against timing attacks
+		 */
+		[[nodiscard]] bool checksum_equal_constant_time(std::span<std::byte const, checksum_len> other_checksum) const noexcept {
+			if constexpr (ComparingMathEngine<MathEngine>) {
+				if (reinterpret_cast<uintptr_t>(other_checksum.data()) % checksum_align == 0) {
+					return MathEngine::equal_constant_time(checksum(), other_checksum);
+				}
+			}
+			return sodium_memcmp(checksum_.data(), other_checksum.data(), checksum_len) == 0;
+		}
+
+		/**
+		 * @brief Explicitly sets the current checksum to the given one
+		 * @throws std::invalid_argument if new_checksum has invalid padding; only if needs_padding
+		 */
+		void set_checksum(std::span<std::byte const, checksum_len> new_checksum) noexcept(!needs_padding) {
+			std::copy(new_checksum.begin(), new_checksum.end(), checksum_.begin());
+			if constexpr (needs_padding) {
+				if (!MathEngine::check_padding_bits(checksum())) [[unlikely]] {
+					throw std::invalid_argument{"Invalid checksum: found non-zero padding bits"};
+				}
+			}
+		}
+
+		/**
+		 * @brief Clears the current checksum
+		 */
+		void clear_checksum() noexcept {
+			std::fill(checksum_.begin(), checksum_.end(), std::byte{0});
+		}
+
+		/**
+		 * @brief Adds another SharedKeyLtHash to *this (via multiset-union)
+		 * @throws std::invalid_argument if !this->key_equal(other)
+		 */
+		SharedKeyLtHash &combine_add(SharedKeyLtHash const &other) {
+			check_key(other);
+			MathEngine::add(std::span<std::byte, checksum_len>{checksum_}, other.checksum());
+			return *this;
+		}
+
+		/**
+		 * @brief Removes another SharedKeyLtHash from *this (via multiset-minus)
+		 * @throws std::invalid_argument if !this->key_equal(other)
+		 */
+		SharedKeyLtHash &combine_remove(SharedKeyLtHash const &other) {
+			check_key(other);
+			MathEngine::sub(std::span<std::byte, checksum_len>{checksum_}, other.checksum());
+			return *this;
+		}
+
+		/**
+		 * @brief Adds a single object to this SharedKeyLtHash instance
+		 */
+		SharedKeyLtHash &add(std::span<std::byte const> obj) noexcept {
+			alignas(MathEngine::min_buffer_align) std::array<std::byte, checksum_len> obj_hash;
+			hash_object(obj_hash, obj);
+			MathEngine::add(std::span<std::byte, checksum_len>{checksum_}, std::span<std::byte const, checksum_len>{obj_hash});
+			return *this;
+		}
+
+		/**
+		 * @brief Removes a single object from this SharedKeyLtHash instance
+		 */
+		SharedKeyLtHash &remove(std::span<std::byte const> obj) noexcept {
+			alignas(MathEngine::min_buffer_align) std::array<std::byte, checksum_len> obj_hash;
+			hash_object(obj_hash, obj);
+			MathEngine::sub(std::span<std::byte, checksum_len>{checksum_}, std::span<std::byte const, checksum_len>{obj_hash});
+			return *this;
+		}
+
+		/**
+		 * @return an equivalent LtHash (with an embedded copy of the key)
+		 */
+		[[nodiscard]] lthash_type to_lthash() const {
+			lthash_type ret{checksum()};
+			ret.set_key(key_.get());
+			return ret;
+		}
+
+		/**
+		 * @brief Checks if *this and other have the same checksum (i.e. represent the same multiset)
+		 * @note this function is _not_ secured against timing attacks
+		 */
+		bool operator==(SharedKeyLtHash const &other) const noexcept {
+			return checksum_equal(other.checksum());
+		}
+
+		bool operator!=(SharedKeyLtHash const &other) const noexcept {
+			return !SharedKeyLtHash::operator==(other);
+		}
+	};
+
+} // namespace dice::hash::lthash
+
+#endif//DICE_HASH_SHAREDKEYLTHASH_HPP
@@ -0,0 +1,66 @@
+#include <catch2/catch_all.hpp>
+#include <dice/hash/blake/Blake2Xb.hpp>
+#include <dice/hash/blake/Blake2b.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace dice::hash;
+
+namespace {
+	template<typename Blake>
+	void benchmark_construct_vs_reset(std::string const &name, size_t input_size) {
+		std::vector<std::byte> input(input_size);
+		std::array<std::byte, 64> output;
+
+		BENCHMARK(name + " hash_single " + std::to_string(input_size) + "b") {
+			Blake::hash_single(input, output);
+			return output;
+		};
+
+		Blake blake;
+		BENCHMARK(name + " reset " + std::to_string(input_size) + "b") {
+			blake.reset();
+			blake.digest(input);
+			std::move(blake).finish(output);
+			return output;
+		};
+	}
+} // namespace
+
+TEST_CASE("Benchmark Blake2b") {
+	for (size_t const input_size : {size_t{16}, size_t{64}, size_t{1024}}) {
+		benchmark_construct_vs_reset<blake2b::Blake2b<64>>("blake2b", input_size);
+		benchmark_construct_vs_reset<blake2xb::Blake2Xb<64>>("blake2xb", input_size);
+	}
+}
+
+TEST_CASE("Benchmark Blake2b construction") {
+	std::array<std::byte, 16> input{};
+	std::array<std::byte, blake2b::default_key_extent> key{};
+	std::array<std::byte, 32> output;
+
+	BENCHMARK("blake2b hash_single 16b keyed") {
+		blake2b::Blake2b<32>::hash_single(input, output, key);
+		return output;
+	};
+
+	BENCHMARK("blake2b noexcept construction 16b keyed") {
+		blake2b::Blake2b<32> blake{key};
+		blake.digest(input);
+		std::move(blake).finish(output);
+		return output;
+	};
+
+	BENCHMARK("blake2xb hash_single 16b keyed") {
+		blake2xb::Blake2Xb<32>::hash_single(input, output, key);
+		return output;
+	};
+
+	BENCHMARK("blake2xb noexcept construction 16b keyed") {
+		blake2xb::Blake2Xb<32> blake{key};
+		blake.digest(input);
+		std::move(blake).finish(output);
+		return output;
+	};
+}
@@ -0,0 +1,104 @@
+#include <catch2/catch_all.hpp>
+#include <dice/hash/blake/Blake3.hpp>
+
+#include <memory>
+#include <string>
+#include <thread>
+
+using namespace dice::hash;
+
+namespace {
+	std::vector<std::byte> make_input(size_t size) {
+		std::vector<std::byte> input;
+		input.resize(size);
+		for (size_t ix = 0; ix < size; ix += 4096) {
+			input[ix] = static_cast<std::byte>(ix >> 12);
+		}
+		return input;
+	}
+
+	std::string size_name(size_t size) {
+		if (size >= (size_t{1} << 30)) {
+			return std::to_string(size >> 30) + " GiB";
+		}
+		return std::to_string(size >> 20) + " MiB";
+	}
+
+	void benchmark_blake3(size_t input_size) {
+		auto const input = make_input(input_size);
+		std::array<std::byte, 32> output;
+
+		BENCHMARK("blake3 serial " + size_name(input_size)) {
+			blake3::Blake3<32> blake;
+			blake.digest(input);
+			std::move(blake).finish(output);
+			return output;
+		};
+
+		for (size_t const threads : {size_t{1}, size_t{2}, size_t{4}, size_t{8}, size_t{std::thread::hardware_concurrency()}}) {
+			ThreadPool pool{threads};
+
+			BENCHMARK("blake3 parallel " + size_name(input_size) + " " + std::to_string(pool.concurrency()) + " threads") {
+				blake3::Blake3<32> blake;
+				blake.digest_parallel(input, pool);
+				std::move(blake).finish(output);
+				return output;
+			};
+		}
+	}
+} // namespace
+
+TEST_CASE("Benchmark Blake3") {
+	for (size_t const size : {size_t{1} << 20, size_t{16} << 20, size_t{256} << 20}) {
+		benchmark_blake3(size);
+	}
+}
+
+TEST_CASE("Benchmark Blake3 huge inputs", "[.]") {
+	for (size_t const size : {size_t{1} << 30, size_t{4} << 30}) {
+		benchmark_blake3(size);
+	}
+}
+
+TEST_CASE("Benchmark Blake3 OutputReader") {
+	auto const input = make_input(size_t{1} << 10);
+
+	blake3::Blake3<> blake;
+	blake.digest(input);
+
+	for (size_t const offset : {size_t{0}, size_t{64} << 10, size_t{1} << 20}) {
+		std::vector<std::byte> full_output(offset + 64);
+		std::array<std::byte, 64> output;
+
+		BENCHMARK("finish " + std::to_string(offset + 64) + "b, keep last 64b") {
+			auto copy = blake;
+			std::move(copy).finish(full_output);
+			return full_output.back();
+		};
+
+		BENCHMARK("OutputReader read 64b at offset " + std::to_string(offset)) {
+			blake.output_reader().read_at(offset, output);
+			return output;
+		};
+	}
+}
+
+TEST_CASE("Benchmark Blake3 reset") {
+	for (size_t const input_size : {size_t{16}, size_t{64}, size_t{1024}}) {
+		auto const input = make_input(input_size);
+		std::array<std::byte, 32> output;
+
+		BENCHMARK("blake3 hash_single " + std::to_string(input_size) + "b") {
+			blake3::Blake3<32>::hash_single(input, output);
+			return output;
+		};
+
+		blake3::Blake3<32> blake;
+		BENCHMARK("blake3 reset " + std::to_string(input_size) + "b") {
+			blake.reset();
+			blake.digest(input);
+			std::move(blake).finish(output);
+			return output;
+		};
+	}
+}
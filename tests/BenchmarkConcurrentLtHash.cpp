@@ -0,0 +1,108 @@
+#include <catch2/catch_all.hpp>
+#include <dice/hash/lthash/ConcurrentLtHash.hpp>
+
+#include "TestLtHash_common.hpp"
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace dice::hash::lthash;
+
+namespace {
+	constexpr size_t n_objects = 64 * 1'000;
+
+	template<typename F>
+	void run_threads(size_t n_threads, F const &f) {
+		std::vector<std::thread> threads;
+		threads.reserve(n_threads);
+		for (size_t t = 0; t < n_threads; ++t) {
+			threads.emplace_back([&f, t, n_threads]() {
+				for (uint64_t ix = t; ix < n_objects; ix += n_threads) {
+					f(as_object(ix));
+				}
+			});
+		}
+		for (auto &thread : threads) {
+			thread.join();
+		}
+	}
+
+	/**
+	 * @brief alternative to ConcurrentLtHash<32, 1024> that updates its shards without locking them,
+	 * 		with one atomic fetch_add per element (and therefore without the vectorized MathEngine::add)
+	 */
+	struct AtomicShardsLtHash32 {
+		static constexpr size_t n_lanes = LtHash32::checksum_len / sizeof(uint32_t);
+
+		struct alignas(64) Shard {
+			std::array<uint32_t, n_lanes> sum{};
+		};
+
+		std::unique_ptr<Shard[]> shards;
+		size_t shard_mask;
+
+		explicit AtomicShardsLtHash32(size_t n_shards)
+			: shards{std::make_unique<Shard[]>(std::bit_ceil(n_shards))},
+			  shard_mask{std::bit_ceil(n_shards) - 1} {
+		}
+
+		void add(std::span<std::byte const> obj) noexcept {
+			static std::atomic<size_t> next_slot{0};
+			static thread_local size_t const slot = next_slot.fetch_add(1, std::memory_order_relaxed);
+
+			std::array<uint32_t, n_lanes> obj_hash;
+			dice::hash::blake3::Blake3<LtHash32::checksum_len>::hash_single(obj, std::as_writable_bytes(std::span<uint32_t, n_lanes>{obj_hash}));
+
+			auto &shard = shards[slot & shard_mask];
+			for (size_t ix = 0; ix < n_lanes; ++ix) {
+				std::atomic_ref<uint32_t>{shard.sum[ix]}.fetch_add(obj_hash[ix], std::memory_order_relaxed);
+			}
+		}
+	};
+} // namespace
+
+TEST_CASE("Benchmark ConcurrentLtHash scalability", "[DiceHash]") {
+	for (size_t const n_threads : {1, 2, 4, 8, 16, 32, 64}) {
+		BENCHMARK("LtHash<20, 1008> with global mutex 64k adds, " + std::to_string(n_threads) + " threads") {
+			LtHash20 h;
+			std::mutex mutex;
+			run_threads(n_threads, [&](std::span<std::byte const> obj) {
+				std::lock_guard lock{mutex};
+				h.add(obj);
+			});
+			return h;
+		};
+
+		BENCHMARK("ConcurrentLtHash<20, 1008> 64k adds, " + std::to_string(n_threads) + " threads") {
+			ConcurrentLtHash<20, 1008> h{n_threads};
+			run_threads(n_threads, [&](std::span<std::byte const> obj) {
+				h.add(obj);
+			});
+			return h.snapshot();
+		};
+
+		BENCHMARK("ConcurrentLtHash<32, 1024> (locked shards) 64k adds, " + std::to_string(n_threads) + " threads") {
+			ConcurrentLtHash<32, 1024> h{n_threads};
+			run_threads(n_threads, [&](std::span<std::byte const> obj) {
+				h.add(obj);
+			});
+			return h.snapshot();
+		};
+
+		BENCHMARK("per-element atomic shards <32, 1024> 64k adds, " + std::to_string(n_threads) + " threads") {
+			AtomicShardsLtHash32 h{n_threads};
+			run_threads(n_threads, [&](std::span<std::byte const> obj) {
+				h.add(obj);
+			});
+			return h.shards[0].sum[0];
+		};
+	}
+}
@@ -0,0 +1,96 @@
+#include <catch2/catch_all.hpp>
+#include <dice/hash.hpp>
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace dice::hash;
+
+namespace {
+	std::vector<std::string> make_strings(size_t count, size_t length) {
+		std::vector<std::string> strs;
+		strs.reserve(count);
+		for (size_t i = 0; i < count; ++i) {
+			auto str = std::to_string(i);
+			str.resize(length, 'x');
+			strs.push_back(std::move(str));
+		}
+		return strs;
+	}
+
+	/**
+	 * @brief hashes every value of values with hasher, the result is the sum of the hashes (so that the hashing is not optimized away)
+	 */
+	template<typename Hasher, typename T>
+	void benchmark_hasher(std::string name, Hasher const &hasher, std::vector<T> const &values) {
+		BENCHMARK(std::move(name)) {
+			size_t sum = 0;
+			for (auto const &value : values) {
+				sum += hasher(value);
+			}
+			return sum;
+		};
+	}
+
+	template<typename T>
+	void benchmark_static_and_seeded(std::string const &type_name, std::vector<T> const &values) {
+		benchmark_hasher("DiceHash<" + type_name + ", wyhash>", DiceHash<T, Policies::wyhash>{}, values);
+		benchmark_hasher("SeededDiceHash<" + type_name + ", seeded_wyhash>", SeededDiceHash<T, Policies::seeded_wyhash>{}, values);
+		benchmark_hasher("DiceHash<" + type_name + ", xxh3>", DiceHash<T, Policies::xxh3>{}, values);
+		benchmark_hasher("SeededDiceHash<" + type_name + ", seeded_xxh3>", SeededDiceHash<T, Policies::seeded_xxh3>{}, values);
+	}
+
+	/**
+	 * @brief compares hashing std::array<T, N> (length known at compile time) with hashing the same data through a std::span<T const> (dynamic length)
+	 */
+	template<typename Policy, typename T, size_t N>
+	void benchmark_fixed_and_dynamic(std::string const &policy_name, std::string const &type_name, size_t count) {
+		std::vector<std::array<T, N>> arrays(count);
+		for (size_t i = 0; i < count; ++i) {
+			for (size_t j = 0; j < N; ++j) {
+				arrays[i][j] = static_cast<T>(i * 31 + j);
+			}
+		}
+		std::vector<std::span<T const>> const spans(arrays.begin(), arrays.end());
+
+		benchmark_hasher("DiceHash<std::array<" + type_name + ", " + std::to_string(N) + ">, " + policy_name + ">",
+						 DiceHash<std::array<T, N>, Policy>{}, arrays);
+		benchmark_hasher("DiceHash<std::span<" + type_name + " const> (" + std::to_string(N) + "), " + policy_name + ">",
+						 DiceHash<std::span<T const>, Policy>{}, spans);
+	}
+
+	template<typename Policy>
+	void benchmark_fixed_sizes(std::string const &policy_name, size_t count) {
+		benchmark_fixed_and_dynamic<Policy, char, 16>(policy_name, "char", count);
+		benchmark_fixed_and_dynamic<Policy, char, 20>(policy_name, "char", count);
+		benchmark_fixed_and_dynamic<Policy, std::byte, 32>(policy_name, "std::byte", count);
+		benchmark_fixed_and_dynamic<Policy, uint64_t, 8>(policy_name, "uint64_t", count);
+	}
+}// namespace
+
+TEST_CASE("Benchmark DiceHash of keys with a length known at compile time", "[DiceHash]") {
+	static constexpr size_t count = 10'000;
+
+	benchmark_fixed_sizes<Policies::Martinus>("Martinus", count);
+	benchmark_fixed_sizes<Policies::wyhash>("wyhash", count);
+}
+
+TEST_CASE("Benchmark SeededDiceHash against the constant seed policies", "[DiceHash]") {
+	static constexpr size_t count = 10'000;
+
+	std::vector<uint64_t> ints(count);
+	for (size_t i = 0; i < count; ++i) {
+		ints[i] = i * 0x9E3779B97F4A7C15UL;
+	}
+	benchmark_static_and_seeded("uint64_t", ints);
+	benchmark_static_and_seeded("std::string (16 bytes)", make_strings(count, 16));
+	benchmark_static_and_seeded("std::string (100 bytes)", make_strings(count, 100));
+	benchmark_static_and_seeded("std::string (1000 bytes)", make_strings(count / 10, 1000));
+
+	std::vector<std::vector<std::string>> vecs(count / 10, make_strings(10, 32));
+	benchmark_static_and_seeded("std::vector<std::string>", vecs);
+}
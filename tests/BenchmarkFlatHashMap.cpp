@@ -0,0 +1,146 @@
+#include <catch2/catch_all.hpp>
+
+#include <dice/hash/FlatHashMap.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using namespace dice::hash;
+
+namespace {
+	using Map = FlatHashMap<uint64_t, uint64_t>;
+
+	/**
+	 * @brief n_lookups random keys of which about hit_percent percent are in a table with the keys [0, n_entries)
+	 */
+	std::vector<uint64_t> make_lookup_keys(size_t n_entries, size_t n_lookups, size_t hit_percent) {
+		std::mt19937_64 rng{42};
+		std::vector<uint64_t> keys;
+		keys.reserve(n_lookups);
+		for (size_t i = 0; i < n_lookups; ++i) {
+			auto const key = rng() % n_entries;
+			keys.push_back(rng() % 100 < hit_percent ? key : key + n_entries);
+		}
+		return keys;
+	}
+
+	Map make_map(size_t n_entries) {
+		std::vector<std::pair<uint64_t, uint64_t>> entries;
+		entries.reserve(n_entries);
+		for (uint64_t key = 0; key < n_entries; ++key) {
+			entries.emplace_back(key, key);
+		}
+		Map map;
+		map.insert_bulk(entries);
+		return map;
+	}
+
+	uint64_t lookup_single(Map const &map, std::vector<uint64_t> const &keys) {
+		uint64_t sum = 0;
+		for (auto const key : keys) {
+			if (auto const *value = map.find(key); value != nullptr) {
+				sum += *value;
+			}
+		}
+		return sum;
+	}
+
+	template<size_t PrefetchDistance = Map::default_prefetch_distance>
+	uint64_t lookup_bulk(Map const &map, std::vector<uint64_t> const &keys) {
+		uint64_t sum = 0;
+		map.find_bulk<PrefetchDistance>(keys, [&sum](size_t, uint64_t const *value) {
+			if (value != nullptr) {
+				sum += *value;
+			}
+		});
+		return sum;
+	}
+
+	/**
+	 * @brief prints the lookups per second of a single run of lookup over all keys
+	 */
+	template<typename Lookup>
+	void report_lookups_per_second(std::string const &name, std::vector<uint64_t> const &keys, Lookup &&lookup) {
+		auto const start = std::chrono::steady_clock::now();
+		auto const sum = lookup(keys);
+		std::chrono::duration<double> const elapsed = std::chrono::steady_clock::now() - start;
+		std::cout << name << ": " << static_cast<double>(keys.size()) / elapsed.count() / 1e6
+				  << " M lookups/s (checksum " << sum << ")\n";
+	}
+
+	void benchmark_lookups(size_t n_entries, size_t n_lookups) {
+		auto const map = make_map(n_entries);
+		auto const keys = make_lookup_keys(n_entries, n_lookups, 90);
+		REQUIRE(lookup_single(map, keys) == lookup_bulk(map, keys));
+
+		auto const suffix = " (" + std::to_string(n_lookups) + " lookups in " + std::to_string(n_entries) + " entries)";
+
+		BENCHMARK("FlatHashMap find" + suffix) {
+			return lookup_single(map, keys);
+		};
+		BENCHMARK("FlatHashMap find_bulk" + suffix) {
+			return lookup_bulk(map, keys);
+		};
+		BENCHMARK("FlatHashMap find_bulk<4>" + suffix) {
+			return lookup_bulk<4>(map, keys);
+		};
+		BENCHMARK("FlatHashMap find_bulk<32>" + suffix) {
+			return lookup_bulk<32>(map, keys);
+		};
+
+		report_lookups_per_second("FlatHashMap find" + suffix, keys, [&map](auto const &ks) { return lookup_single(map, ks); });
+		report_lookups_per_second("FlatHashMap find_bulk" + suffix, keys, [&map](auto const &ks) { return lookup_bulk(map, ks); });
+	}
+} // namespace
+
+TEST_CASE("Benchmark FlatHashMap lookups", "[DiceHash]") {
+	benchmark_lookups(1'000'000, 100'000);
+
+	// std::unordered_map with the same hash as baseline
+	std::unordered_map<uint64_t, uint64_t, DiceHash<uint64_t>> map;
+	for (uint64_t key = 0; key < 1'000'000; ++key) {
+		map.emplace(key, key);
+	}
+	auto const keys = make_lookup_keys(1'000'000, 100'000, 90);
+	BENCHMARK("std::unordered_map find (100000 lookups in 1000000 entries)") {
+		uint64_t sum = 0;
+		for (auto const key : keys) {
+			if (auto it = map.find(key); it != map.end()) {
+				sum += it->second;
+			}
+		}
+		return sum;
+	};
+}
+
+// needs about 5 GB of memory, run explicitly with "Benchmark FlatHashMap lookups in a huge table"
+TEST_CASE("Benchmark FlatHashMap lookups in a huge table", "[DiceHash][.]") {
+	benchmark_lookups(100'000'000, 10'000'000);
+}
+
+TEST_CASE("Benchmark FlatHashMap inserts", "[DiceHash]") {
+	std::vector<std::pair<uint64_t, uint64_t>> entries;
+	std::mt19937_64 rng{7};
+	for (size_t i = 0; i < 100'000; ++i) {
+		entries.emplace_back(rng(), i);
+	}
+
+	BENCHMARK("FlatHashMap try_emplace (100000 entries)") {
+		Map map{entries.size()};
+		for (auto const &[key, value] : entries) {
+			map.try_emplace(key, value);
+		}
+		return map.size();
+	};
+	BENCHMARK("FlatHashMap insert_bulk (100000 entries)") {
+		Map map{entries.size()};
+		return map.insert_bulk(entries);
+	};
+}
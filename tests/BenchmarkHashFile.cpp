@@ -0,0 +1,83 @@
+#include <catch2/catch_all.hpp>
+#include <dice/hash/HashFile.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace dice::hash;
+
+namespace {
+	struct TempFile {
+		std::filesystem::path path;
+
+		explicit TempFile(size_t size)
+			: path{std::filesystem::temp_directory_path() / ("dice_hash_benchmark_" + std::to_string(size))} {
+			std::vector<char> block(size_t{1} << 20);
+			std::ofstream out{path, std::ios::binary | std::ios::trunc};
+			for (size_t written = 0; written < size; written += block.size()) {
+				block[0] = static_cast<char>(written >> 20);
+				out.write(block.data(), static_cast<std::streamsize>(std::min(block.size(), size - written)));
+			}
+		}
+
+		TempFile(TempFile const &) = delete;
+
+		~TempFile() {
+			std::filesystem::remove(path);
+		}
+	};
+
+	std::string size_name(size_t size) {
+		if (size >= (size_t{1} << 30)) {
+			return std::to_string(size >> 30) + " GiB";
+		}
+		return std::to_string(size >> 20) + " MiB";
+	}
+
+	void benchmark_hash_file(size_t size) {
+		TempFile const file{size};
+		std::array<std::byte, 32> output;
+
+		BENCHMARK("blake3 read into vector " + size_name(size)) {
+			std::vector<std::byte> contents;
+			contents.resize(std::filesystem::file_size(file.path));
+			std::ifstream in{file.path, std::ios::binary};
+			in.read(reinterpret_cast<char *>(contents.data()), static_cast<std::streamsize>(contents.size()));
+
+			blake3::Blake3<32>::hash_single(contents, output);
+			return output;
+		};
+
+		BENCHMARK("blake3 hash_file mmap " + size_name(size)) {
+			hash_file<blake3::Blake3<32>>(file.path, output, {.mode = FileReadMode::mmap});
+			return output;
+		};
+
+		BENCHMARK("blake3 hash_file stream " + size_name(size)) {
+			hash_file<blake3::Blake3<32>>(file.path, output, {.mode = FileReadMode::stream});
+			return output;
+		};
+
+		BENCHMARK("blake3 digest_file_parallel " + size_name(size)) {
+			blake3::Blake3<32> blake;
+			digest_file_parallel(blake, file.path);
+			std::move(blake).finish(output);
+			return output;
+		};
+
+		BENCHMARK("wyhash hash_file mmap " + size_name(size)) {
+			return hash_file<Policies::wyhash>(file.path);
+		};
+	}
+} // namespace
+
+TEST_CASE("Benchmark hash_file") {
+	benchmark_hash_file(size_t{256} << 20);
+}
+
+TEST_CASE("Benchmark hash_file huge files", "[.]") {
+	benchmark_hash_file(size_t{2} << 30);
+	benchmark_hash_file(size_t{8} << 30);
+}
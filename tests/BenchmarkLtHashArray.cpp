@@ -0,0 +1,40 @@
+#include <catch2/catch_all.hpp>
+#include <dice/hash/lthash/LtHashArray.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace dice::hash::lthash;
+
+TEST_CASE("Benchmark LtHashArray", "[DiceHash]") {
+	static constexpr size_t n_rows = 10'000;
+
+	std::vector<LtHash20> hashes(n_rows);
+	LtHashArray<20, 1008> array{n_rows};
+
+	for (size_t row = 0; row < n_rows; ++row) {
+		auto const obj = std::to_string(row);
+		hashes[row].add(as_bytes(std::span{obj}));
+		array.add(row, as_bytes(std::span{obj}));
+	}
+
+	BENCHMARK("std::vector<LtHash<20, 1008>> aggregate 10k rows") {
+		LtHash20 sum;
+		for (auto const &h : hashes) {
+			sum.combine_add(h);
+		}
+		return sum;
+	};
+
+	BENCHMARK("LtHashArray<20, 1008> aggregate 10k rows") {
+		return array.aggregate();
+	};
+
+	BENCHMARK("std::vector<LtHash<20, 1008>> copy 10k rows") {
+		return hashes;
+	};
+
+	BENCHMARK("LtHashArray<20, 1008> copy 10k rows") {
+		return array;
+	};
+}
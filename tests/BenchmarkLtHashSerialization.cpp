@@ -0,0 +1,37 @@
+#include <catch2/catch_all.hpp>
+#include <dice/hash/lthash/LtHashSerialization.hpp>
+
+#include <array>
+#include <string>
+#include <vector>
+
+using namespace dice::hash::lthash;
+
+namespace {
+	template<typename LtHashT>
+	void benchmark_serialization(std::string const &name) {
+		LtHashT h;
+		for (size_t ix = 0; ix < 16; ++ix) {
+			h.add(as_bytes(std::span{&ix, 1}));
+		}
+
+		std::vector<std::byte> bytes(serialization::serialized_len<LtHashT>());
+		serialization::serialize(h, std::span{bytes});
+
+		BENCHMARK(name + " serialize") {
+			serialization::serialize(h, std::span{bytes});
+			return bytes[serialization::header_len];
+		};
+
+		BENCHMARK(name + " deserialize") {
+			serialization::deserialize(bytes, h);
+			return h.checksum()[0];
+		};
+	}
+} // namespace
+
+TEST_CASE("Benchmark LtHash serialization", "[DiceHash]") {
+	benchmark_serialization<LtHash16>("LtHash16");
+	benchmark_serialization<LtHash20>("LtHash20");
+	benchmark_serialization<LtHash32>("LtHash32");
+}
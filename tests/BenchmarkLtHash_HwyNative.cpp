@@ -0,0 +1,3 @@
+#define DICE_HASH_BENCHMARK_LTHASH_MATH_ENGINE MathEngine_HwyNative
+#define DICE_HASH_BENCHMARK_LTHASH_INSTRUCTION_SET "HwyNative"
+#include "BenchmarkLtHash_template.hpp"
@@ -1,5 +1,6 @@
 #include <catch2/catch_all.hpp>
 #include <dice/hash/lthash/LtHash.hpp>
+#include <dice/hash/lthash/LtHashAccumulator.hpp>
 
 /**
  * @note Benchmarks adapted from https://github.com/facebook/folly/blob/main/folly/experimental/crypto/test/LtHashBenchmark.cpp
@@ -83,6 +84,33 @@ TEST_CASE("Benchmark LtHash using " DICE_HASH_BENCHMARK_LTHASH_INSTRUCTION_SET,
 		}
 	};
 
+	BENCHMARK("LtHashAccumulator<LtHash<20, 1008>> add 100k elems") {
+		LtHashAccumulator<H<20, 1008>> acc;
+		for (auto i = 0; i < 100'000; ++i) {
+			auto const &obj = objects[i % objects.size()];
+			acc.add(obj);
+		}
+		return std::move(acc).finalize();
+	};
+
+	BENCHMARK("LtHashAccumulator<LtHash<16, 1024>> add 100k elems") {
+		LtHashAccumulator<H<16, 1024>> acc;
+		for (auto i = 0; i < 100'000; ++i) {
+			auto const &obj = objects[i % objects.size()];
+			acc.add(obj);
+		}
+		return std::move(acc).finalize();
+	};
+
+	BENCHMARK("LtHashAccumulator<LtHash<32, 1024>> add 100k elems") {
+		LtHashAccumulator<H<32, 1024>> acc;
+		for (auto i = 0; i < 100'000; ++i) {
+			auto const &obj = objects[i % objects.size()];
+			acc.add(obj);
+		}
+		return std::move(acc).finalize();
+	};
+
 	BENCHMARK("LtHash<20, 1008> remove 100k elems") {
 		LtHash<20, 1008> lt;
 		for (auto i = 0; i < 100'000; ++i) {
@@ -0,0 +1,119 @@
+#include <catch2/catch_all.hpp>
+#include <dice/hash/lthash/HwyTargets.hpp>
+#include <dice/hash/lthash/LtHash.hpp>
+
+#include <algorithm>
+#include <array>
+#include <random>
+#include <string>
+
+#include <sodium.h>
+
+/**
+ * @brief Throughput of the individual math engine operations for every Highway target supported by this machine
+ */
+
+using namespace dice::hash::lthash;
+
+namespace {
+	template<typename LtHashT>
+	struct Buffers {
+		alignas(LtHashT::checksum_align) std::array<std::byte, LtHashT::checksum_len> dst;
+		alignas(LtHashT::checksum_align) std::array<std::byte, LtHashT::checksum_len> src;
+
+		Buffers() {
+			std::default_random_engine rng{std::random_device{}()};
+			std::uniform_int_distribution<unsigned> dist{0, 255};
+			for (size_t ix = 0; ix < LtHashT::checksum_len; ++ix) {
+				dst[ix] = static_cast<std::byte>(dist(rng));
+				src[ix] = static_cast<std::byte>(dist(rng));
+			}
+		}
+	};
+
+	template<template<typename> typename ME, typename LtHashT>
+	void benchmark_engine(std::string const &name) {
+		using Engine = ME<detail::Bits<LtHashT::element_bits>>;
+		Buffers<LtHashT> buffers;
+
+		if constexpr (LtHashT::needs_padding) {
+			Engine::clear_padding_bits(std::span{buffers.dst});
+			Engine::clear_padding_bits(std::span{buffers.src});
+		}
+
+		std::span<std::byte, LtHashT::checksum_len> const dst{buffers.dst};
+		std::span<std::byte const, LtHashT::checksum_len> const src{buffers.src};
+
+		BENCHMARK(name + " add") {
+			Engine::add(dst, src);
+			return buffers.dst[0];
+		};
+
+		BENCHMARK(name + " sub") {
+			Engine::sub(dst, src);
+			return buffers.dst[0];
+		};
+
+		if constexpr (LtHashT::needs_padding) {
+			BENCHMARK(name + " check_padding_bits") {
+				return Engine::check_padding_bits(std::span<std::byte const, LtHashT::checksum_len>{dst});
+			};
+
+			BENCHMARK(name + " clear_padding_bits") {
+				Engine::clear_padding_bits(dst);
+				return buffers.dst[0];
+			};
+		}
+	}
+
+	template<typename LtHashT>
+	void benchmark_equal(std::string const &name) {
+		using Engine = MathEngine_Hwy<detail::Bits<LtHashT::element_bits>>;
+		Buffers<LtHashT> buffers;
+		buffers.src = buffers.dst; // equal buffers are the worst case: everything has to be compared
+
+		std::span<std::byte const, LtHashT::checksum_len> const a{buffers.dst};
+		std::span<std::byte const, LtHashT::checksum_len> const b{buffers.src};
+
+		BENCHMARK(name + " std::equal") {
+			return std::equal(a.begin(), a.end(), b.begin());
+		};
+
+		BENCHMARK(name + " MathEngine_Hwy::equal") {
+			return Engine::equal(a, b);
+		};
+
+		BENCHMARK(name + " sodium_memcmp") {
+			return sodium_memcmp(a.data(), b.data(), a.size()) == 0;
+		};
+
+		BENCHMARK(name + " MathEngine_Hwy::equal_constant_time") {
+			return Engine::equal_constant_time(a, b);
+		};
+	}
+} // namespace
+
+TEST_CASE("Benchmark math engines for all Highway targets", "[DiceHash]") {
+	for (auto const target : hwy_targets::supported_targets()) {
+		hwy_targets::force_target(target);
+		REQUIRE(hwy_targets::active_target() == target);
+
+		std::string const target_name{hwy_targets::target_name(target)};
+
+		benchmark_engine<MathEngine_Hwy, LtHash16>("MathEngine_Hwy LtHash16 [" + target_name + "]");
+		benchmark_engine<MathEngine_Hwy, LtHash20>("MathEngine_Hwy LtHash20 [" + target_name + "]");
+		benchmark_engine<MathEngine_Hwy, LtHash32>("MathEngine_Hwy LtHash32 [" + target_name + "]");
+
+		benchmark_engine<MathEngine_HwyNative, LtHash16>("MathEngine_HwyNative LtHash16 [" + target_name + "]");
+		benchmark_engine<MathEngine_HwyNative, LtHash20>("MathEngine_HwyNative LtHash20 [" + target_name + "]");
+		benchmark_engine<MathEngine_HwyNative, LtHash32>("MathEngine_HwyNative LtHash32 [" + target_name + "]");
+	}
+
+	hwy_targets::reset_targets();
+}
+
+TEST_CASE("Benchmark checksum comparison", "[DiceHash]") {
+	benchmark_equal<LtHash16>("LtHash16");
+	benchmark_equal<LtHash20>("LtHash20");
+	benchmark_equal<LtHash32>("LtHash32");
+}
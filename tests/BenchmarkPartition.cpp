@@ -0,0 +1,94 @@
+#include <catch2/catch_all.hpp>
+
+#include <dice/hash/Partition.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace dice::hash;
+
+namespace {
+	struct Tuple {
+		uint64_t key;
+		uint64_t payload;
+	};
+
+	using Partitioner = HashPartitioner<Tuple, decltype(&Tuple::key)>;
+
+	/**
+	 * @brief the baseline: DiceHash(key) % n_partitions, one value at a time, scattering directly into the output
+	 */
+	std::vector<size_t> partition_modulo(std::vector<Tuple> const &in, std::vector<Tuple> &out, size_t n_partitions) {
+		DiceHash<uint64_t> const hash;
+		std::vector<size_t> offsets(n_partitions + 1, 0);
+		for (auto const &tuple : in) {
+			++offsets[hash(tuple.key) % n_partitions + 1];
+		}
+		for (size_t partition = 0; partition < n_partitions; ++partition) {
+			offsets[partition + 1] += offsets[partition];
+		}
+		auto cursors = offsets;
+		for (auto const &tuple : in) {
+			out[cursors[hash(tuple.key) % n_partitions]++] = tuple;
+		}
+		return offsets;
+	}
+
+	/**
+	 * @brief prints the tuples per second of a single run of f
+	 */
+	template<typename F>
+	void report_tuples_per_second(std::string const &name, size_t n_tuples, F &&f) {
+		auto const start = std::chrono::steady_clock::now();
+		auto const offsets = f();
+		std::chrono::duration<double> const elapsed = std::chrono::steady_clock::now() - start;
+		std::cout << name << ": " << static_cast<double>(n_tuples) / elapsed.count() / 1e6
+				  << " M tuples/s (" << offsets.size() - 1 << " partitions)\n";
+	}
+
+	void benchmark_partition(size_t n_tuples, size_t n_partitions) {
+		std::mt19937_64 rng{42};
+		std::vector<Tuple> in(n_tuples);
+		for (size_t ix = 0; ix < n_tuples; ++ix) {
+			in[ix] = Tuple{.key = rng(), .payload = ix};
+		}
+		std::vector<Tuple> out(n_tuples);
+
+		Partitioner const partitioner{n_partitions, &Tuple::key};
+		ThreadPool single_thread{1};
+
+		auto const suffix = " (" + std::to_string(n_tuples) + " tuples, " + std::to_string(n_partitions) + " partitions)";
+		auto const run_modulo = [&]() { return partition_modulo(in, out, n_partitions); };
+		auto const run_single = [&]() { return partitioner.scatter(in, out, single_thread); };
+		auto const run_parallel = [&]() { return partitioner.scatter(in, out, ThreadPool::global()); };
+
+		BENCHMARK("DiceHash % n scatter" + suffix) {
+			return run_modulo();
+		};
+		BENCHMARK("HashPartitioner 1 thread" + suffix) {
+			return run_single();
+		};
+		BENCHMARK("HashPartitioner " + std::to_string(ThreadPool::global().concurrency()) + " threads" + suffix) {
+			return run_parallel();
+		};
+
+		report_tuples_per_second("DiceHash % n scatter" + suffix, n_tuples, run_modulo);
+		report_tuples_per_second("HashPartitioner 1 thread" + suffix, n_tuples, run_single);
+		report_tuples_per_second("HashPartitioner " + std::to_string(ThreadPool::global().concurrency()) + " threads" + suffix, n_tuples, run_parallel);
+	}
+} // namespace
+
+TEST_CASE("Benchmark HashPartitioner", "[DiceHash]") {
+	benchmark_partition(1'000'000, 64);
+	benchmark_partition(1'000'000, 1'024);
+}
+
+// run explicitly with "Benchmark HashPartitioner with many tuples"
+TEST_CASE("Benchmark HashPartitioner with many tuples", "[DiceHash][.]") {
+	benchmark_partition(100'000'000, 1'024);
+	benchmark_partition(100'000'000, 16'384);
+}
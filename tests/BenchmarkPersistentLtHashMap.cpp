@@ -0,0 +1,78 @@
+#include <catch2/catch_all.hpp>
+
+#include <dice/hash/lthash/PersistentLtHashMap.hpp>
+#include <metall/metall.hpp>
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+using namespace dice::hash::lthash;
+
+namespace {
+	using allocator_type = metall::manager::allocator_type<std::byte>;
+
+	/**
+	 * @brief writes the modified pages back to the file backing the segment
+	 */
+	struct MsyncPersistBarrier {
+		void operator()(std::span<std::byte const> bytes) const noexcept {
+			static auto const page_size = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+
+			auto const begin = reinterpret_cast<uintptr_t>(bytes.data()) & ~(page_size - 1);
+			auto const end = reinterpret_cast<uintptr_t>(bytes.data() + bytes.size());
+			msync(reinterpret_cast<void *>(begin), end - begin, MS_SYNC);
+		}
+	};
+
+	template<typename Map>
+	void run_benchmark(std::string const &name, uint64_t n_partitions) {
+		std::string const path{"/tmp/benchmark_PersistentLtHashMap_" + std::to_string(std::random_device{}())};
+
+		{
+			metall::manager manager(metall::create_only, path.c_str());
+			auto map = manager.construct<Map>("lthash_map")(manager.get_allocator(), n_partitions);
+			for (uint64_t id = 0; id < n_partitions; ++id) {
+				map->insert(id);
+			}
+
+			uint64_t i = 0;
+			BENCHMARK(name + " add to " + std::to_string(n_partitions) + " partitions") {
+				auto const obj = std::to_string(i);
+				map->add(i++ % n_partitions, as_bytes(std::span{obj}));
+				return map->size();
+			};
+
+			BENCHMARK(name + " aggregate " + std::to_string(n_partitions) + " partitions") {
+				return map->aggregate();
+			};
+		}
+
+		BENCHMARK(name + " reopen " + std::to_string(n_partitions) + " partitions") {
+			metall::manager manager(metall::open_only, path.c_str());
+			return std::get<0>(manager.find<Map>("lthash_map"))->size();
+		};
+
+		metall::manager::remove(path.c_str());
+	}
+} // namespace
+
+TEST_CASE("Benchmark PersistentLtHashMap", "[DiceHash]") {
+	using Map = PersistentLtHashMap<20, 1008, dice::hash::blake3::Blake3, DefaultMathEngine, allocator_type>;
+	using SyncedMap = PersistentLtHashMap<20, 1008, dice::hash::blake3::Blake3, DefaultMathEngine, allocator_type, MsyncPersistBarrier>;
+
+	std::vector<LtHash20> hashes(1'000);
+	uint64_t i = 0;
+	BENCHMARK("std::vector<LtHash<20, 1008>> add to 1000 partitions") {
+		auto const obj = std::to_string(i);
+		hashes[i++ % hashes.size()].add(as_bytes(std::span{obj}));
+		return hashes.size();
+	};
+
+	run_benchmark<Map>("PersistentLtHashMap<20, 1008>", 1'000);
+	run_benchmark<SyncedMap>("PersistentLtHashMap<20, 1008> (msync)", 1'000);
+}
@@ -0,0 +1,74 @@
+#include <catch2/catch_all.hpp>
+#include <dice/hash/lthash/SeqLockLtHash.hpp>
+
+#include "TestLtHash_common.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace dice::hash::lthash;
+
+namespace {
+	constexpr size_t n_updates = 10'000;
+	constexpr size_t n_readers = 4;
+
+	template<typename Write, typename Read>
+	size_t run(Write const &write, Read const &read) {
+		// every reader gets its own copy of read (which may be stateful)
+		std::atomic<bool> done{false};
+		std::atomic<size_t> n_reads{0};
+
+		std::vector<std::thread> readers;
+		for (size_t r = 0; r < n_readers; ++r) {
+			readers.emplace_back([&done, &n_reads, read = read]() mutable {
+				size_t local_reads = 0;
+				while (!done.load(std::memory_order_relaxed)) {
+					read();
+					++local_reads;
+				}
+				n_reads.fetch_add(local_reads, std::memory_order_relaxed);
+			});
+		}
+
+		for (uint64_t ix = 0; ix < n_updates; ++ix) {
+			write(as_object(ix));
+		}
+		done.store(true, std::memory_order_relaxed);
+
+		for (auto &reader : readers) {
+			reader.join();
+		}
+		return n_reads.load();
+	}
+} // namespace
+
+TEST_CASE("Benchmark SeqLockLtHash polling readers", "[DiceHash]") {
+	BENCHMARK("LtHash<20, 1008> with mutex, 10k adds, 4 polling readers") {
+		LtHash20 h;
+		std::mutex mutex;
+		return run([&](std::span<std::byte const> obj) {
+					   std::lock_guard lock{mutex};
+					   h.add(obj);
+				   },
+				   [&]() {
+					   std::lock_guard lock{mutex};
+					   LtHash20 copy{h};
+					   return copy;
+				   });
+	};
+
+	BENCHMARK("SeqLockLtHash<LtHash<20, 1008>> 10k adds, 4 polling readers") {
+		SeqLockLtHash<LtHash20> h;
+		return run([&](std::span<std::byte const> obj) { h.add(obj); },
+				   [&]() { return h.snapshot(); });
+	};
+
+	BENCHMARK("SeqLockLtHash<LtHash<20, 1008>> 10k adds, 4 readers polling changed_since") {
+		SeqLockLtHash<LtHash20> h;
+		return run([&](std::span<std::byte const> obj) { h.add(obj); },
+				   [&, snap = h.snapshot()]() mutable { return h.snapshot_if_changed(snap.epoch, snap); });
+	};
+}
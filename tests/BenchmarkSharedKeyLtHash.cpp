@@ -0,0 +1,44 @@
+#include <catch2/catch_all.hpp>
+#include <dice/hash/lthash/SharedKeyLtHash.hpp>
+
+#include <array>
+#include <vector>
+
+using namespace dice::hash::lthash;
+
+TEST_CASE("Benchmark SharedKeyLtHash temporaries", "[DiceHash]") {
+	static constexpr size_t n = 1'000;
+	std::array<std::byte, 32> key_bytes{};
+	key_bytes.fill(std::byte{42});
+	std::array<std::byte, 1> const obj{std::byte{'a'}};
+
+	std::vector<LtHash20> hashes(n);
+	for (auto &h : hashes) {
+		h.set_key(std::span<std::byte const, 32>{key_bytes});
+		h.add(obj);
+	}
+
+	SharedKeyLtHash<20, 1008>::key_type const key{std::span<std::byte const, 32>{key_bytes}};
+	std::vector<SharedKeyLtHash<20, 1008>> shared_hashes(n, SharedKeyLtHash<20, 1008>{key});
+	for (auto &h : shared_hashes) {
+		h.add(obj);
+	}
+
+	BENCHMARK("LtHash<20, 1008> copy and combine 1k") {
+		LtHash20 sum{hashes.front()};
+		for (auto const &h : hashes) {
+			LtHash20 tmp{h};
+			sum.combine_add(tmp);
+		}
+		return sum;
+	};
+
+	BENCHMARK("SharedKeyLtHash<20, 1008> copy and combine 1k") {
+		SharedKeyLtHash<20, 1008> sum{shared_hashes.front()};
+		for (auto const &h : shared_hashes) {
+			SharedKeyLtHash<20, 1008> tmp{h};
+			sum.combine_add(tmp);
+		}
+		return sum;
+	};
+}
@@ -59,3 +59,71 @@ TEST_CASE("Blake2Xb", "[DiceHash]") {
 		check(key, keyed_test_data);
 	}
 }
+
+TEST_CASE("Blake2Xb reset", "[DiceHash]") {
+	auto const &input = hash_input;
+	auto const other_input = as_bytes(std::span{"spherical cow"});
+
+	for (size_t const output_len : {size_t{1}, size_t{64}, size_t{65}, size_t{300}}) {
+		CAPTURE(output_len);
+
+		std::vector<std::byte> expected(output_len);
+		std::vector<std::byte> actual(output_len);
+
+		blake2xb::Blake2Xb<> blake{output_len};
+		blake.digest(other_input);
+		std::move(blake).finish(actual); // finish changes the internal parameter block
+
+		blake.reset();
+		blake.digest(input);
+		std::move(blake).finish(actual);
+		blake2xb::Blake2Xb<>::hash_single(input, expected);
+		CHECK(expected == actual);
+
+		blake.reset(key);
+		blake.digest(input);
+		std::move(blake).finish(actual);
+		blake2xb::Blake2Xb<>::hash_single(input, expected, key);
+		CHECK(expected == actual);
+
+		// the new key is kept by reset()
+		blake.reset();
+		blake.digest(input);
+		std::move(blake).finish(actual);
+		CHECK(expected == actual);
+
+		blake.reset(std::span<std::byte const>{});
+		blake.digest(input);
+		std::move(blake).finish(actual);
+		blake2xb::Blake2Xb<>::hash_single(input, expected);
+		CHECK(expected == actual);
+	}
+}
+
+TEST_CASE("Blake2Xb construction", "[DiceHash]") {
+	static_assert(std::is_nothrow_default_constructible_v<blake2xb::Blake2Xb<>>);
+	static_assert(std::is_nothrow_default_constructible_v<blake2xb::Blake2Xb<128>>);
+	static_assert(std::is_nothrow_constructible_v<blake2xb::Blake2Xb<128>, std::array<std::byte, blake2xb::max_key_extent> const &>);
+	static_assert(!std::is_nothrow_constructible_v<blake2xb::Blake2Xb<128>, std::span<std::byte const>>);
+	static_assert(!std::is_nothrow_constructible_v<blake2xb::Blake2Xb<>, size_t>);
+
+	std::array<std::byte, blake2xb::max_key_extent> static_key;
+	std::copy(key.begin(), key.end(), static_key.begin());
+
+	std::array<std::byte, 128> expected;
+	std::array<std::byte, 128> actual;
+
+	blake2xb::Blake2Xb<128>::hash_single(hash_input, expected, key);
+	blake2xb::Blake2Xb<128> blake{static_key};
+	blake.digest(hash_input);
+	std::move(blake).finish(actual);
+	CHECK(expected == actual);
+
+	blake2xb::Blake2Xb<128>::hash_single(hash_input, expected);
+	blake2xb::Blake2Xb<128> unkeyed;
+	unkeyed.digest(hash_input);
+	std::move(unkeyed).finish(actual);
+	CHECK(expected == actual);
+
+	CHECK_THROWS(blake2xb::Blake2Xb<>{blake2xb::max_output_extent + 1});
+}
@@ -53,4 +53,89 @@ TEST_CASE("Blake2b", "[DiceHash]") {
 
 		CHECK(output1 == output2);
 	}
+
+	SECTION("construction") {
+		static_assert(std::is_nothrow_default_constructible_v<Blake2b<max_output_extent>>);
+		static_assert(std::is_nothrow_constructible_v<Blake2b<max_output_extent>, std::array<std::byte, max_key_extent> const &>);
+		static_assert(std::is_nothrow_constructible_v<Blake2b<max_output_extent>, std::span<std::byte const, min_key_extent>>);
+		static_assert(!std::is_nothrow_constructible_v<Blake2b<max_output_extent>, std::span<std::byte const>>);
+		static_assert(!std::is_nothrow_constructible_v<Blake2b<>, size_t>);
+
+		CHECK_NOTHROW(dice::hash::init());
+
+		auto const data = as_bytes(std::span{"spherical cow"});
+
+		std::array<std::byte, max_key_extent> key;
+		generate_key(std::span{key});
+
+		std::array<std::byte, max_output_extent> expected;
+		std::array<std::byte, max_output_extent> actual;
+
+		Blake2b<max_output_extent>::hash_single(data, expected, key); // validated at runtime
+
+		Blake2b<max_output_extent> blake{key}; // validated at compile time
+		blake.digest(data);
+		std::move(blake).finish(actual);
+		CHECK(expected == actual);
+
+		Blake2b<max_output_extent>::hash_single(data, expected);
+
+		Blake2b<max_output_extent> unkeyed;
+		unkeyed.digest(data);
+		std::move(unkeyed).finish(actual);
+		CHECK(expected == actual);
+
+		std::vector<std::byte> invalid_key(max_key_extent + 1);
+		CHECK_THROWS(Blake2b<max_output_extent>{std::span<std::byte const>{invalid_key}});
+	}
+
+	SECTION("reset") {
+		auto const data1 = as_bytes(std::span{"spherical cow"});
+		auto const data2 = as_bytes(std::span{"penguins"});
+
+		std::array<std::byte, max_key_extent> key1;
+		generate_key(std::span{key1});
+		std::vector<std::byte> key2;
+		key2.resize(min_key_extent);
+		generate_key(std::span{key2});
+
+		std::array<std::byte, max_output_extent> expected;
+		std::array<std::byte, max_output_extent> actual;
+
+		Blake2b<max_output_extent> blake{key1};
+		blake.digest(data1);
+		blake.reset();
+		blake.digest(data2);
+		std::move(blake).finish(actual);
+
+		Blake2b<max_output_extent>::hash_single(data2, expected, key1);
+		CHECK(expected == actual);
+
+		Blake2b<> dynamic_blake{max_output_extent, key1};
+		dynamic_blake.digest(data1);
+		dynamic_blake.reset(key2);
+		dynamic_blake.digest(data2);
+		auto copy = dynamic_blake;
+		std::move(dynamic_blake).finish(actual);
+
+		Blake2b<>::hash_single(data2, expected, key2);
+		CHECK(expected == actual);
+
+		// the new key is kept by reset()
+		copy.reset();
+		copy.digest(data2);
+		std::move(copy).finish(actual);
+		CHECK(expected == actual);
+
+		// unkeyed
+		blake.reset(std::span<std::byte const>{});
+		blake.digest(data1);
+		std::move(blake).finish(actual);
+		Blake2b<max_output_extent>::hash_single(data1, expected);
+		CHECK(expected == actual);
+
+		std::array<std::byte, min_key_extent - 1> invalid_key{};
+		CHECK_THROWS(blake.reset(std::span<std::byte const>{invalid_key}));
+		static_assert(noexcept(blake.reset(key1)));
+	}
 }
@@ -0,0 +1,337 @@
+#include <catch2/catch_all.hpp>
+
+#include <dice/hash/blake/Blake3.hpp>
+
+#include <array>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace dice::hash;
+using namespace dice::hash::blake3;
+
+namespace {
+	std::vector<std::byte> make_input(size_t size) {
+		std::vector<std::byte> input;
+		input.resize(size);
+		for (size_t ix = 0; ix < size; ++ix) {
+			input[ix] = static_cast<std::byte>((ix * 31) ^ (ix >> 10));
+		}
+		return input;
+	}
+
+	/**
+	 * @brief executes the tasks serially in reverse order, to make sure the result does not depend on the order of execution
+	 */
+	struct ReverseExecutor {
+		size_t concurrency() const noexcept {
+			return 8;
+		}
+
+		template<typename F>
+		void parallel_for(size_t n, F const &f) const {
+			for (size_t ix = n; ix > 0; --ix) {
+				f(ix - 1);
+			}
+		}
+	};
+
+	static_assert(Executor<ThreadPool>);
+	static_assert(Executor<ReverseExecutor>);
+
+	/**
+	 * @brief input of the official BLAKE3 test vectors (test_vectors.json in the BLAKE3 repository)
+	 */
+	std::vector<std::byte> official_input(size_t size) {
+		std::vector<std::byte> input(size);
+		for (size_t ix = 0; ix < size; ++ix) {
+			input[ix] = static_cast<std::byte>(ix % 251);
+		}
+		return input;
+	}
+
+	std::string to_hex(detail::chaining_value const &cv) {
+		uint8_t bytes[BLAKE3_OUT_LEN];
+		detail::store_cv(cv, bytes);
+
+		std::string ret;
+		for (auto const byte : bytes) {
+			ret += "0123456789abcdef"[byte >> 4];
+			ret += "0123456789abcdef"[byte & 0xf];
+		}
+		return ret;
+	}
+
+	/**
+	 * @brief the first 32 bytes of the hash of an input of at most two chunks,
+	 * 		finalized with the helpers of digest_parallel (i.e. detail::compress_in_place) instead of blake3_hasher_finalize
+	 */
+	std::string detail_root_hash(blake3_hasher const &initial, std::span<std::byte const> input) {
+		static constexpr uint8_t flag_root = 1 << 3; // see blake3_impl.h
+
+		auto hasher = initial;
+		if (input.size() <= BLAKE3_CHUNK_LEN) {
+			blake3_hasher_update(&hasher, input.data(), input.size());
+			auto root = detail::chunk_output(hasher.chunk);
+			root.flags |= flag_root;
+			return to_hex(root.chaining());
+		}
+
+		REQUIRE(input.size() <= 2 * BLAKE3_CHUNK_LEN);
+		uint8_t children[2 * BLAKE3_OUT_LEN];
+
+		blake3_hasher_update(&hasher, input.data(), BLAKE3_CHUNK_LEN);
+		detail::store_cv(detail::chunk_cv(hasher.chunk), children);
+
+		detail::reset_chunk(hasher, 1);
+		blake3_hasher_update(&hasher, input.data() + BLAKE3_CHUNK_LEN, input.size() - BLAKE3_CHUNK_LEN);
+		detail::store_cv(detail::chunk_cv(hasher.chunk), children + BLAKE3_OUT_LEN);
+
+		auto root = detail::parent_output(hasher.key, hasher.chunk.flags, children, children + BLAKE3_OUT_LEN);
+		root.flags |= flag_root;
+		return to_hex(root.chaining());
+	}
+} // namespace
+
+TEST_CASE("Blake3", "[DiceHash]") {
+	std::array<std::byte, default_key_extent> key;
+	std::iota(reinterpret_cast<unsigned char *>(key.data()), reinterpret_cast<unsigned char *>(key.data() + key.size()), 0);
+
+	SECTION("digest_parallel produces the same hash as digest") {
+		auto const input = make_input((17 << 20) + 517);
+		std::span<std::byte const> const data{input};
+
+		ThreadPool pool{4};
+
+		for (size_t const size : {size_t{0}, size_t{1}, size_t{1024}, size_t{1025},
+								  parallel_min_input_len - 1, parallel_min_input_len, parallel_min_input_len + 1,
+								  (size_t{3} << 20) + 1024, (size_t{5} << 20) + 33, input.size()}) {
+			for (size_t const prefix : {size_t{0}, size_t{1}, size_t{1024}, size_t{1500}, size_t{5 * 1024 + 64}}) {
+				CAPTURE(size, prefix);
+
+				std::array<std::byte, 64> expected;
+				std::array<std::byte, 64> actual;
+
+				{
+					Blake3<64> blake;
+					blake.digest(data.subspan(0, prefix));
+					blake.digest(data.subspan(prefix, size - std::min(size, prefix)));
+					std::move(blake).finish(expected);
+				}
+
+				{
+					Blake3<64> blake;
+					blake.digest(data.subspan(0, prefix));
+					blake.digest_parallel(data.subspan(prefix, size - std::min(size, prefix)), pool);
+					std::move(blake).finish(actual);
+				}
+				REQUIRE(expected == actual);
+
+				{
+					Blake3<64> blake{key};
+					blake.digest(data.subspan(0, prefix));
+					blake.digest(data.subspan(prefix, size - std::min(size, prefix)));
+					std::move(blake).finish(expected);
+				}
+
+				{
+					Blake3<64> blake{key};
+					blake.digest(data.subspan(0, prefix));
+					blake.digest_parallel(data.subspan(prefix, size - std::min(size, prefix)), pool);
+					std::move(blake).finish(actual);
+				}
+				REQUIRE(expected == actual);
+			}
+		}
+	}
+
+	SECTION("consecutive calls and different executors") {
+		auto const input = make_input(size_t{9} << 20);
+		std::span<std::byte const> const data{input};
+
+		std::array<std::byte, 32> expected;
+		Blake3<32>::hash_single(data, expected);
+
+		ThreadPool single{1};
+		ThreadPool many{7};
+		ReverseExecutor reverse;
+
+		std::array<std::byte, 32> actual;
+		Blake3<32> blake;
+		blake.digest_parallel(data.subspan(0, (size_t{2} << 20) + 3), many);
+		blake.digest_parallel(data.subspan((size_t{2} << 20) + 3, (size_t{3} << 20) + 1021), reverse);
+		blake.digest_parallel(data.subspan((size_t{5} << 20) + 1024, size_t{1} << 20), single);
+		blake.digest_parallel(data.subspan((size_t{6} << 20) + 1024));
+		std::move(blake).finish(actual);
+
+		CHECK(expected == actual);
+	}
+
+	SECTION("thread pool") {
+		ThreadPool pool{3};
+		CHECK(pool.concurrency() == 3);
+
+		std::vector<std::atomic<size_t>> counts(1000);
+		for (size_t round = 0; round < 10; ++round) {
+			pool.parallel_for(counts.size(), [&](size_t ix) {
+				counts[ix].fetch_add(1);
+			});
+		}
+		CHECK(std::all_of(counts.begin(), counts.end(), [](auto const &count) { return count.load() == 10; }));
+
+		CHECK_THROWS_AS(pool.parallel_for(100, [](size_t ix) {
+							if (ix == 42) {
+								throw std::runtime_error{"task failed"};
+							}
+						}), std::runtime_error);
+
+		// pool is still usable after a failed batch
+		std::atomic<size_t> sum = 0;
+		pool.parallel_for(100, [&](size_t ix) { sum += ix; });
+		CHECK(sum == 4950);
+	}
+}
+
+TEST_CASE("Blake3 OutputReader", "[DiceHash]") {
+	std::array<std::byte, default_key_extent> key;
+	std::iota(reinterpret_cast<unsigned char *>(key.data()), reinterpret_cast<unsigned char *>(key.data() + key.size()), 0);
+
+	for (size_t const size : {size_t{0}, size_t{1}, size_t{64}, size_t{1023}, size_t{1024}, size_t{1025}, size_t{2048}, size_t{5000}, size_t{100'000}}) {
+		auto const input = make_input(size);
+
+		for (bool const keyed : {false, true}) {
+			CAPTURE(size, keyed);
+
+			auto blake = keyed ? Blake3<>{key} : Blake3<>{};
+			blake.digest(input);
+
+			std::vector<std::byte> expected(3000);
+			{
+				auto copy = blake;
+				std::move(copy).finish(expected);
+			}
+
+			auto reader = blake.output_reader();
+
+			SECTION("fill " + std::to_string(size) + (keyed ? " keyed" : "")) {
+				std::vector<std::byte> actual(expected.size());
+				std::span<std::byte> rest{actual};
+				for (size_t const step : {size_t{1}, size_t{63}, size_t{64}, size_t{65}, size_t{700}}) {
+					reader.fill(rest.subspan(0, step));
+					rest = rest.subspan(step);
+				}
+				reader.fill(rest);
+
+				CHECK(reader.position() == expected.size());
+				CHECK(expected == actual);
+			}
+
+			SECTION("read_at and seek " + std::to_string(size) + (keyed ? " keyed" : "")) {
+				for (size_t const offset : {size_t{0}, size_t{1}, size_t{63}, size_t{64}, size_t{129}, size_t{2000}}) {
+					for (size_t const len : {size_t{0}, size_t{1}, size_t{64}, size_t{100}, size_t{1000 - 1}}) {
+						CAPTURE(offset, len);
+
+						std::vector<std::byte> actual(len);
+						reader.read_at(offset, actual);
+						CHECK(std::equal(actual.begin(), actual.end(), expected.begin() + static_cast<std::ptrdiff_t>(offset)));
+
+						reader.seek(offset);
+						reader.fill(actual);
+						CHECK(reader.position() == offset + len);
+						CHECK(std::equal(actual.begin(), actual.end(), expected.begin() + static_cast<std::ptrdiff_t>(offset)));
+					}
+				}
+			}
+
+			SECTION("far offsets " + std::to_string(size) + (keyed ? " keyed" : "")) {
+				uint64_t const offset = (uint64_t{1} << 40) + 17;
+
+				std::array<std::byte, 100> expected_far;
+				{
+					blake3_hasher hasher;
+					if (keyed) {
+						blake3_hasher_init_keyed(&hasher, reinterpret_cast<uint8_t const *>(key.data()));
+					} else {
+						blake3_hasher_init(&hasher);
+					}
+					blake3_hasher_update(&hasher, input.data(), input.size());
+					blake3_hasher_finalize_seek(&hasher, offset, reinterpret_cast<uint8_t *>(expected_far.data()), expected_far.size());
+				}
+
+				std::array<std::byte, 100> actual_far;
+				reader.read_at(offset, actual_far);
+				CHECK(expected_far == actual_far);
+			}
+		}
+	}
+}
+
+TEST_CASE("Blake3 reset", "[DiceHash]") {
+	std::array<std::byte, default_key_extent> key1;
+	generate_key(key1);
+	std::array<std::byte, default_key_extent> key2;
+	generate_key(key2);
+
+	auto const input = make_input(5000);
+	auto const other_input = make_input(3000);
+
+	std::array<std::byte, 64> expected;
+	std::array<std::byte, 64> actual;
+
+	Blake3<64> blake{key1};
+	blake.digest(other_input);
+	blake.reset();
+	blake.digest(input);
+	std::move(blake).finish(actual);
+	Blake3<64>::hash_single(input, expected, key1);
+	CHECK(expected == actual);
+
+	blake.reset(key2);
+	blake.digest(input);
+	std::move(blake).finish(actual);
+	Blake3<64>::hash_single(input, expected, key2);
+	CHECK(expected == actual);
+
+	// the new key is kept by reset()
+	blake.reset();
+	blake.digest(input);
+	std::move(blake).finish(actual);
+	CHECK(expected == actual);
+}
+
+TEST_CASE("Blake3 merge helpers match the official test vectors", "[DiceHash]") {
+	struct TestVector {
+		size_t input_len;
+		std::string_view hash;
+		std::string_view keyed_hash;
+	};
+
+	// first 32 bytes of "hash" and "keyed_hash" from test_vectors.json
+	static constexpr TestVector test_vectors[]{
+			{0, "af1349b9f5f9a1a6a0404dea36dcc9499bcb25c9adc112b7cc9a93cae41f3262", "92b2b75604ed3c761f9d6f62392c8a9227ad0ea3f09573e783f1498a4ed60d26"},
+			{1, "2d3adedff11b61f14c886e35afa036736dcd87a74d27b5c1510225d0f592e213", "6d7878dfff2f485635d39013278ae14f1454b8c0a3a2d34bc1ab38228a80c95b"},
+			{63, "e9bc37a594daad83be9470df7f7b3798297c3d834ce80ba85d6e207627b7db7b", "bb1eb5d4afa793c1ebdd9fb08def6c36d10096986ae0cfe148cd101170ce37ae"},
+			{64, "4eed7141ea4a5cd4b788606bd23f46e212af9cacebacdc7d1f4c6dc7f2511b98", "ba8ced36f327700d213f120b1a207a3b8c04330528586f414d09f2f7d9ccb7e6"},
+			{65, "de1e5fa0be70df6d2be8fffd0e99ceaa8eb6e8c93a63f2d8d1c30ecb6b263dee", "c0a4edefa2d2accb9277c371ac12fcdbb52988a86edc54f0716e1591b4326e72"},
+			{1023, "10108970eeda3eb932baac1428c7a2163b0e924c9a9e25b35bba72b28f70bd11", "c951ecdf03288d0fcc96ee3413563d8a6d3589547f2c2fb36d9786470f1b9d6e"},
+			{1024, "42214739f095a406f3fc83deb889744ac00df831c10daa55189b5d121c855af7", "75c46f6f3d9eb4f55ecaaee480db732e6c2105546f1e675003687c31719c7ba4"},
+			{2048, "e776b6028c7cd22a4d0ba182a8bf62205d2ef576467e838ed6f2529b85fba24a", "879cf1fa2ea0e79126cb1063617a05b6ad9d0b696d0d757cf053439f60a99dd1"},
+	};
+
+	static constexpr std::string_view key = "whats the Elvish word for friend";
+
+	blake3_hasher unkeyed;
+	blake3_hasher_init(&unkeyed);
+	blake3_hasher keyed;
+	blake3_hasher_init_keyed(&keyed, reinterpret_cast<uint8_t const *>(key.data()));
+
+	for (auto const &vector : test_vectors) {
+		CAPTURE(vector.input_len);
+		auto const input = official_input(vector.input_len);
+
+		CHECK(detail_root_hash(unkeyed, input) == vector.hash);
+		CHECK(detail_root_hash(keyed, input) == vector.keyed_hash);
+	}
+}
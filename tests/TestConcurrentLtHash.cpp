@@ -0,0 +1,102 @@
+#include <catch2/catch_all.hpp>
+
+#include <dice/hash/lthash/ConcurrentLtHash.hpp>
+
+#include "TestLtHash_common.hpp"
+
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace dice::hash::lthash;
+
+TEMPLATE_TEST_CASE("ConcurrentLtHash", "[DiceHash]",
+				   (ConcurrentLtHash<16, 1024>),
+				   (ConcurrentLtHash<20, 1008>),
+				   (ConcurrentLtHash<32, 1024>)) {
+	using H = TestType;
+	using L = typename H::lthash_type;
+
+	auto const key_bytes = as_bytes(std::span<char const, 32>{"0123456789abcdef0123456789abcdef", 32});
+
+	SECTION("shard count is a power of two") {
+		CHECK(H{1}.shard_count() == 1);
+		CHECK(H{0}.shard_count() == 1);
+		CHECK(H{3}.shard_count() == 4);
+		CHECK(H{8}.shard_count() == 8);
+	}
+
+	SECTION("locking operations may throw") {
+		STATIC_REQUIRE(!noexcept(std::declval<H &>().add(std::span<std::byte const>{})));
+		STATIC_REQUIRE(!noexcept(std::declval<H &>().remove(std::span<std::byte const>{})));
+		STATIC_REQUIRE(!noexcept(std::declval<H const &>().checksum()));
+	}
+
+	SECTION("concurrent adds and removes equal sequential ones") {
+		static constexpr size_t n_threads = 8;
+		static constexpr size_t n_objects = 500;
+
+		H h{4};
+		h.set_key(key_bytes);
+
+		std::vector<std::thread> threads;
+		for (size_t t = 0; t < n_threads; ++t) {
+			threads.emplace_back([&h, t]() {
+				for (size_t ix = 0; ix < n_objects; ++ix) {
+					h.add(as_object(t * n_objects + ix));
+				}
+				for (size_t ix = 0; ix < n_objects; ix += 2) {
+					h.remove(as_object(t * n_objects + ix));
+				}
+			});
+		}
+		for (auto &thread : threads) {
+			thread.join();
+		}
+
+		L expected;
+		expected.set_key(key_bytes);
+		for (size_t ix = 1; ix < n_threads * n_objects; ix += 2) {
+			expected.add(as_object(ix));
+		}
+
+		CHECK(std::ranges::equal(h.checksum(), expected.checksum()));
+		CHECK(h.snapshot() == expected);
+		CHECK(h.snapshot().key_equal(key_bytes));
+	}
+
+	SECTION("combine") {
+		H h{2};
+		h.set_key(key_bytes);
+
+		L l;
+		l.set_key(key_bytes);
+		l.add(as_object(1)).add(as_object(2));
+
+		h.combine_add(l);
+		h.remove(as_object(1));
+
+		L expected;
+		expected.set_key(key_bytes);
+		expected.add(as_object(2));
+		CHECK(h.snapshot() == expected);
+
+		h.combine_remove(expected);
+		CHECK(h.snapshot() == L{});
+
+		CHECK_THROWS_AS(h.combine_add(L{}), std::invalid_argument);
+		CHECK_THROWS_AS(h.combine_remove(L{}), std::invalid_argument);
+	}
+
+	SECTION("clear") {
+		H h{2};
+		h.add(as_object(1));
+		CHECK_FALSE(h.snapshot() == L{});
+
+		h.clear();
+		CHECK(h.snapshot() == L{});
+	}
+}
@@ -2,19 +2,47 @@
 
 #include <dice/hash.hpp>
 
-#ifdef __x86_64__
 #define AllPoliciesToTestForDiceHash dice::hash::Policies::Martinus, dice::hash::Policies::xxh3, \
 									 dice::hash::Policies::wyhash
-#else
-#define AllPoliciesToTestForDiceHash dice::hash::Policies::Martinus, \
-									 dice::hash::Policies::wyhash
-#endif
 #define AllTypesToTestForDiceHash int, long, std::size_t, std::byte, std::string, std::string_view, int *, long *,             \
 								  std::string *, std::unique_ptr<int>, std::shared_ptr<int>, std::vector<int>,                 \
 								  std::set<int>, std::unordered_set<int>, (std::array<int, 10>), (std::tuple<int, int, long>), \
 								  (std::pair<int, int>), (std::variant<std::monostate>), (std::variant<int, float, std::string>)
 
 
+namespace dice::tests::hash {
+	/** Allocator that is not std::allocator (like the allocators of persistent heaps). */
+	template<typename T>
+	struct CustomAllocator {
+		using value_type = T;
+
+		CustomAllocator() = default;
+		template<typename U>
+		CustomAllocator(CustomAllocator<U> const &) noexcept {}
+
+		T *allocate(std::size_t n) { return std::allocator<T>{}.allocate(n); }
+		void deallocate(T *p, std::size_t n) noexcept { std::allocator<T>{}.deallocate(p, n); }
+
+		template<typename U>
+		bool operator==(CustomAllocator<U> const &) const noexcept { return true; }
+	};
+
+	/** Contiguous container that is registered via is_contiguous_container. */
+	template<typename T>
+	struct ContiguousBuffer {
+		using value_type = T;
+		std::vector<T> values;
+
+		[[nodiscard]] T const *data() const noexcept { return values.data(); }
+		[[nodiscard]] std::size_t size() const noexcept { return values.size(); }
+		[[nodiscard]] auto begin() const noexcept { return values.begin(); }
+		[[nodiscard]] auto end() const noexcept { return values.end(); }
+	};
+}// namespace dice::tests::hash
+
+template<typename T>
+struct dice::hash::is_contiguous_container<dice::tests::hash::ContiguousBuffer<T>> : std::true_type {};
+
 namespace dice::tests::hash {
 	struct UserDefinedStruct {
 		int a;
@@ -99,6 +127,22 @@ namespace dice::tests::hash {
 			REQUIRE(test_str_vec_arr<CurrentPolicy>('0', '1', '2', '3', '4', '5', '6', '7', '8'));
 		}
 
+		SECTION("Strings and vectors with a custom allocator generate the same hash as with std::allocator") {
+			using CustomString = std::basic_string<char, std::char_traits<char>, CustomAllocator<char>>;
+			REQUIRE(getHash<CurrentPolicy>(CustomString{"spherical cow"}) == getHash<CurrentPolicy>(std::string{"spherical cow"}));
+
+			std::vector<int, CustomAllocator<int>> const custom_vec{1, 2, 3, 4};
+			REQUIRE(getHash<CurrentPolicy>(custom_vec) == getHash<CurrentPolicy>(std::vector<int>{1, 2, 3, 4}));
+
+			std::vector<std::pair<int, int>, CustomAllocator<std::pair<int, int>>> const custom_pair_vec{{1, 2}, {3, 4}};
+			REQUIRE(getHash<CurrentPolicy>(custom_pair_vec) == getHash<CurrentPolicy>(std::vector<std::pair<int, int>>{{1, 2}, {3, 4}}));
+		}
+
+		SECTION("Registered contiguous containers generate the same hash as vectors") {
+			REQUIRE(getHash<CurrentPolicy>(ContiguousBuffer<int>{{1, 2, 3, 4}}) == getHash<CurrentPolicy>(std::vector<int>{1, 2, 3, 4}));
+			REQUIRE(getHash<CurrentPolicy>(ContiguousBuffer<std::string>{{"a", "b"}}) == getHash<CurrentPolicy>(std::vector<std::string>{"a", "b"}));
+		}
+
 		SECTION("Vectors and arrays of int generate the same hash (basic type)") {
 			REQUIRE(test_vec_arr<CurrentPolicy>(1, 2, 3, 4, 5, 6, 7, 8));
 		}
@@ -288,6 +332,119 @@ namespace dice::tests::hash {
 			dice::hash::DiceHash<CurrentPolicy>::hash_combine({a, b, c, d});
 		}
 	}
+
+	/** Checks that the fixed length path of Policy is equal to the dynamic one for length N, at every alignment. */
+	template<typename Policy, std::size_t N>
+	void check_fixed_length_hash(std::span<std::byte const> buffer) {
+		for (std::size_t offset = 0; offset < 8; ++offset) {
+			auto const *data = buffer.data() + offset;
+			auto const expected = Policy::hash_bytes(data, N);
+			REQUIRE(Policy::template hash_bytes_fixed<N>(data) == expected);
+
+			std::span<std::byte const, N> const fixed{data, N};
+			std::array<std::byte, N> arr{};
+			std::ranges::copy(fixed, arr.begin());
+			REQUIRE(dice::hash::DiceHash<decltype(fixed), Policy>{}(fixed) == expected);
+			REQUIRE(dice::hash::DiceHash<decltype(arr), Policy>{}(arr) == expected);
+
+			dice::hash::Policies::seeded_wyhash const keyed{42};
+			REQUIRE(keyed.hash_bytes_fixed<N>(data) == keyed.hash_bytes(data, N));
+		}
+	}
+
+	TEMPLATE_TEST_CASE("hash_bytes_fixed is equal to hash_bytes", "[DiceHash]", dice::hash::Policies::Martinus, dice::hash::Policies::wyhash) {
+		using Policy = TestType;
+
+		std::array<std::byte, 2 * dice::hash::Policies::max_fixed_len> buffer;
+		std::mt19937_64 rng{42};
+		std::ranges::generate(buffer, [&rng] { return static_cast<std::byte>(rng()); });
+
+		[&buffer]<std::size_t... lengths>(std::index_sequence<lengths...>) {
+			(check_fixed_length_hash<Policy, lengths>(buffer), ...);
+		}(std::make_index_sequence<dice::hash::Policies::max_fixed_len + 17>{});
+
+		SECTION("Arrays and spans of other fundamentals hash like vectors") {
+			std::array<uint32_t, 5> const arr{1, 2, 3, 4, 5};
+			std::vector<uint32_t> const vec{arr.begin(), arr.end()};
+			std::span<uint32_t const, 5> const span{arr};
+			REQUIRE(getHash<Policy>(arr) == getHash<Policy>(vec));
+			REQUIRE(getHash<Policy>(span) == getHash<Policy>(vec));
+		}
+	}
+
+	TEMPLATE_TEST_CASE("SeededDiceHash is keyed by its seed", "[DiceHash]", dice::hash::Policies::seeded_wyhash, dice::hash::Policies::seeded_xxh3) {
+		using Policy = TestType;
+		static_assert(dice::hash::Policies::KeyedHashPolicy<Policy>);
+		static_assert(!dice::hash::Policies::HashPolicy<Policy>);
+
+		std::string const long_str(1000, 'x');// exceeds the short input paths of xxh3
+		std::vector<std::string> const strs{"a", "b", long_str};
+		std::tuple<int, std::string, double> const tpl{42, "spherical cow", 0.5};
+
+		SECTION("The same seed generates the same hash") {
+			REQUIRE(dice::hash::SeededDiceHash<int, Policy>{1}(42) == dice::hash::SeededDiceHash<int, Policy>{1}(42));
+			REQUIRE(dice::hash::SeededDiceHash<std::string, Policy>{1}(long_str) == dice::hash::SeededDiceHash<std::string, Policy>{1}(long_str));
+			REQUIRE(dice::hash::SeededDiceHash<std::vector<std::string>, Policy>{1}(strs) == dice::hash::SeededDiceHash<std::vector<std::string>, Policy>{1}(strs));
+			REQUIRE(dice::hash::SeededDiceHash<decltype(tpl), Policy>{1}(tpl) == dice::hash::SeededDiceHash<decltype(tpl), Policy>{1}(tpl));
+		}
+
+		SECTION("Different seeds generate different hashes") {
+			REQUIRE(dice::hash::SeededDiceHash<int, Policy>{1}(42) != dice::hash::SeededDiceHash<int, Policy>{2}(42));
+			REQUIRE(dice::hash::SeededDiceHash<double, Policy>{1}(0.5) != dice::hash::SeededDiceHash<double, Policy>{2}(0.5));
+			REQUIRE(dice::hash::SeededDiceHash<std::string, Policy>{1}("a") != dice::hash::SeededDiceHash<std::string, Policy>{2}("a"));
+			REQUIRE(dice::hash::SeededDiceHash<std::string, Policy>{1}(long_str) != dice::hash::SeededDiceHash<std::string, Policy>{2}(long_str));
+			REQUIRE(dice::hash::SeededDiceHash<std::vector<std::string>, Policy>{1}(strs) != dice::hash::SeededDiceHash<std::vector<std::string>, Policy>{2}(strs));
+			REQUIRE(dice::hash::SeededDiceHash<decltype(tpl), Policy>{1}(tpl) != dice::hash::SeededDiceHash<decltype(tpl), Policy>{2}(tpl));
+		}
+
+		SECTION("Equivalent types generate the same hash, like with DiceHash") {
+			std::string const str{"spherical cow"};
+			std::vector<char> const vec{str.begin(), str.end()};
+			REQUIRE(dice::hash::SeededDiceHash<std::string, Policy>{1}(str) == dice::hash::SeededDiceHash<std::vector<char>, Policy>{1}(vec));
+			REQUIRE(dice::hash::SeededDiceHash<std::string, Policy>{1}(str) == dice::hash::SeededDiceHash<std::string_view, Policy>{1}(str));
+
+			std::pair<std::size_t, double> const p{1, 2.0};
+			std::tuple<std::size_t, double> const t{1, 2.0};
+			REQUIRE(dice::hash::SeededDiceHash<decltype(p), Policy>{1}(p) == dice::hash::SeededDiceHash<decltype(t), Policy>{1}(t));
+
+			std::unordered_set<std::string> const set1{"a", "b", "c"};
+			std::unordered_set<std::string> const set2{"c", "b", "a"};
+			REQUIRE(dice::hash::SeededDiceHash<decltype(set1), Policy>{1}(set1) == dice::hash::SeededDiceHash<decltype(set2), Policy>{1}(set2));
+		}
+
+		SECTION("Default constructed hashes share the process-wide random key") {
+			REQUIRE(dice::hash::SeededDiceHash<std::string, Policy>{}(long_str) == dice::hash::SeededDiceHash<std::string, Policy>{}(long_str));
+
+			dice::hash::SeededDiceHash<std::string, Policy> const hasher;
+			dice::hash::SeededDiceHash<std::string_view, Policy> const same_key{hasher.policy()};
+			REQUIRE(hasher("a") == same_key("a"));
+
+			std::unordered_set<std::string, dice::hash::SeededDiceHash<std::string, Policy>> set{strs.begin(), strs.end()};
+			REQUIRE(set.size() == strs.size());
+			REQUIRE(set.contains(long_str));
+		}
+
+		SECTION("combine and is_faulty") {
+			dice::hash::SeededDiceHash<int, Policy> const hasher{1};
+			REQUIRE(hasher.hash_combine({1, 2}) == hasher.hash_combine({1, 2}));
+			REQUIRE(hasher.hash_combine({1, 2}) != dice::hash::SeededDiceHash<int, Policy>{2}.hash_combine({1, 2}));
+			REQUIRE(hasher.hash_invertible_combine({hasher.hash_invertible_combine({1, 2}), 2}) == 1);
+			REQUIRE(dice::hash::SeededDiceHash<std::monostate, Policy>::is_faulty(dice::hash::SeededDiceHash<std::monostate, Policy>{1}(std::monostate{})));
+		}
+	}
+
+	TEST_CASE("seeded_xxh3 can use a custom secret", "[DiceHash]") {
+		using dice::hash::Policies::seeded_xxh3;
+
+		std::array<std::byte, seeded_xxh3::secret_size> secret{};
+		std::mt19937_64 rng{42};
+		std::ranges::generate(secret, [&rng] { return static_cast<std::byte>(rng()); });
+
+		seeded_xxh3 const policy{std::span<std::byte const, seeded_xxh3::secret_size>{secret}};
+		dice::hash::SeededDiceHash<std::string, seeded_xxh3> const hasher{policy};
+		REQUIRE(hasher("spherical cow") == policy.hash_bytes("spherical cow", 13));
+		REQUIRE(hasher("spherical cow") != dice::hash::SeededDiceHashxxh3<std::string>{42}("spherical cow"));
+	}
 }// namespace dice::tests::hash
 
 /*
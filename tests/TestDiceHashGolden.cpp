@@ -0,0 +1,294 @@
+#include <catch2/catch_all.hpp>
+
+#include <dice/hash.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <map>
+#include <set>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#define AllPoliciesToTestForDiceHash dice::hash::Policies::Martinus, dice::hash::Policies::xxh3, \
+									 dice::hash::Policies::wyhash
+
+/*
+ * Golden vectors: hash values that must never change for a given policy version, because users persist them.
+ * If a policy is changed intentionally, bump its version and regenerate the values of that policy.
+ * The values are only valid for 64-bit size_t, but do not depend on the endianness, the SIMD instruction set (e.g. xxh3 with
+ * SSE2, AVX2, NEON or scalar code) or the architecture of the platform. Only fixed width integer types are used, because the
+ * width of e.g. long differs between platforms.
+ */
+namespace dice::tests::hash::golden {
+	/** Hashes one value of every supported type path, in a fixed order. */
+	template<typename Policy>
+	std::vector<std::pair<std::string_view, std::uint64_t>> golden_hashes() {
+		std::vector<std::pair<std::string_view, std::uint64_t>> ret;
+		auto const push = [&]<typename T>(std::string_view name, T const &value) {
+			ret.emplace_back(name, static_cast<std::uint64_t>(dice::hash::DiceHash<T, Policy>{}(value)));
+		};
+
+		push("int 42", int{42});
+		push("int -1", int{-1});
+		push("int64_t 42", std::int64_t{42});
+		push("uint64_t", std::uint64_t{0xDEADBEEFCAFEBABEULL});
+		push("size_t 0", std::size_t{0});
+		push("int16_t", std::int16_t{-12345});
+		push("uint16_t", std::uint16_t{54321});
+		push("uint32_t", std::uint32_t{0x01020304});
+		push("char", char{'a'});
+		push("unsigned char", static_cast<unsigned char>(200));
+		push("bool", true);
+		push("std::byte", std::byte{0x7F});
+		push("float", 1.5F);
+		push("double", 3.141592653589793);
+		push("empty std::string", std::string{});
+		push("std::string", std::string{"spherical cow"});
+		push("long std::string", std::string(100, 'x') + "spherical cow");
+		push("std::u16string", std::u16string{u"spherical cow"});
+		push("std::u32string", std::u32string{U"spherical cow"});
+		push("std::string_view", std::string_view{"spherical cow"});
+		push("std::vector<int>", std::vector<int>{1, 2, 3, 4, 5});
+		push("std::vector<uint16_t>", std::vector<std::uint16_t>{1, 2, 3});
+		push("std::vector<double>", std::vector<double>{0.5, -0.25});
+		push("std::vector<std::string>", std::vector<std::string>{"a", "bc", ""});
+		push("std::vector<std::vector<int>>", std::vector<std::vector<int>>{{1}, {2, 3}});
+		push("std::array<int, 3>", std::array<int, 3>{7, 8, 9});
+		push("std::array<std::string, 2>", std::array<std::string, 2>{"x", "y"});
+		std::array<std::uint64_t, 2> const span_data{1, 2};
+		push("std::span<uint64_t const>", std::span<std::uint64_t const>{span_data});
+		push("std::tuple<int, int64_t, std::string>", std::tuple<int, std::int64_t, std::string>{1, 2, "three"});
+		push("std::pair<int, double>", std::pair<int, double>{1, 2.5});
+		push("std::set<int>", std::set<int>{3, 1, 2});
+		push("std::map<std::string, int>", std::map<std::string, int>{{"a", 1}, {"b", 2}});
+		push("std::unordered_set<int>", std::unordered_set<int>{3, 1, 2});
+		push("std::unordered_map<int, std::string>", std::unordered_map<int, std::string>{{1, "a"}, {2, "b"}});
+		push("std::variant<int, std::string>", std::variant<int, std::string>{std::string{"spherical cow"}});
+		push("std::variant<std::monostate>", std::variant<std::monostate>{});
+
+		// long inputs exercise the (vectorized) accumulation of xxh3, in one shot and streaming (HashState)
+		std::vector<std::uint64_t> long_vec(1000);
+		std::vector<std::string> long_str_vec(1000);
+		for (std::size_t ix = 0; ix < long_vec.size(); ++ix) {
+			long_vec[ix] = ix * ix;
+			long_str_vec[ix] = std::to_string(ix);
+		}
+		push("long std::vector<uint64_t>", long_vec);
+		push("long std::vector<std::string>", long_str_vec);
+		return ret;
+	}
+	using golden_table = std::array<std::pair<std::string_view, std::uint64_t>, 38>;
+
+	template<typename Policy>
+	struct Golden;
+
+	template<>
+	struct Golden<dice::hash::Policies::Martinus> {
+		static constexpr std::uint32_t version = 1;
+		static constexpr golden_table hashes{{
+			{"int 42", 0xA6516926A57F4AF2ULL},
+			{"int -1", 0x4B283CD4BE0234C6ULL},
+			{"int64_t 42", 0xA6516926A57F4AF2ULL},
+			{"uint64_t", 0xE1A31CBD4CE24B31ULL},
+			{"size_t 0", 0x0000000000000000ULL},
+			{"int16_t", 0xA2A50B4CB1645A01ULL},
+			{"uint16_t", 0xD6DF71573151DD31ULL},
+			{"uint32_t", 0xE4B5A51CC6C5900AULL},
+			{"char", 0xEDD466A71699CB91ULL},
+			{"unsigned char", 0x61222578B28EEAFDULL},
+			{"bool", 0x963EE407C0E48DF9ULL},
+			{"std::byte", 0x89331F79B1626ED1ULL},
+			{"float", 0x10CF54F5DA82E228ULL},
+			{"double", 0xCECA29EFDDC75F72ULL},
+			{"empty std::string", 0x9BFAE0A4E613FC3CULL},
+			{"std::string", 0x39E25BD3EFF18F8DULL},
+			{"long std::string", 0xF36331FAF59A1C34ULL},
+			{"std::u16string", 0xF7BA8993459CA0CDULL},
+			{"std::u32string", 0xB2900D162E6DFA70ULL},
+			{"std::string_view", 0x39E25BD3EFF18F8DULL},
+			{"std::vector<int>", 0x0298F06A8E7BBF55ULL},
+			{"std::vector<uint16_t>", 0x69790DDFD61EE3BCULL},
+			{"std::vector<double>", 0xFDFBCA293DCF85CAULL},
+			{"std::vector<std::string>", 0xEB00C6FB04330EC9ULL},
+			{"std::vector<std::vector<int>>", 0xF90A9FD0EA6C8A3EULL},
+			{"std::array<int, 3>", 0xAEA138390FA088D3ULL},
+			{"std::array<std::string, 2>", 0xC399E67DC0F5D10FULL},
+			{"std::span<uint64_t const>", 0xFB5754015E54D646ULL},
+			{"std::tuple<int, int64_t, std::string>", 0x9AD34F7FFB1D934CULL},
+			{"std::pair<int, double>", 0xF50C008FD484C74AULL},
+			{"std::set<int>", 0x07DEFF0841D741B2ULL},
+			{"std::map<std::string, int>", 0xF7A5C1CE66AFF97DULL},
+			{"std::unordered_set<int>", 0x78FF801C03803FE6ULL},
+			{"std::unordered_map<int, std::string>", 0x697AB7277D592F91ULL},
+			{"std::variant<int, std::string>", 0x39E25BD3EFF18F8DULL},
+			{"std::variant<std::monostate>", 0x00000000E17A1465ULL},
+			{"long std::vector<uint64_t>", 0xE60A7DD9642DF6A7ULL},
+			{"long std::vector<std::string>", 0xCEC656676937C4F4ULL},
+		}};
+	};
+
+	template<>
+	struct Golden<dice::hash::Policies::wyhash> {
+		static constexpr std::uint32_t version = 1;
+		static constexpr golden_table hashes{{
+			{"int 42", 0x3B0EB4013B74F581ULL},
+			{"int -1", 0x5F37A148793F1438ULL},
+			{"int64_t 42", 0x3B0EB4013B74F581ULL},
+			{"uint64_t", 0x06EFBA5A6A957E7BULL},
+			{"size_t 0", 0x12ABCC42D4730FE6ULL},
+			{"int16_t", 0x3668A52F186A4E81ULL},
+			{"uint16_t", 0x61B787B696CA8DB8ULL},
+			{"uint32_t", 0x797067830754638EULL},
+			{"char", 0xB95EC1E1306A7664ULL},
+			{"unsigned char", 0x987C5DAFE657AA4EULL},
+			{"bool", 0x4181F42B3F79D57CULL},
+			{"std::byte", 0xC278D7FF813D395FULL},
+			{"float", 0xEB96255F51A59E12ULL},
+			{"double", 0x8953714710C5B66BULL},
+			{"empty std::string", 0x8C5B1BA5B97BDDD8ULL},
+			{"std::string", 0xF2587AED6794690BULL},
+			{"long std::string", 0xA40EE144C439CF55ULL},
+			{"std::u16string", 0x97DC4E052770ABFCULL},
+			{"std::u32string", 0x58F5312DD25BA1BDULL},
+			{"std::string_view", 0xF2587AED6794690BULL},
+			{"std::vector<int>", 0x70106F5DC65938C9ULL},
+			{"std::vector<uint16_t>", 0x68F395286ABEFD50ULL},
+			{"std::vector<double>", 0xDEF52BF05BABE886ULL},
+			{"std::vector<std::string>", 0xAC1738F43AA35EA0ULL},
+			{"std::vector<std::vector<int>>", 0x15F80938A90A8DF7ULL},
+			{"std::array<int, 3>", 0x23C948DF4B2BDC46ULL},
+			{"std::array<std::string, 2>", 0xE371452C9DB943CCULL},
+			{"std::span<uint64_t const>", 0x0615F4B8ADB6DB42ULL},
+			{"std::tuple<int, int64_t, std::string>", 0x612ADDEB5B49F908ULL},
+			{"std::pair<int, double>", 0xDC3803E4D2161BE3ULL},
+			{"std::set<int>", 0xAAB05A2C3F953A6BULL},
+			{"std::map<std::string, int>", 0x5959F0081383428AULL},
+			{"std::unordered_set<int>", 0x3DC4882AA871D576ULL},
+			{"std::unordered_map<int, std::string>", 0x6449B3125C4F3AC6ULL},
+			{"std::variant<int, std::string>", 0xF2587AED6794690BULL},
+			{"std::variant<std::monostate>", 0x00000000E17A1465ULL},
+			{"long std::vector<uint64_t>", 0xA4C00C0B597AECE9ULL},
+			{"long std::vector<std::string>", 0xE3AE6632981CE27DULL},
+		}};
+	};
+
+	template<>
+	struct Golden<dice::hash::Policies::xxh3> {
+		static constexpr std::uint32_t version = 1;
+		static constexpr golden_table hashes{{
+			{"int 42", 0xFCCDAE403310266BULL},
+			{"int -1", 0x0E7C77B35BE9A234ULL},
+			{"int64_t 42", 0xD7582BD37C507F7EULL},
+			{"uint64_t", 0xB9FFDC4802ED5ED7ULL},
+			{"size_t 0", 0xE46C58AC69EF471EULL},
+			{"int16_t", 0xCFC7134C7467F06AULL},
+			{"uint16_t", 0xF8F6FD1EB53BC4F9ULL},
+			{"uint32_t", 0x482AD9409A27C708ULL},
+			{"char", 0x75EE4C1D92E2C8A0ULL},
+			{"unsigned char", 0x9DA889360B2EB10CULL},
+			{"bool", 0x4BD91145A8A4701AULL},
+			{"std::byte", 0x004405F549D3DD76ULL},
+			{"float", 0x3FB7A78D757940CBULL},
+			{"double", 0xF385F39124C44927ULL},
+			{"empty std::string", 0x170EE631D2189CDFULL},
+			{"std::string", 0x92AE3A56A6C6C06FULL},
+			{"long std::string", 0x82024296B8D04B62ULL},
+			{"std::u16string", 0xCBFBFE6E6EB3D82AULL},
+			{"std::u32string", 0xDAE10A8343F5E19AULL},
+			{"std::string_view", 0x92AE3A56A6C6C06FULL},
+			{"std::vector<int>", 0xD61B9BD5A71FA065ULL},
+			{"std::vector<uint16_t>", 0x0DD20606B319085DULL},
+			{"std::vector<double>", 0xA18B9039A2E585EDULL},
+			{"std::vector<std::string>", 0x70F1E0A89C2ABF37ULL},
+			{"std::vector<std::vector<int>>", 0x7F62D07B9E5A0D54ULL},
+			{"std::array<int, 3>", 0x277D47E30A40ABE6ULL},
+			{"std::array<std::string, 2>", 0x28817E4479998500ULL},
+			{"std::span<uint64_t const>", 0x8E6B908D468B0BDAULL},
+			{"std::tuple<int, int64_t, std::string>", 0x937C892EB040D524ULL},
+			{"std::pair<int, double>", 0xF98D268DE80908B1ULL},
+			{"std::set<int>", 0x1E400227CB4975A1ULL},
+			{"std::map<std::string, int>", 0xCA1B882B9E35A46CULL},
+			{"std::unordered_set<int>", 0xEE96C5A1798BBB0BULL},
+			{"std::unordered_map<int, std::string>", 0xE49B513612F99151ULL},
+			{"std::variant<int, std::string>", 0x92AE3A56A6C6C06FULL},
+			{"std::variant<std::monostate>", 0xA24BAED4963EE407ULL},
+			{"long std::vector<uint64_t>", 0x83F92C4F1938A145ULL},
+			{"long std::vector<std::string>", 0x841A30CB2CC59C79ULL},
+		}};
+	};
+
+	TEMPLATE_TEST_CASE("DiceHash values match the golden vectors of the policy version", "[DiceHash]", AllPoliciesToTestForDiceHash) {
+		using Policy = TestType;
+
+		REQUIRE(dice::hash::Policies::policy_version_v<Policy> == Golden<Policy>::version);
+		REQUIRE(dice::hash::DiceHash<int, Policy>::policy_version == Golden<Policy>::version);
+
+		if constexpr (sizeof(std::size_t) == sizeof(std::uint64_t)) {
+			auto const actual = golden_hashes<Policy>();
+			auto const &expected = Golden<Policy>::hashes;
+			REQUIRE(actual.size() == expected.size());
+
+			for (std::size_t ix = 0; ix < expected.size(); ++ix) {
+				INFO(expected[ix].first);
+				REQUIRE(actual[ix].first == expected[ix].first);
+				CHECK(actual[ix].second == expected[ix].second);
+			}
+		} else {
+			WARN("golden vectors are only defined for 64-bit size_t");
+		}
+	}
+
+	TEST_CASE("fundamentals are normalized to little endian before hashing", "[DiceHash]") {
+		auto const normalized = dice::hash::Policies::detail::to_little_endian(std::uint32_t{0x01020304});
+		auto const bytes = std::bit_cast<std::array<std::byte, 4>>(normalized);
+		REQUIRE(bytes == std::array<std::byte, 4>{std::byte{4}, std::byte{3}, std::byte{2}, std::byte{1}});
+
+		REQUIRE(dice::hash::Policies::detail::to_little_endian(std::uint8_t{42}) == 42);
+	}
+
+	/** Stores the values in big endian byte order (as a big endian platform does) and checks that hash_elements hashes them
+	 * like hash_bytes hashes their little endian representation. */
+	template<typename T, typename Policy>
+	void require_big_endian_elements_hash_like_little_endian(Policy const &policy) {
+		// lengths around the kernels' block sizes and beyond the stack buffer of the streaming policies
+		for (std::size_t const size : std::initializer_list<std::size_t>{0, 1, 2, 3, 5, 7, 17, 48, 49, 97, 241, 1'000, 4'096 / sizeof(T), 4'096 / sizeof(T) + 1, 10'000}) {
+			CAPTURE(sizeof(T), size);
+			std::vector<unsigned char> little(size * sizeof(T));
+			for (std::size_t ix = 0; ix < little.size(); ++ix) {
+				little[ix] = static_cast<unsigned char>(ix * 131 + ix / 7);
+			}
+			auto big = little;
+			for (std::size_t elem = 0; elem < big.size(); elem += sizeof(T)) {
+				std::reverse(big.begin() + static_cast<std::ptrdiff_t>(elem), big.begin() + static_cast<std::ptrdiff_t>(elem + sizeof(T)));
+			}
+
+			REQUIRE(policy.template hash_elements<sizeof(T), std::endian::big>(big.data(), big.size()) == policy.hash_bytes(little.data(), little.size()));
+			REQUIRE(policy.template hash_elements<sizeof(T), std::endian::little>(little.data(), little.size()) == policy.hash_bytes(little.data(), little.size()));
+		}
+	}
+
+	TEMPLATE_TEST_CASE("hash_elements reads big endian elements as little endian", "[DiceHash]", AllPoliciesToTestForDiceHash,
+					   dice::hash::Policies::seeded_wyhash, dice::hash::Policies::seeded_xxh3) {
+		auto const policy = [] {
+			if constexpr (dice::hash::Policies::KeyedHashPolicy<TestType>) {
+				return TestType{42};
+			} else {
+				return TestType{};
+			}
+		}();
+		require_big_endian_elements_hash_like_little_endian<std::uint16_t>(policy);
+		require_big_endian_elements_hash_like_little_endian<std::uint32_t>(policy);
+		require_big_endian_elements_hash_like_little_endian<std::uint64_t>(policy);
+		require_big_endian_elements_hash_like_little_endian<long double>(policy);
+	}
+}// namespace dice::tests::hash::golden
@@ -0,0 +1,63 @@
+#include <catch2/catch_all.hpp>
+
+#include <dice/hash.hpp>
+#include <dice/hash/BoostContainers.hpp>
+
+#include <metall/container/map.hpp>
+#include <metall/container/string.hpp>
+#include <metall/container/unordered_map.hpp>
+#include <metall/container/vector.hpp>
+#include <metall/metall.hpp>
+
+#include <cstdint>
+#include <map>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+	using metall_vector = metall::container::vector<uint64_t>;
+	using metall_map = metall::container::map<uint64_t, uint64_t>;
+	using metall_unordered_map = metall::container::unordered_map<uint64_t, uint64_t>;
+
+	template<typename T>
+	std::size_t hash(T const &value) {
+		return dice::hash::DiceHash<T>{}(value);
+	}
+} // namespace
+
+TEST_CASE("DiceHash hashes metall containers like std containers", "[DiceHash]") {
+	std::string const path{"/tmp/" + std::to_string(std::random_device{}())};
+
+	std::string const str{"spherical cow"};
+	std::vector<uint64_t> const vec{1, 2, 3, 4};
+	std::map<uint64_t, uint64_t> const map{{1, 10}, {2, 20}};
+	std::unordered_map<uint64_t, uint64_t> const unordered_map{{1, 10}, {2, 20}};
+
+	{ // create the containers in the segment
+		metall::manager manager(metall::create_only, path.c_str());
+
+		auto *metall_str = manager.construct<metall::container::string>("str")(str.c_str(), manager.get_allocator());
+		auto *metall_vec = manager.construct<metall_vector>("vec")(vec.begin(), vec.end(), manager.get_allocator());
+		auto *metall_ordered = manager.construct<metall_map>("map")(map.begin(), map.end(), manager.get_allocator());
+		auto *metall_unordered = manager.construct<metall_unordered_map>("unordered_map")(manager.get_allocator());
+		metall_unordered->insert(unordered_map.begin(), unordered_map.end());
+
+		REQUIRE(hash(*metall_str) == hash(str));
+		REQUIRE(hash(*metall_vec) == hash(vec));
+		REQUIRE(hash(*metall_ordered) == hash(map));
+		REQUIRE(hash(*metall_unordered) == hash(unordered_map));
+	}
+
+	{ // the hashes are stable across reopening the segment
+		metall::manager manager(metall::open_only, path.c_str());
+
+		REQUIRE(hash(*std::get<0>(manager.find<metall::container::string>("str"))) == hash(str));
+		REQUIRE(hash(*std::get<0>(manager.find<metall_vector>("vec"))) == hash(vec));
+		REQUIRE(hash(*std::get<0>(manager.find<metall_map>("map"))) == hash(map));
+		REQUIRE(hash(*std::get<0>(manager.find<metall_unordered_map>("unordered_map"))) == hash(unordered_map));
+	}
+
+	metall::manager::remove(path.c_str());
+}
@@ -0,0 +1,144 @@
+#include <catch2/catch_all.hpp>
+
+#include <dice/hash/blake/Blake2Xb.hpp>
+#include <dice/hash/lthash/DynamicLtHash.hpp>
+
+#include "TestLtHash_common.hpp"
+
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+using namespace dice::hash::lthash;
+
+namespace {
+	auto const obj3 = as_bytes(std::span{"hello", 5});
+
+	template<typename Static, template<size_t> typename HashT = dice::hash::blake3::Blake3>
+	void check_equals_static() {
+		auto const key = as_bytes(std::span<char const, 32>{"0123456789abcdef0123456789abcdef", 32});
+
+		Static s;
+		s.set_key(key);
+		s.add(obj1).add(obj2).add(obj3).remove(obj2);
+
+		DynamicLtHash<HashT> d{Static::element_bits, Static::element_count};
+		d.set_key(key);
+		d.add(obj1).add(obj2).add(obj3).remove(obj2);
+
+		CHECK(d.checksum_len() == Static::checksum_len);
+		CHECK(d.needs_padding() == Static::needs_padding);
+		CHECK(std::ranges::equal(d.checksum(), s.checksum()));
+		CHECK(reinterpret_cast<uintptr_t>(d.checksum().data()) % alignof(uint64_t) == 0);
+	}
+} // namespace
+
+TEST_CASE("DynamicLtHash", "[DiceHash]") {
+	SECTION("same checksums as LtHash") {
+		check_equals_static<LtHash16>();
+		check_equals_static<LtHash20>();
+		check_equals_static<LtHash32>();
+		check_equals_static<LtHash<16, 4096>>();
+		check_equals_static<LtHash<32, 4096, dice::hash::blake3::Blake3, MathEngine_Simple>>();
+		check_equals_static<LtHash<20, 1008, dice::hash::blake2xb::Blake2Xb>, dice::hash::blake2xb::Blake2Xb>(); // hashes objects into a buffer
+	}
+
+	SECTION("invalid dimensions") {
+		CHECK_THROWS_AS((DynamicLtHash<>{24, 1024}), std::invalid_argument);
+		CHECK_THROWS_AS((DynamicLtHash<>{16, 1000}), std::invalid_argument);
+		CHECK_THROWS_AS((DynamicLtHash<>{20, 1024}), std::invalid_argument);
+		CHECK_THROWS_AS((DynamicLtHash<>{32, 0}), std::invalid_argument);
+	}
+
+	SECTION("add and remove") {
+		DynamicLtHash<> h{20, 1008};
+		DynamicLtHash<> const empty{20, 1008};
+
+		h.add(obj1);
+		CHECK(h != empty);
+		h.remove(obj1);
+		CHECK(h == empty);
+	}
+
+	SECTION("combine") {
+		DynamicLtHash<> h1{32, 1024};
+		h1.add(obj1);
+		DynamicLtHash<> h2{32, 1024};
+		h2.add(obj2);
+
+		DynamicLtHash<> h3{32, 1024};
+		h3.add(obj1).add(obj2);
+
+		h1.combine_add(h2);
+		CHECK(h1 == h3);
+		h1.combine_remove(h2);
+		h3.remove(obj2);
+		CHECK(h1 == h3);
+
+		DynamicLtHash<> other_dims{32, 2048};
+		CHECK_THROWS_AS(h1.combine_add(other_dims), std::invalid_argument);
+
+		DynamicLtHash<> other_key{32, 1024};
+		std::array<std::byte, 32> key;
+		key.fill(std::byte{1});
+		other_key.set_key(std::span<std::byte const, 32>{key});
+		CHECK_THROWS_AS(h1.combine_remove(other_key), std::invalid_argument);
+	}
+
+	SECTION("copy and move") {
+		DynamicLtHash<> h1{16, 1024};
+		STATIC_REQUIRE(noexcept(h1.add(obj1)));
+		STATIC_REQUIRE(noexcept(h1.remove(obj1)));
+		h1.add(obj1);
+
+		DynamicLtHash<> h2{h1};
+		CHECK(h1 == h2);
+		h2.add(obj2);
+		CHECK(h1 != h2);
+
+		auto const *data = h2.checksum().data();
+		DynamicLtHash<> h3{std::move(h2)};
+		CHECK(h3.checksum().data() == data); // moves do not copy the checksum
+		CHECK(h2.checksum().empty());
+
+		DynamicLtHash<> h4{32, 2048};
+		h4 = h1;
+		CHECK(h4 == h1);
+		CHECK(h4.element_bits() == 16);
+
+		h4 = std::move(h3);
+		CHECK(h4.checksum().data() == data);
+
+		h3 = h1; // assigning to a moved-from object
+		CHECK(h3 == h1);
+	}
+
+	SECTION("set checksum") {
+		DynamicLtHash<> h1{20, 1008};
+		h1.add(obj1);
+
+		DynamicLtHash<> h2{20, 1008, h1.checksum()};
+		CHECK(h1 == h2);
+
+		std::vector<std::byte> invalid{h1.checksum().begin(), h1.checksum().end()};
+		invalid[7] = std::byte{0xFF};
+		CHECK_THROWS_AS(h2.set_checksum(invalid), std::invalid_argument);
+
+		invalid.pop_back();
+		CHECK_THROWS_AS(h2.set_checksum(invalid), std::invalid_argument);
+
+		h2.clear_checksum();
+		CHECK(h2 == DynamicLtHash<>{20, 1008});
+	}
+
+	SECTION("constant time equality") {
+		DynamicLtHash<> h1{16, 1024};
+		h1.add(obj1);
+		DynamicLtHash<> h2{h1};
+		CHECK(h1.checksum_equal_constant_time(h2));
+		h2.add(obj1);
+		CHECK_FALSE(h1.checksum_equal_constant_time(h2));
+		CHECK_FALSE(h1.checksum_equal_constant_time(std::span<std::byte const>{}));
+	}
+}
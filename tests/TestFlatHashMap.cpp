@@ -0,0 +1,303 @@
+#include <catch2/catch_all.hpp>
+
+#include <dice/hash/FlatHashMap.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using namespace dice::hash;
+
+namespace {
+	template<typename Map, typename Reference>
+	void require_equal(Map const &map, Reference const &reference) {
+		REQUIRE(map.size() == reference.size());
+		for (auto const &[key, value] : reference) {
+			auto const *found = map.find(key);
+			REQUIRE(found != nullptr);
+			REQUIRE(*found == value);
+		}
+
+		size_t visited = 0;
+		map.for_each([&](auto const &key, auto const &value) {
+			REQUIRE(reference.at(key) == value);
+			++visited;
+		});
+		REQUIRE(visited == reference.size());
+	}
+
+	/**
+	 * @brief a std::allocator with an id, allocators compare equal iff their ids are equal
+	 */
+	template<typename T, bool Propagate>
+	struct IdAllocator {
+		using value_type = T;
+		using propagate_on_container_copy_assignment = std::bool_constant<Propagate>;
+		using propagate_on_container_move_assignment = std::bool_constant<Propagate>;
+		using is_always_equal = std::false_type;
+
+		int id = 0;
+
+		IdAllocator() = default;
+		explicit IdAllocator(int id) noexcept : id{id} {}
+		template<typename U>
+		IdAllocator(IdAllocator<U, Propagate> const &other) noexcept : id{other.id} {}
+
+		template<typename U>
+		struct rebind {
+			using other = IdAllocator<U, Propagate>;
+		};
+
+		T *allocate(size_t n) {
+			return std::allocator<T>{}.allocate(n);
+		}
+
+		void deallocate(T *ptr, size_t n) noexcept {
+			std::allocator<T>{}.deallocate(ptr, n);
+		}
+
+		template<typename U>
+		bool operator==(IdAllocator<U, Propagate> const &other) const noexcept {
+			return id == other.id;
+		}
+	};
+} // namespace
+
+TEMPLATE_TEST_CASE("FlatHashMap behaves like std::unordered_map", "[DiceHash]", DiceHash<uint64_t>, std::hash<uint64_t>) {
+	// std::hash<uint64_t> is the identity, the map must cope with it
+	FlatHashMap<uint64_t, uint64_t, TestType> map;
+	std::unordered_map<uint64_t, uint64_t> reference;
+
+	std::mt19937_64 rng{42};
+	for (size_t i = 0; i < 20'000; ++i) {
+		auto const key = rng() % 2'000;// sequential keys, so the probe sequences collide and the table grows a few times
+		switch (rng() % 4) {
+			case 0: {
+				REQUIRE(map.erase(key) == (reference.erase(key) == 1));
+				break;
+			}
+			case 1: {
+				map[key] = i;
+				reference[key] = i;
+				break;
+			}
+			default: {
+				auto const [value, inserted] = map.try_emplace(key, i);
+				auto const [it, reference_inserted] = reference.try_emplace(key, i);
+				REQUIRE(inserted == reference_inserted);
+				REQUIRE(*value == it->second);
+				break;
+			}
+		}
+		REQUIRE(map.contains(key) == reference.contains(key));
+	}
+	require_equal(map, reference);
+
+	// erase everything (exercises the backward shift)
+	for (uint64_t key = 0; key < 2'000; ++key) {
+		REQUIRE(map.erase(key) == (reference.erase(key) == 1));
+	}
+	REQUIRE(map.empty());
+	REQUIRE(map.find(0) == nullptr);
+}
+
+TEST_CASE("FlatHashMap find_bulk and insert_bulk are equal to the single key operations", "[DiceHash]") {
+	using Map = FlatHashMap<uint64_t, uint64_t>;
+
+	std::mt19937_64 rng{7};
+	std::vector<std::pair<uint64_t, uint64_t>> entries;
+	for (size_t i = 0; i < 10'000; ++i) {
+		entries.emplace_back(rng() % 8'000, i);// contains duplicate keys
+	}
+
+	Map bulk;
+	Map single;
+	size_t inserted = 0;
+	for (auto const &entry : entries) {
+		inserted += single.insert(entry).second;
+	}
+	REQUIRE(bulk.insert_bulk(entries) == inserted);
+	REQUIRE(bulk.size() == single.size());
+	REQUIRE(bulk.insert_bulk(entries) == 0);
+
+	std::vector<uint64_t> keys;
+	for (size_t i = 0; i < 10'000; ++i) {
+		keys.push_back(rng() % 16'000);// about half of the keys are missing
+	}
+
+	auto const check = [&](Map const &map, Map const &expected_map) {
+		std::vector<uint64_t const *> values(keys.size());
+		map.find_bulk(std::span<uint64_t const>{keys}, std::span{values});
+		for (size_t i = 0; i < keys.size(); ++i) {
+			auto const *expected = expected_map.find(keys[i]);
+			REQUIRE((values[i] == nullptr) == (expected == nullptr));
+			if (expected != nullptr) {
+				REQUIRE(*values[i] == *expected);
+			}
+		}
+	};
+	check(bulk, single);
+
+	SECTION("different prefetch distances") {
+		size_t calls = 0;
+		bulk.find_bulk<1>(keys, [&](size_t i, uint64_t *value) {
+			REQUIRE(i == calls++);
+			REQUIRE(value == bulk.find(keys[i]));
+		});
+		REQUIRE(calls == keys.size());
+
+		calls = 0;
+		bulk.find_bulk<64>(std::span{keys}.first(10), [&](size_t i, uint64_t *value) {
+			REQUIRE(i == calls++);
+			REQUIRE(value == bulk.find(keys[i]));
+		});
+		REQUIRE(calls == 10);
+	}
+
+	SECTION("empty map and empty input") {
+		Map empty;
+		check(empty, empty);
+		REQUIRE(empty.insert_bulk({}) == 0);
+		empty.find_bulk(std::span<uint64_t const>{}, [](size_t, uint64_t const *) { FAIL(); });
+	}
+}
+
+TEST_CASE("FlatHashMap with non-trivial keys and values", "[DiceHash]") {
+	using Map = FlatHashMap<std::string, std::unique_ptr<std::string>>;
+
+	Map map{100};
+	auto const capacity = map.capacity();
+	for (size_t i = 0; i < 100; ++i) {
+		auto const key = std::to_string(i);
+		REQUIRE(map.try_emplace(key, std::make_unique<std::string>(key)).second);
+	}
+	REQUIRE(map.capacity() == capacity);// reserved in the constructor
+
+	for (size_t i = 0; i < 1'000; ++i) {// grows and moves the values
+		auto const key = std::to_string(i);
+		map.try_emplace(key, std::make_unique<std::string>(key));
+	}
+	for (size_t i = 0; i < 1'000; i += 2) {
+		REQUIRE(map.erase(std::to_string(i)));
+	}
+
+	Map moved{std::move(map)};
+	REQUIRE(moved.size() == 500);
+	for (size_t i = 0; i < 1'000; ++i) {
+		auto const key = std::to_string(i);
+		auto const *value = moved.find(key);
+		if (i % 2 == 0) {
+			REQUIRE(value == nullptr);
+		} else {
+			REQUIRE(**value == key);
+		}
+	}
+
+	moved.clear();
+	REQUIRE(moved.empty());
+	REQUIRE_FALSE(moved.contains("1"));
+}
+
+TEST_CASE("FlatHashMap copies", "[DiceHash]") {
+	FlatHashMap<std::string, size_t> map;
+	std::unordered_map<std::string, size_t> reference;
+	for (size_t i = 0; i < 300; ++i) {
+		map[std::to_string(i)] = i;
+		reference[std::to_string(i)] = i;
+	}
+
+	auto copy = map;
+	require_equal(copy, reference);
+
+	copy.erase("1");
+	REQUIRE(map.contains("1"));
+
+	map = copy;
+	REQUIRE_FALSE(map.contains("1"));
+	REQUIRE(map.size() == 299);
+}
+
+TEST_CASE("FlatHashMap lookups of existing keys do not grow the table", "[DiceHash]") {
+	FlatHashMap<uint64_t, uint64_t> map;
+	uint64_t key = 0;
+	// fill up to the maximum load factor, the next new key grows the table
+	while (map.size() + 1 <= map.capacity() / 4 * 3 || map.capacity() == 0) {
+		map[key] = key;
+		++key;
+	}
+	auto const capacity = map.capacity();
+	auto *value = map.find(0);
+
+	REQUIRE_FALSE(map.try_emplace(0, 42).second);
+	REQUIRE(&map[0] == value);
+	REQUIRE(map.capacity() == capacity);
+	REQUIRE(map.find(0) == value);
+
+	// the key refers into the map
+	FlatHashMap<std::string, size_t> strings;
+	for (size_t i = 0; i < 12; ++i) {
+		strings[std::to_string(i)] = i;
+	}
+	std::string const *existing = nullptr;
+	strings.for_each([&existing](std::string const &k, size_t) { existing = &k; });
+	REQUIRE_FALSE(strings.try_emplace(*existing).second);
+
+	// a new key grows the table
+	map[key] = key;
+	REQUIRE(map.capacity() == 2 * capacity);
+	REQUIRE(map.size() == key + 1);
+	for (uint64_t k = 0; k <= key; ++k) {
+		REQUIRE(*map.find(k) == k);
+	}
+}
+
+TEMPLATE_TEST_CASE_SIG("FlatHashMap assignments respect the allocator traits", "[DiceHash]", ((bool Propagate), Propagate), false, true) {
+	using Allocator = IdAllocator<std::pair<std::string, size_t>, Propagate>;
+	using Map = FlatHashMap<std::string, size_t, DiceHash<std::string>, std::equal_to<std::string>, Allocator>;
+
+	Map map{0, {}, {}, Allocator{1}};
+	for (size_t i = 0; i < 100; ++i) {
+		map[std::to_string(i)] = i;
+	}
+
+	SECTION("copy assignment") {
+		Map copy{0, {}, {}, Allocator{2}};
+		copy["x"] = 1;
+		copy = map;
+		REQUIRE(copy.get_allocator().id == (Propagate ? 1 : 2));
+		REQUIRE(copy.size() == 100);
+		REQUIRE(*copy.find("42") == 42);
+		REQUIRE_FALSE(copy.contains("x"));
+		REQUIRE(map.size() == 100);
+	}
+
+	SECTION("move assignment") {
+		Map target{0, {}, {}, Allocator{2}};
+		target["x"] = 1;
+		auto const *value = map.find("42");
+		target = std::move(map);
+		REQUIRE(target.get_allocator().id == (Propagate ? 1 : 2));
+		REQUIRE(target.size() == 100);
+		REQUIRE(*target.find("42") == 42);
+		REQUIRE_FALSE(target.contains("x"));
+		// the slots are only taken over if the allocator propagates
+		REQUIRE((target.find("42") == value) == Propagate);
+	}
+
+	SECTION("move assignment with equal allocators") {
+		Map target{0, {}, {}, Allocator{1}};
+		auto const *value = map.find("42");
+		target = std::move(map);
+		REQUIRE(target.find("42") == value);
+		REQUIRE(target.size() == 100);
+	}
+
+	STATIC_REQUIRE(std::is_nothrow_move_assignable_v<Map> == Propagate);
+	STATIC_REQUIRE(std::is_nothrow_move_assignable_v<FlatHashMap<std::string, size_t>>);
+}
@@ -0,0 +1,138 @@
+#include <catch2/catch_all.hpp>
+
+#include <dice/hash/HashFile.hpp>
+#ifdef DICE_HASH_TEST_WITH_SODIUM
+#include <dice/hash/blake/Blake2Xb.hpp>
+#include <dice/hash/blake/Blake2b.hpp>
+#endif
+
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <string_view>
+#include <vector>
+
+using namespace dice::hash;
+
+namespace {
+	struct TempFile {
+		std::filesystem::path path;
+
+		TempFile(std::string const &name, std::span<std::byte const> contents)
+			: path{std::filesystem::temp_directory_path() / ("dice_hash_test_" + name)} {
+			std::ofstream out{path, std::ios::binary | std::ios::trunc};
+			out.write(reinterpret_cast<char const *>(contents.data()), static_cast<std::streamsize>(contents.size()));
+		}
+
+		TempFile(TempFile const &) = delete;
+
+		~TempFile() {
+			std::filesystem::remove(path);
+		}
+	};
+
+	std::vector<std::byte> make_contents(size_t size) {
+		std::vector<std::byte> contents;
+		contents.resize(size);
+		for (size_t ix = 0; ix < size; ++ix) {
+			contents[ix] = static_cast<std::byte>((ix * 7) ^ (ix >> 9));
+		}
+		return contents;
+	}
+
+	constexpr std::array<FileHashOptions, 4> all_options{FileHashOptions{.mode = FileReadMode::automatic},
+														 FileHashOptions{.mode = FileReadMode::mmap},
+														 FileHashOptions{.mode = FileReadMode::stream},
+														 FileHashOptions{.mode = FileReadMode::stream, .block_size = 1}};
+} // namespace
+
+TEST_CASE("hash_file", "[DiceHash]") {
+	for (size_t const size : {size_t{0}, size_t{1}, size_t{4095}, size_t{4096}, size_t{100'000}, (size_t{3} << 20) + 17}) {
+		auto const contents = make_contents(size);
+		TempFile const file{std::to_string(size), contents};
+
+		for (auto const &options : all_options) {
+			CAPTURE(size, static_cast<int>(options.mode), options.block_size);
+
+			SECTION("Blake3 " + std::to_string(size) + " " + std::to_string(static_cast<int>(options.mode)) + " " + std::to_string(options.block_size)) {
+				std::array<std::byte, 32> expected;
+				blake3::Blake3<32>::hash_single(contents, expected);
+
+				std::array<std::byte, 32> actual;
+				hash_file<blake3::Blake3<32>>(file.path, actual, options);
+				CHECK(expected == actual);
+
+				std::vector<std::byte> actual_dynamic;
+				actual_dynamic.resize(32);
+				hash_file<blake3::Blake3<>>(file.path, actual_dynamic, options);
+				CHECK(std::equal(expected.begin(), expected.end(), actual_dynamic.begin(), actual_dynamic.end()));
+
+				ThreadPool pool{3};
+				blake3::Blake3<32> parallel;
+				digest_file_parallel(parallel, file.path, pool, options);
+				std::move(parallel).finish(actual);
+				CHECK(expected == actual);
+			}
+
+			SECTION("policies " + std::to_string(size) + " " + std::to_string(static_cast<int>(options.mode)) + " " + std::to_string(options.block_size)) {
+				std::string_view const contents_view{reinterpret_cast<char const *>(contents.data()), contents.size()};
+
+				CHECK(hash_file<Policies::Martinus>(file.path, options) == DiceHash<std::string_view, Policies::Martinus>{}(contents_view));
+				CHECK(hash_file<Policies::wyhash>(file.path, options) == DiceHash<std::string_view, Policies::wyhash>{}(contents_view));
+				CHECK(hash_file<Policies::xxh3>(file.path, options) == DiceHash<std::string_view, Policies::xxh3>{}(contents_view));
+			}
+
+#ifdef DICE_HASH_TEST_WITH_SODIUM
+			SECTION("Blake2b and Blake2Xb " + std::to_string(size) + " " + std::to_string(static_cast<int>(options.mode)) + " " + std::to_string(options.block_size)) {
+				std::array<std::byte, 64> expected;
+				std::array<std::byte, 64> actual;
+
+				blake2b::Blake2b<64>::hash_single(contents, expected);
+				hash_file<blake2b::Blake2b<64>>(file.path, actual, options);
+				CHECK(expected == actual);
+
+				std::vector<std::byte> expected_xb(300);
+				std::vector<std::byte> actual_xb(300);
+				blake2xb::Blake2Xb<>::hash_single(contents, expected_xb);
+				hash_file<blake2xb::Blake2Xb<>>(file.path, actual_xb, options);
+				CHECK(expected_xb == actual_xb);
+			}
+#endif
+		}
+	}
+
+	SECTION("errors") {
+		std::array<std::byte, 32> out;
+		CHECK_THROWS_AS(hash_file<blake3::Blake3<32>>(std::filesystem::temp_directory_path() / "dice_hash_test_does_not_exist", out), std::system_error);
+		CHECK_THROWS_AS(hash_file<Policies::Martinus>(std::filesystem::temp_directory_path() / "dice_hash_test_does_not_exist"), std::system_error);
+	}
+
+	SECTION("non-regular files are streamed") {
+		std::array<std::byte, 32> expected;
+		blake3::Blake3<32>::hash_single({}, expected);
+
+		std::array<std::byte, 32> actual;
+		hash_file<blake3::Blake3<32>>("/dev/null", actual);
+		CHECK(expected == actual);
+	}
+
+	SECTION("files that report a size of 0 but have contents are read") {
+		std::filesystem::path const proc_file{"/proc/version"};
+		if (std::filesystem::exists(proc_file)) {
+			std::array<std::byte, 32> empty;
+			blake3::Blake3<32>::hash_single({}, empty);
+
+			std::array<std::byte, 32> streamed;
+			hash_file<blake3::Blake3<32>>(proc_file, streamed, FileHashOptions{.mode = FileReadMode::stream});
+			CHECK(streamed != empty);
+
+			std::array<std::byte, 32> automatic;
+			hash_file<blake3::Blake3<32>>(proc_file, automatic);
+			CHECK(automatic == streamed);
+			CHECK(hash_file<Policies::Martinus>(proc_file) == hash_file<Policies::Martinus>(proc_file, FileHashOptions{.mode = FileReadMode::stream}));
+
+			CHECK_THROWS_AS(hash_file<blake3::Blake3<32>>(proc_file, automatic, FileHashOptions{.mode = FileReadMode::mmap}), std::system_error);
+			CHECK_THROWS_AS(hash_file<Policies::Martinus>(proc_file, FileHashOptions{.mode = FileReadMode::mmap}), std::system_error);
+		}
+	}
+}
@@ -0,0 +1,73 @@
+#include <catch2/catch_all.hpp>
+#include <dice/hash/lthash/HwyTargets.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace dice::hash::lthash;
+
+TEST_CASE("Highway target selection", "[DiceHash]") {
+	hwy_targets::reset_targets();
+
+	auto const compiled = hwy_targets::compiled_targets();
+	auto const supported = hwy_targets::supported_targets();
+	REQUIRE_FALSE(compiled.empty());
+	REQUIRE_FALSE(supported.empty());
+
+	SECTION("active target is the best supported target") {
+		CHECK(hwy_targets::active_target() == supported.front());
+		for (auto const target : supported) {
+			CHECK(std::ranges::find(compiled, target) != compiled.end());
+		}
+	}
+
+	SECTION("names") {
+		for (auto const target : compiled) {
+			auto const name = hwy_targets::target_name(target);
+			CHECK_FALSE(name.empty());
+			CHECK(hwy_targets::target_by_name(name) == target);
+		}
+		CHECK(hwy_targets::target_by_name("no such target") == 0);
+	}
+
+	SECTION("force target") {
+		for (auto const target : supported) {
+			hwy_targets::force_target(target);
+			CHECK(hwy_targets::active_target() == target);
+			CHECK(hwy_targets::supported_targets() == std::vector<int64_t>{target});
+		}
+
+		CHECK_THROWS_AS(hwy_targets::force_target(0), std::invalid_argument);
+
+		hwy_targets::reset_targets();
+		CHECK(hwy_targets::supported_targets() == supported);
+	}
+
+	SECTION("disable targets") {
+		if (supported.size() > 1) {
+			hwy_targets::disable_targets(supported.front());
+			CHECK(hwy_targets::active_target() == supported[1]);
+			CHECK_THROWS_AS(hwy_targets::force_target(supported.front()), std::invalid_argument);
+
+			hwy_targets::reset_targets();
+			CHECK(hwy_targets::active_target() == supported.front());
+		}
+	}
+
+	SECTION("environment variable") {
+		::setenv(hwy_targets::env_var, std::string{hwy_targets::target_name(supported.back())}.c_str(), 1);
+		CHECK(hwy_targets::apply_env_target());
+		CHECK(hwy_targets::active_target() == supported.back());
+
+		::setenv(hwy_targets::env_var, "no such target", 1);
+		CHECK_THROWS_AS(hwy_targets::apply_env_target(), std::invalid_argument);
+
+		::unsetenv(hwy_targets::env_var);
+		CHECK_FALSE(hwy_targets::apply_env_target());
+	}
+
+	hwy_targets::reset_targets();
+}
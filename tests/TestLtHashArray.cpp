@@ -0,0 +1,167 @@
+#include <catch2/catch_all.hpp>
+
+#include <dice/hash/lthash/LtHashArray.hpp>
+
+#include "TestLtHash_common.hpp"
+
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace dice::hash::lthash;
+
+TEMPLATE_TEST_CASE("LtHashArray", "[DiceHash]", LtHash16, LtHash20, LtHash32) {
+	using H = TestType;
+	using Array = LtHashArray<H::element_bits, H::element_count>;
+
+	static_assert(Array::row_stride % 64 == 0);
+	static_assert(Array::row_stride >= H::checksum_len);
+
+	auto const key = as_bytes(std::span<char const, 32>{"0123456789abcdef0123456789abcdef", 32});
+
+	SECTION("rows behave like LtHash") {
+		size_t const n_rows = 100;
+
+		Array array{n_rows};
+		array.set_key(key);
+		REQUIRE(array.size() == n_rows);
+
+		std::vector<H> hashes(n_rows);
+		for (auto &h : hashes) {
+			h.set_key(key);
+		}
+
+		for (size_t i = 0; i < 1000; ++i) {
+			auto const obj = std::to_string(i);
+			auto const row = (i * 7) % n_rows;
+			if (i % 5 == 0) {
+				array.remove(row, as_bytes(std::span{obj}));
+				hashes[row].remove(as_bytes(std::span{obj}));
+			} else {
+				array.add(row, as_bytes(std::span{obj}));
+				hashes[row].add(as_bytes(std::span{obj}));
+			}
+		}
+
+		for (size_t row = 0; row < n_rows; ++row) {
+			REQUIRE(std::ranges::equal(array.checksum(row), hashes[row].checksum()));
+			REQUIRE(array.get(row) == hashes[row]);
+			REQUIRE(array.get(row).key_equal(key));
+		}
+
+		H sum;
+		sum.set_key(key);
+		for (auto const &h : hashes) {
+			sum.combine_add(h);
+		}
+		CHECK(array.aggregate() == sum);
+
+		array.combine_add(0, 1);
+		hashes[0].combine_add(hashes[1]);
+		CHECK(array.get(0) == hashes[0]);
+
+		array.combine_remove(0, 2);
+		hashes[0].combine_remove(hashes[2]);
+		CHECK(array.get(0) == hashes[0]);
+
+		array.combine_add(3, hashes[4]);
+		hashes[3].combine_add(hashes[4]);
+		CHECK(array.get(3) == hashes[3]);
+
+		array.combine_remove(3, hashes[5]);
+		hashes[3].combine_remove(hashes[5]);
+		CHECK(array.get(3) == hashes[3]);
+
+		CHECK_THROWS_AS(array.combine_add(0, H{}), std::invalid_argument);
+	}
+
+	SECTION("bulk add and remove") {
+		size_t const n_rows = 50;
+
+		Array bulk{n_rows};
+		bulk.set_key(key);
+		Array single{n_rows};
+		single.set_key(key);
+
+		std::vector<std::string> strings;
+		std::vector<size_t> rows;
+		for (size_t i = 0; i < 500; ++i) {
+			strings.push_back(std::to_string(i));
+			rows.push_back((i * 13) % n_rows);
+		}
+		std::vector<std::span<std::byte const>> objs;
+		for (auto const &str : strings) {
+			objs.push_back(as_bytes(std::span{str}));
+		}
+
+		bulk.add_bulk(rows, objs);
+		bulk.remove_bulk(std::span{rows}.first(100), std::span{objs}.first(100));
+		for (size_t i = 0; i < objs.size(); ++i) {
+			single.add(rows[i], objs[i]);
+		}
+		for (size_t i = 0; i < 100; ++i) {
+			single.remove(rows[i], objs[i]);
+		}
+
+		for (size_t row = 0; row < n_rows; ++row) {
+			REQUIRE(bulk.get(row) == single.get(row));
+		}
+
+		bulk.add_bulk({}, {});
+		CHECK_THROWS_AS(bulk.add_bulk(rows, std::span{objs}.first(1)), std::invalid_argument);
+	}
+
+	SECTION("set and clear checksum") {
+		Array array{2};
+
+		H h;
+		h.add(obj1);
+		array.set_checksum(1, h.checksum());
+		CHECK(array.get(1) == h);
+
+		array.clear_checksum(1);
+		CHECK(array.get(1) == H{});
+
+		if constexpr (H::needs_padding) {
+			std::array<std::byte, H::checksum_len> invalid{};
+			invalid[7] = std::byte{0xFF};
+			CHECK_THROWS_AS(array.set_checksum(0, invalid), std::invalid_argument);
+		}
+	}
+
+	SECTION("copy and move") {
+		Array a1{3};
+		a1.set_key(key);
+		a1.add(2, obj2);
+
+		Array a2{a1};
+		CHECK(std::ranges::equal(a1.checksum(2), a2.checksum(2)));
+
+		auto const *data = a2.checksum(0).data();
+		Array a3{std::move(a2)};
+		CHECK(a3.checksum(0).data() == data);
+		CHECK(a2.size() == 0);
+		CHECK(a3.get(2) == a1.get(2));
+
+		Array a4{1};
+		a4 = a3;
+		CHECK(a4.size() == 3);
+		CHECK(a4.get(2).key_equal(key));
+
+		a4 = Array{0};
+		CHECK(a4.size() == 0);
+	}
+
+	SECTION("large arrays are served by huge pages") {
+		Array array{(HugePageAllocator<std::byte>::huge_page_size / Array::row_stride) * 2 + 1};
+		array.add(array.size() - 1, obj1);
+
+		H h;
+		h.add(obj1);
+		CHECK(array.get(array.size() - 1) == h);
+		CHECK(array.get(0) == H{});
+		CHECK(reinterpret_cast<uintptr_t>(array.checksum(0).data()) % HugePageAllocator<std::byte>::huge_page_size == 0);
+	}
+}
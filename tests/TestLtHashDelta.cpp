@@ -0,0 +1,101 @@
+#include <catch2/catch_all.hpp>
+
+#include <dice/hash/blake/Blake2Xb.hpp>
+#include <dice/hash/lthash/LtHashDelta.hpp>
+
+#include "TestLtHash_common.hpp"
+
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+using namespace dice::hash::lthash;
+
+TEMPLATE_TEST_CASE("LtHashDelta", "[DiceHash]",
+				   LtHash16, LtHash20, LtHash32,
+				   (LtHash<20, 1008, dice::hash::blake2xb::Blake2Xb>)) {
+	using L = TestType;
+	using D = LtHashDelta<L>;
+
+	auto const key_bytes = as_bytes(std::span<char const, 32>{"0123456789abcdef0123456789abcdef", 32});
+
+	// sender and receiver start with the same checksum
+	L sender;
+	sender.set_key(key_bytes);
+	for (uint64_t ix = 0; ix < 100; ++ix) {
+		sender.add(as_object(ix));
+	}
+	L receiver{sender};
+
+	SECTION("small change sets use the sparse encoding") {
+		D delta{sender};
+		sender.add(as_object(1000)).remove(as_object(5));
+		delta.add(as_object(1000)).remove(as_object(5));
+
+		REQUIRE(delta.is_sparse());
+		auto const bytes = delta.encode();
+		CHECK(bytes.size() == delta.encoded_len());
+		CHECK(bytes.size() == D::header_len + 2 * (1 + 4 + sizeof(uint64_t)));
+
+		auto const decoded = D::decode(bytes, receiver);
+		CHECK(decoded.is_sparse());
+		CHECK(decoded.difference() == delta.difference());
+
+		decoded.apply_to(receiver);
+		CHECK(receiver == sender);
+
+		// the receiver moved on, applying the same delta twice is rejected
+		CHECK_THROWS_AS(decoded.apply_to(receiver), std::invalid_argument);
+		CHECK_THROWS_AS(D::decode(bytes, receiver), std::invalid_argument);
+	}
+
+	SECTION("large change sets use the dense encoding") {
+		D delta{sender};
+		for (uint64_t ix = 1000; ix < 2000; ++ix) {
+			sender.add(as_object(ix));
+			delta.add(as_object(ix));
+		}
+
+		REQUIRE_FALSE(delta.is_sparse());
+		auto const bytes = delta.encode();
+		CHECK(bytes.size() == D::header_len + serialization::payload_len<L>);
+
+		auto const decoded = D::decode(bytes, receiver);
+		CHECK_FALSE(decoded.is_sparse());
+		decoded.apply_to(receiver);
+		CHECK(receiver == sender);
+	}
+
+	SECTION("different keys are rejected") {
+		D delta{sender};
+		delta.add(as_object(1000));
+		auto const bytes = delta.encode();
+
+		L other_key{receiver.checksum()};
+		CHECK_THROWS_AS(D::decode(bytes, other_key), std::invalid_argument);
+		CHECK_THROWS_AS(delta.apply_to(other_key), std::invalid_argument);
+	}
+
+	SECTION("invalid encodings are rejected") {
+		D delta{sender};
+		delta.add(as_object(1000));
+		auto const bytes = delta.encode();
+
+		auto check_rejected = [&](size_t ix, std::byte value) {
+			auto corrupted = bytes;
+			corrupted[ix] = value;
+			CHECK_THROWS_AS(D::decode(corrupted, receiver), std::invalid_argument);
+		};
+
+		check_rejected(0, std::byte{'X'}); // magic
+		check_rejected(4, std::byte{0xff}); // version
+		check_rejected(6, std::byte{2}); // encoding
+		check_rejected(serialization::header_len, ~bytes[serialization::header_len]); // key fingerprint
+		check_rejected(D::header_len, std::byte{7}); // operation
+		check_rejected(D::header_len + 1, std::byte{0xff}); // object length
+
+		std::vector<std::byte> truncated{bytes.begin(), bytes.end() - 1};
+		CHECK_THROWS_AS(D::decode(truncated, receiver), std::invalid_argument);
+	}
+}
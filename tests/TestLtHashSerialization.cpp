@@ -0,0 +1,151 @@
+#include <catch2/catch_all.hpp>
+
+#include <dice/hash/blake/Blake2Xb.hpp>
+#include <dice/hash/lthash/LtHashSerialization.hpp>
+
+#include "TestLtHash_common.hpp"
+
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+using namespace dice::hash::lthash;
+
+namespace {
+	/**
+	 * @brief reference implementation: writes every element bit by bit
+	 */
+	template<typename L>
+	std::vector<std::byte> naive_bit_stream(L const &h) {
+		constexpr size_t elems_per_word = L::elements_per_uint64;
+		constexpr size_t elem_stride = L::needs_padding ? L::element_bits + 1 : L::element_bits;
+
+		std::vector<std::byte> ret(L::element_count * L::element_bits / 8);
+		auto const checksum = h.checksum();
+
+		size_t out_bit = 0;
+		for (size_t word_ix = 0; word_ix < L::checksum_len / 8; ++word_ix) {
+			uint64_t word = 0;
+			for (size_t b = 0; b < 8; ++b) {
+				word |= static_cast<uint64_t>(checksum[word_ix * 8 + b]) << (8 * b);
+			}
+
+			for (size_t e = 0; e < elems_per_word; ++e) {
+				for (size_t bit = 0; bit < L::element_bits; ++bit, ++out_bit) {
+					if ((word >> (e * elem_stride + bit)) & 1) {
+						ret[out_bit / 8] |= std::byte{1} << (out_bit % 8);
+					}
+				}
+			}
+		}
+
+		return ret;
+	}
+} // namespace
+
+TEMPLATE_TEST_CASE("LtHash serialization", "[DiceHash]",
+				   LtHash16, LtHash20, LtHash32,
+				   (LtHash<20, 1008, dice::hash::blake2xb::Blake2Xb>)) {
+	using L = TestType;
+
+	auto const key_bytes = as_bytes(std::span<char const, 32>{"0123456789abcdef0123456789abcdef", 32});
+
+	L h;
+	h.set_key(key_bytes);
+	for (uint64_t ix = 0; ix < 100; ++ix) {
+		h.add(as_object(ix));
+	}
+
+	SECTION("round trip") {
+		auto const bytes = serialization::serialize(h);
+		CHECK(bytes.size() == serialization::serialized_len<L>());
+		CHECK(bytes.size() == 16 + L::element_count * L::element_bits / 8);
+
+		L restored;
+		restored.set_key(key_bytes);
+		serialization::deserialize(bytes, restored);
+		CHECK(restored == h);
+
+		serialization::SerializedLtHashView<L> const view{bytes};
+		CHECK_FALSE(view.is_delta());
+		CHECK(std::ranges::equal(view.payload(), naive_bit_stream(h)));
+	}
+
+	SECTION("delta round trip") {
+		L base{h};
+		for (uint64_t ix = 100; ix < 110; ++ix) {
+			h.add(as_object(ix));
+		}
+		h.remove(as_object(0));
+
+		auto const bytes = serialization::serialize_delta(h, base);
+		CHECK(bytes.size() == serialization::serialized_len<L>(true));
+		CHECK_THROWS_AS(serialization::deserialize(bytes, base), std::invalid_argument);
+
+		L restored;
+		restored.set_key(key_bytes);
+		serialization::deserialize_delta(bytes, base, restored);
+		CHECK(restored == h);
+
+		// applying it in place
+		L in_place{base};
+		serialization::deserialize_delta(bytes, in_place, in_place);
+		CHECK(in_place == h);
+
+		// different base
+		CHECK_THROWS_AS(serialization::deserialize_delta(bytes, h, restored), std::invalid_argument);
+
+		// different key
+		L other_key;
+		CHECK_THROWS_AS(serialization::serialize_delta(h, other_key), std::invalid_argument);
+		CHECK_THROWS_AS(serialization::deserialize_delta(bytes, base, other_key), std::invalid_argument);
+
+		auto const full = serialization::serialize(h);
+		CHECK_THROWS_AS(serialization::deserialize_delta(full, base, restored), std::invalid_argument);
+	}
+
+	SECTION("invalid input is rejected") {
+		auto const bytes = serialization::serialize(h);
+		L restored;
+
+		auto check_rejected = [&](size_t ix, std::byte value) {
+			auto corrupted = bytes;
+			corrupted[ix] = value;
+			CHECK_THROWS_AS(serialization::deserialize(corrupted, restored), std::invalid_argument);
+		};
+
+		check_rejected(0, std::byte{'X'}); // magic
+		check_rejected(4, std::byte{0xff}); // version
+		check_rejected(5, std::byte{L::element_bits + 1}); // element bits
+		check_rejected(6, std::byte{0x80}); // unknown flag
+		check_rejected(7, std::byte{1}); // reserved
+		check_rejected(8, std::byte{0xff}); // element count
+		check_rejected(12, std::byte{1}); // reserved
+
+		std::vector<std::byte> truncated{bytes.begin(), bytes.end() - 1};
+		CHECK_THROWS_AS(serialization::deserialize(truncated, restored), std::invalid_argument);
+		CHECK_THROWS_AS(serialization::deserialize(std::span<std::byte const>{}, restored), std::invalid_argument);
+
+		std::vector<std::byte> too_small(bytes.size() - 1);
+		CHECK_THROWS_AS(serialization::serialize(h, std::span{too_small}), std::invalid_argument);
+	}
+}
+
+TEST_CASE("LtHash serialization of 20 bit elements has no padding", "[DiceHash]") {
+	// all data bits set
+	alignas(LtHash20::checksum_align) std::array<std::byte, LtHash20::checksum_len> checksum;
+	for (size_t ix = 0; ix < checksum.size(); ix += 8) {
+		for (size_t b = 0; b < 8; ++b) {
+			checksum[ix + b] = static_cast<std::byte>(~0xC000020000100000ULL >> (8 * b));
+		}
+	}
+
+	LtHash20 h{checksum};
+	auto const bytes = serialization::serialize(h);
+	CHECK(std::ranges::all_of(std::span{bytes}.subspan(serialization::header_len), [](std::byte b) { return b == std::byte{0xff}; }));
+
+	LtHash20 restored;
+	serialization::deserialize(bytes, restored);
+	CHECK(restored == h);
+}
@@ -0,0 +1,4 @@
+#define DICE_HASH_TEST_LTHASH_MATH_ENGINE MathEngine_HwyNative
+#define DICE_HASH_TEST_LTHASH_INSTRUCTION_SET "HwyNative"
+#define DICE_HASH_BENCHMARK_LTHASH_HIGHWAY_TARGRETS
+#include "TestLtHash_template.hpp"
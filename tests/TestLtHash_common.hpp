@@ -0,0 +1,23 @@
+#ifndef DICE_HASH_TESTLTHASH_COMMON_HPP
+#define DICE_HASH_TESTLTHASH_COMMON_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// objects shared by the tests and benchmarks of the LtHash variants (DynamicLtHash, LtHashArray, ConcurrentLtHash, ...)
+
+inline constexpr std::array<std::byte, 1> obj1{std::byte{'a'}};
+inline constexpr std::array<std::byte, 1> obj2{std::byte{'b'}};
+
+/**
+ * @brief the bytes of value, e.g. to add many distinct objects to an LtHash
+ */
+inline std::array<std::byte, sizeof(uint64_t)> as_object(uint64_t value) noexcept {
+	std::array<std::byte, sizeof(uint64_t)> ret;
+	std::memcpy(ret.data(), &value, sizeof(value));
+	return ret;
+}
+
+#endif//DICE_HASH_TESTLTHASH_COMMON_HPP
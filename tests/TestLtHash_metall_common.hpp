@@ -5,7 +5,9 @@
 #include <iostream>
 #include <span>
 
+#include <dice/hash/lthash/DynamicLtHash.hpp>
 #include <dice/hash/lthash/LtHash.hpp>
+#include <dice/hash/lthash/PersistentLtHashMap.hpp>
 #include <metall/metall.hpp>
 
 using namespace dice::hash::lthash;
@@ -16,6 +18,13 @@ inline constexpr char const *lthash_name = "lthash0";
 
 using LtHash_t = LtHash<20, 1008, Blake3, MathEngine_Simple>;
 
+inline constexpr char const *dynamic_lthash_name = "dynamic_lthash0";
+using DynamicLtHash_t = DynamicLtHash<Blake3, MathEngine_Simple, allocator_type>;
+
+inline constexpr char const *lthash_map_name = "lthash_map0";
+using PersistentLtHashMap_t = PersistentLtHashMap<20, 1008, Blake3, MathEngine_Simple, allocator_type>;
+inline constexpr uint64_t n_partitions = 100;
+
 inline std::span<std::byte const> obj = as_bytes(std::span<char const>{"spherical cow"});
 
 void print_span(std::span<std::byte const> bytes) noexcept {
@@ -12,4 +12,12 @@ int main(int argc, char **argv) {
 
 	auto lthash_ptr = manager.construct<LtHash_t>(lthash_name)();
 	lthash_ptr->add(obj);
+
+	auto dynamic_lthash_ptr = manager.construct<DynamicLtHash_t>(dynamic_lthash_name)(LtHash_t::element_bits, LtHash_t::element_count, manager.get_allocator());
+	dynamic_lthash_ptr->add(obj);
+
+	auto lthash_map_ptr = manager.construct<PersistentLtHashMap_t>(lthash_map_name)(manager.get_allocator());
+	for (uint64_t id = 0; id < n_partitions; ++id) {
+		lthash_map_ptr->add(id, obj);
+	}
 }
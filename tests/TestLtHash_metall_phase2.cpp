@@ -20,6 +20,22 @@ int main(int argc, char **argv) {
 
 		assert((std::ranges::equal(lthash_ptr->checksum(), other_lthash1.checksum())));
 		assert((std::ranges::equal(lthash_ptr->checksum(), other_lthash2.checksum())));
+
+		auto dynamic_lthash_ptr = std::get<0>(manager.find<DynamicLtHash_t>(dynamic_lthash_name));
+		print_span(dynamic_lthash_ptr->checksum());
+		assert((std::ranges::equal(dynamic_lthash_ptr->checksum(), other_lthash1.checksum())));
+
+		auto lthash_map_ptr = std::get<0>(manager.find<PersistentLtHashMap_t>(lthash_map_name));
+		assert(lthash_map_ptr->size() == n_partitions);
+		for (uint64_t id = 0; id < n_partitions; ++id) {
+			assert(lthash_map_ptr->epoch(id) == 1);
+			assert((std::ranges::equal(lthash_map_ptr->checksum(id), other_lthash1.checksum())));
+		}
+
+		// the reopened map can be updated in place
+		lthash_map_ptr->remove(0, obj);
+		assert(lthash_map_ptr->get(0) == LtHash_t{});
+		assert(lthash_map_ptr->epoch(0) == 2);
 	}
 
 	metall::manager::remove(path);
@@ -1,4 +1,5 @@
 #include <dice/hash/lthash/LtHash.hpp>
+#include <dice/hash/lthash/LtHashAccumulator.hpp>
 #include <dice/hash/blake/Blake2Xb.hpp>
 #include <iostream>
 
@@ -701,6 +702,174 @@ TEMPLATE_TEST_CASE("Test LtHash using " DICE_HASH_TEST_LTHASH_INSTRUCTION_SET, "
 		CHECK(h1 != h3);
 	}
 
+	SECTION("math engine matches MathEngine_Simple") {
+		using Bits = dice::hash::lthash::detail::Bits<H::element_bits>;
+		using ME = DICE_HASH_TEST_LTHASH_MATH_ENGINE<Bits>;
+		using Reference = MathEngine_Simple<Bits>;
+
+		for (size_t i = 0; i < 100; ++i) {
+			alignas(ME::min_buffer_align) std::array<std::byte, H::checksum_len> a;
+			alignas(ME::min_buffer_align) std::array<std::byte, H::checksum_len> b;
+			std::ranges::copy(make_random_data(H::checksum_len), a.begin());
+			std::ranges::copy(make_random_data(H::checksum_len), b.begin());
+
+			if constexpr (H::needs_padding) {
+				Reference::clear_padding_bits(std::span{a});
+				Reference::clear_padding_bits(std::span{b});
+			}
+
+			auto expected = a;
+			auto actual = a;
+			Reference::add(std::span{expected}, std::span<std::byte const, H::checksum_len>{b});
+			ME::add(std::span{actual}, std::span<std::byte const, H::checksum_len>{b});
+			REQUIRE(expected == actual);
+
+			Reference::sub(std::span{expected}, std::span<std::byte const, H::checksum_len>{a});
+			ME::sub(std::span{actual}, std::span<std::byte const, H::checksum_len>{a});
+			REQUIRE(expected == actual);
+
+			if constexpr (H::needs_padding) {
+				REQUIRE(ME::check_padding_bits(std::span<std::byte const, H::checksum_len>{actual}));
+			}
+		}
+	}
+
+	SECTION("digest follows the checksum") {
+		auto const obj1 = as_bytes(std::span{"a"});
+		auto const obj2 = as_bytes(std::span{"b"});
+
+		H h1;
+		H h2;
+		CHECK(h1.digest_equal(h2));
+
+		auto const empty_digest = h1.digest();
+
+		h1.add(obj1);
+		CHECK_FALSE(std::ranges::equal(h1.digest(), empty_digest));
+		CHECK_FALSE(h1.digest_equal(h2));
+
+		h2.add(obj1);
+		CHECK(h1.digest_equal(h2));
+		CHECK(dice::hash::DiceHash<H>{}(h1) == dice::hash::DiceHash<H>{}(h2));
+		CHECK(dice::hash::DiceHash<H>{}(h1) == dice::hash::DiceHash<std::array<std::byte, H::digest_len>>{}(h1.digest()));
+		CHECK(dice::hash::DiceHashxxh3<H>{}(h1) == dice::hash::DiceHashxxh3<std::array<std::byte, H::digest_len>>{}(h1.digest()));
+		CHECK(dice::hash::SeededDiceHash<H>{42}(h1) == dice::hash::SeededDiceHash<H>{42}(h2));
+		CHECK(dice::hash::SeededDiceHash<H>{42}(h1) != dice::hash::SeededDiceHash<H>{43}(h1));
+
+		h1.add(obj2);
+		CHECK_FALSE(h1.digest_equal(h2));
+		h1.remove(obj2);
+		CHECK(h1.digest_equal(h2));
+
+		H h3{h1};
+		h3.combine_add(h2);
+		CHECK_FALSE(h3.digest_equal(h1));
+		h3.combine_remove(h2);
+		CHECK(h3.digest_equal(h1));
+
+		h3.set_checksum(H::default_checksum);
+		CHECK(std::ranges::equal(h3.digest(), empty_digest));
+
+		h1.clear_checksum();
+		CHECK(std::ranges::equal(h1.digest(), empty_digest));
+
+		H h4{h2.checksum()};
+		CHECK(std::ranges::equal(h4.digest(), h2.digest()));
+	}
+
+	SECTION("checksum comparison finds differences everywhere") {
+		H h;
+		h.add(as_bytes(std::span{"a"}));
+
+		alignas(H::checksum_align) std::array<std::byte, H::checksum_len> other;
+		std::ranges::copy(h.checksum(), other.begin());
+		CHECK(h.checksum_equal(other));
+		CHECK(h.checksum_equal_constant_time(other));
+
+		for (size_t const ix : {size_t{0}, size_t{1}, H::checksum_len / 2, H::checksum_len - 9, H::checksum_len - 1}) {
+			other[ix] ^= std::byte{0x10};
+			CHECK_FALSE(h.checksum_equal(other));
+			CHECK_FALSE(h.checksum_equal_constant_time(other));
+			other[ix] ^= std::byte{0x10};
+		}
+
+		// unaligned input takes the fallback path
+		alignas(H::checksum_align) std::array<std::byte, H::checksum_len + 1> unaligned;
+		std::span<std::byte, H::checksum_len> const unaligned_view{unaligned.data() + 1, H::checksum_len};
+		std::ranges::copy(h.checksum(), unaligned_view.begin());
+		CHECK(h.checksum_equal(unaligned_view));
+		CHECK(h.checksum_equal_constant_time(unaligned_view));
+		unaligned_view.back() ^= std::byte{1};
+		CHECK_FALSE(h.checksum_equal(unaligned_view));
+		CHECK_FALSE(h.checksum_equal_constant_time(unaligned_view));
+	}
+
+	SECTION("accumulator equals add and remove") {
+		auto key = as_bytes(std::span{"0123456789abcdef"});
+
+		std::vector<std::vector<std::byte>> objects;
+		for (size_t i = 0; i < 1000; i++) {
+			objects.push_back(make_random_data((rand() % 1024) + 1));
+		}
+
+		H h1;
+		h1.set_key(key);
+		h1.add(T::obj1);
+
+		H initial;
+		initial.set_key(key);
+		initial.add(T::obj1);
+		LtHashAccumulator<H> acc{initial};
+
+		for (size_t i = 0; i < objects.size(); ++i) {
+			if (i % 3 == 2) {
+				h1.remove(objects[i]);
+				acc.remove(objects[i]);
+			} else {
+				h1.add(objects[i]);
+				acc.add(objects[i]);
+			}
+		}
+
+		CHECK(acc.pending() == objects.size());
+		CHECK(std::ranges::equal(acc.checksum(), h1.checksum()));
+		CHECK(acc.pending() == 0);
+
+		acc.remove(T::obj1);
+		h1.remove(T::obj1);
+		CHECK(acc.get() == h1);
+
+		H h2 = std::move(acc).finalize();
+		CHECK(h2 == h1);
+		CHECK(h2.key_equal(key));
+	}
+
+	SECTION("accumulator flushes before lanes overflow") {
+		if constexpr (H::element_bits == 16) {
+			static constexpr size_t n = LtHashAccumulator<H>::max_pending + 10;
+
+			H single;
+			single.add(T::obj1);
+
+			H expected;
+			LtHashAccumulator<H> acc;
+			for (size_t i = 0; i < n; ++i) {
+				expected.combine_add(single);
+				acc.add(T::obj1);
+				acc.remove(T::obj2);
+			}
+			CHECK(acc.pending() == 20);
+
+			H removed;
+			removed.add(T::obj2);
+			for (size_t i = 0; i < n; ++i) {
+				expected.combine_remove(removed);
+			}
+
+			CHECK(std::ranges::equal(acc.checksum(), expected.checksum()));
+		}
+	}
+
 #ifdef DICE_HASH_BENCHMARK_LTHASH_HIGHWAY_TARGRETS
 	hwy::SetSupportedTargetsForTest(0);
 #endif
@@ -0,0 +1,173 @@
+#include <catch2/catch_all.hpp>
+
+#include <dice/hash/Partition.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace dice::hash;
+
+namespace {
+	struct Tuple {
+		uint64_t key;
+		uint64_t payload;
+
+		bool operator==(Tuple const &) const noexcept = default;
+	};
+
+	/**
+	 * @brief checks that out is in a permutation of in, grouped by partition and stable
+	 */
+	template<typename T, typename Partitioner>
+	void require_partitioned(std::vector<T> const &in, std::vector<T> const &out, std::vector<size_t> const &offsets, Partitioner const &partitioner) {
+		REQUIRE(offsets.size() == partitioner.n_partitions() + 1);
+		REQUIRE(offsets.front() == 0);
+		REQUIRE(offsets.back() == in.size());
+
+		// the stable partitioning, computed one value at a time
+		std::vector<std::vector<T>> expected(partitioner.n_partitions());
+		for (auto const &value : in) {
+			expected[partitioner(value)].push_back(value);
+		}
+
+		for (size_t partition = 0; partition < partitioner.n_partitions(); ++partition) {
+			REQUIRE(offsets[partition + 1] - offsets[partition] == expected[partition].size());
+			REQUIRE(std::equal(out.begin() + static_cast<ptrdiff_t>(offsets[partition]),
+							   out.begin() + static_cast<ptrdiff_t>(offsets[partition + 1]),
+							   expected[partition].begin()));
+		}
+	}
+
+	/**
+	 * @brief runs the tasks on the calling thread and remembers the largest number of tasks of a parallel_for
+	 */
+	struct CountingExecutor {
+		size_t concurrency_ = 64;
+		size_t max_tasks = 0;
+
+		[[nodiscard]] size_t concurrency() const noexcept {
+			return concurrency_;
+		}
+
+		template<typename F>
+		void parallel_for(size_t n, F &&f) {
+			max_tasks = std::max(max_tasks, n);
+			for (size_t ix = 0; ix < n; ++ix) {
+				f(ix);
+			}
+		}
+	};
+} // namespace
+
+TEST_CASE("partition_of is multiply-shift", "[DiceHash]") {
+	REQUIRE(partition_of(0, 7) == 0);
+	REQUIRE(partition_of(std::numeric_limits<size_t>::max(), 7) == 6);
+	REQUIRE(partition_of(std::numeric_limits<size_t>::max(), 1) == 0);
+	if constexpr (sizeof(size_t) == 8) {
+		REQUIRE(partition_of(size_t{1} << 63, 2) == 1);
+		REQUIRE(partition_of((size_t{1} << 63) - 1, 2) == 0);
+		REQUIRE(partition_of(0xFFFF'FFFF'FFFF'FFFF, size_t{1} << 32) == 0xFFFF'FFFF);
+	}
+
+	// consecutive keys are spread evenly
+	std::vector<size_t> counts(16, 0);
+	for (uint64_t key = 0; key < 16'000; ++key) {
+		++counts[partition_of(DiceHash<uint64_t>{}(key), counts.size())];
+	}
+	for (auto const count : counts) {
+		REQUIRE(count > 800);
+		REQUIRE(count < 1'200);
+	}
+}
+
+TEST_CASE("HashPartitioner scatters like partitioning one value at a time", "[DiceHash]") {
+	auto const n_values = GENERATE(size_t{0}, size_t{1}, size_t{1'000}, size_t{100'000});
+	// 5'000 partitions are more than HashPartitioner<uint64_t>::max_buffered_partitions
+	auto const n_partitions = GENERATE(size_t{1}, size_t{7}, size_t{64}, size_t{1'000}, size_t{5'000});
+	auto const concurrency = GENERATE(size_t{1}, size_t{4});
+	CAPTURE(n_values, n_partitions, concurrency);
+
+	ThreadPool pool{concurrency};
+
+	SECTION("integers (write combining)") {
+		std::vector<uint64_t> in(n_values);
+		for (size_t ix = 0; ix < n_values; ++ix) {
+			in[ix] = ix % 5'000;// duplicates end up in the same partition
+		}
+		std::vector<uint64_t> out(n_values);
+
+		HashPartitioner<uint64_t> partitioner{n_partitions};
+		STATIC_REQUIRE(HashPartitioner<uint64_t>::write_combining);
+		auto const offsets = partitioner.scatter(in, out, pool);
+		require_partitioned(in, out, offsets, partitioner);
+
+		REQUIRE(partition<uint64_t>(in, out, n_partitions, pool) == offsets);
+
+		// the output does not start at a cache line
+		std::vector<uint64_t> unaligned_out(n_values + 3);
+		REQUIRE(partitioner.scatter(in, std::span{unaligned_out}.subspan(3), pool) == offsets);
+		REQUIRE(std::equal(out.begin(), out.end(), unaligned_out.begin() + 3));
+	}
+
+	SECTION("tuples partitioned by key") {
+		std::vector<Tuple> in(n_values);
+		for (size_t ix = 0; ix < n_values; ++ix) {
+			in[ix] = Tuple{.key = ix * 31, .payload = ix};
+		}
+		std::vector<Tuple> out(n_values);
+
+		HashPartitioner<Tuple, decltype(&Tuple::key)> partitioner{n_partitions, &Tuple::key};
+		auto const offsets = partitioner.scatter(in, out, pool);
+		require_partitioned(in, out, offsets, partitioner);
+		REQUIRE(partitioner(Tuple{.key = 5, .payload = 0}) == partition_of(DiceHash<uint64_t>{}(5), n_partitions));
+	}
+
+	SECTION("strings (no write combining)") {
+		std::vector<std::string> in(n_values);
+		for (size_t ix = 0; ix < n_values; ++ix) {
+			in[ix] = std::to_string(ix);
+		}
+		std::vector<std::string> out(n_values);
+
+		HashPartitioner<std::string> partitioner{n_partitions};
+		STATIC_REQUIRE_FALSE(HashPartitioner<std::string>::write_combining);
+		auto const offsets = partitioner.scatter(in, out, pool);
+		require_partitioned(in, out, offsets, partitioner);
+	}
+}
+
+TEST_CASE("HashPartitioner bounds the histograms by the input size", "[DiceHash]") {
+	std::vector<uint64_t> in(1 << 20);
+	for (size_t ix = 0; ix < in.size(); ++ix) {
+		in[ix] = ix;
+	}
+	std::vector<uint64_t> out(in.size());
+
+	CountingExecutor executor;
+	HashPartitioner<uint64_t> const few{64};
+	require_partitioned(in, out, few.scatter(in, out, executor), few);
+	REQUIRE(executor.max_tasks == 64);
+
+	// a chunk per (at least) n_partitions values
+	executor.max_tasks = 0;
+	HashPartitioner<uint64_t> const many{size_t{1} << 17};
+	require_partitioned(in, out, many.scatter(in, out, executor), many);
+	REQUIRE(executor.max_tasks == 8);
+}
+
+TEST_CASE("HashPartitioner invalid arguments", "[DiceHash]") {
+	REQUIRE_THROWS_AS(HashPartitioner<uint64_t>{0}, std::invalid_argument);
+	if constexpr (sizeof(size_t) == 8) {
+		REQUIRE_NOTHROW(HashPartitioner<uint64_t>{size_t{1} << 32});
+		REQUIRE_THROWS_AS(HashPartitioner<uint64_t>{(size_t{1} << 32) + 1}, std::invalid_argument);
+	}
+
+	std::vector<uint64_t> in(10);
+	std::vector<uint64_t> out(9);
+	REQUIRE_THROWS_AS(HashPartitioner<uint64_t>{4}.scatter(in, out), std::invalid_argument);
+}
@@ -0,0 +1,265 @@
+#include <catch2/catch_all.hpp>
+
+#include <dice/hash/lthash/PersistentLtHashMap.hpp>
+
+#include "TestLtHash_common.hpp"
+
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <map>
+#include <memory>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+using namespace dice::hash::lthash;
+
+namespace {
+	/**
+	 * @brief simulates a crash (by throwing) at the n-th persist barrier
+	 */
+	struct CrashingPersistBarrier {
+		static inline size_t calls_until_crash = std::numeric_limits<size_t>::max();
+
+		void operator()(std::span<std::byte const>) const {
+			if (calls_until_crash-- == 0) {
+				throw std::runtime_error{"crash"};
+			}
+		}
+	};
+
+	std::set<void *> live_allocations;
+
+	/**
+	 * @brief allocator that keeps track of the live allocations (of all value types) in live_allocations
+	 */
+	template<typename T>
+	struct TrackingAllocator {
+		using value_type = T;
+
+		TrackingAllocator() = default;
+
+		template<typename U>
+		TrackingAllocator(TrackingAllocator<U> const &) noexcept {
+		}
+
+		T *allocate(size_t n) {
+			auto *ret = static_cast<T *>(::operator new(n * sizeof(T)));
+			live_allocations.insert(ret);
+			return ret;
+		}
+
+		void deallocate(T *ptr, size_t) noexcept {
+			live_allocations.erase(ptr);
+			::operator delete(ptr);
+		}
+
+		bool operator==(TrackingAllocator const &) const noexcept = default;
+	};
+} // namespace
+
+TEMPLATE_TEST_CASE("PersistentLtHashMap", "[DiceHash]", LtHash16, LtHash20, LtHash32) {
+	using H = TestType;
+	using Map = PersistentLtHashMap<H::element_bits, H::element_count>;
+
+	auto const key = as_bytes(std::span<char const, 32>{"0123456789abcdef0123456789abcdef", 32});
+
+	SECTION("partitions behave like LtHash") {
+		Map map{{}, 4};
+		map.set_key(key);
+
+		std::map<uint64_t, H> hashes;
+		for (size_t i = 0; i < 2000; ++i) {
+			auto const obj = std::to_string(i);
+			auto const id = (i * 7919) % 101; // forces the table to grow a few times
+
+			auto [it, inserted] = hashes.try_emplace(id);
+			if (inserted) {
+				it->second.set_key(key);
+			}
+
+			if (i % 5 == 0) {
+				map.remove(id, as_bytes(std::span{obj}));
+				it->second.remove(as_bytes(std::span{obj}));
+			} else {
+				map.add(id, as_bytes(std::span{obj}));
+				it->second.add(as_bytes(std::span{obj}));
+			}
+		}
+
+		REQUIRE(map.size() == hashes.size());
+
+		H sum;
+		sum.set_key(key);
+		for (auto const &[id, h] : hashes) {
+			REQUIRE(map.contains(id));
+			REQUIRE(std::ranges::equal(map.checksum(id), h.checksum()));
+			REQUIRE(map.get(id) == h);
+			REQUIRE(map.get(id).key_equal(key));
+			sum.combine_add(h);
+		}
+
+		REQUIRE(map.aggregate() == sum);
+
+		size_t visited = 0;
+		map.for_each([&](uint64_t id, std::span<std::byte const, H::checksum_len> checksum) {
+			REQUIRE(std::ranges::equal(checksum, hashes.at(id).checksum()));
+			++visited;
+		});
+		REQUIRE(visited == hashes.size());
+	}
+
+	SECTION("every update increments the epoch") {
+		Map map;
+		map.insert(5);
+		REQUIRE(map.contains(5));
+		REQUIRE(map.epoch(5) == 0);
+		REQUIRE(std::ranges::all_of(map.checksum(5), [](auto b) { return b == std::byte{0}; }));
+
+		map.add(5, obj1).add(5, obj2).remove(5, obj1);
+		REQUIRE(map.epoch(5) == 3);
+
+		H expected;
+		expected.add(obj2);
+		REQUIRE(map.get(5) == expected);
+
+		// growing the table keeps the epochs
+		for (uint64_t id = 100; id < 200; ++id) {
+			map.add(id, obj1);
+		}
+		REQUIRE(map.epoch(5) == 3);
+		REQUIRE(map.get(5) == expected);
+	}
+
+	SECTION("combine and set_checksum") {
+		Map map;
+		map.set_key(key);
+
+		H h;
+		h.set_key(key);
+		h.add(obj1).add(obj2);
+
+		map.combine_add(1, h);
+		REQUIRE(map.get(1) == h);
+
+		map.combine_remove(1, h);
+		REQUIRE(map.get(1) == H{});
+
+		map.set_checksum(2, h.checksum());
+		REQUIRE(map.get(2) == h);
+
+		H other_key;
+		REQUIRE_THROWS_AS(map.combine_add(1, other_key), std::invalid_argument);
+	}
+
+	SECTION("unknown partitions") {
+		Map map;
+		REQUIRE_FALSE(map.contains(1));
+		REQUIRE_THROWS_AS(map.checksum(1), std::out_of_range);
+		REQUIRE_THROWS_AS(map.get(1), std::out_of_range);
+		REQUIRE_THROWS_AS(map.epoch(1), std::out_of_range);
+
+		auto const invalid_id = std::numeric_limits<uint64_t>::max();
+		REQUIRE_FALSE(map.contains(invalid_id));
+		REQUIRE_THROWS_AS(map.insert(invalid_id), std::invalid_argument);
+		REQUIRE_THROWS_AS(map.add(invalid_id, obj1), std::invalid_argument);
+	}
+}
+
+TEST_CASE("PersistentLtHashMap interrupted updates leave the committed checksum intact", "[DiceHash]") {
+	using Map = PersistentLtHashMap<20, 1008, dice::hash::blake3::Blake3, DefaultMathEngine, std::allocator<std::byte>, CrashingPersistBarrier>;
+
+	Map map;
+	map.add(1, obj1);
+
+	LtHash20 expected;
+	expected.add(obj1);
+
+	// crash after the new checksum was written to the inactive slot but before the epoch was published
+	CrashingPersistBarrier::calls_until_crash = 0;
+	REQUIRE_THROWS_AS(map.add(1, obj2), std::runtime_error);
+
+	REQUIRE(map.epoch(1) == 1);
+	REQUIRE(map.get(1) == expected);
+
+	// the next update does not see the garbage in the inactive slot
+	CrashingPersistBarrier::calls_until_crash = std::numeric_limits<size_t>::max();
+	map.add(1, obj1);
+	expected.add(obj1);
+	REQUIRE(map.epoch(1) == 2);
+	REQUIRE(map.get(1) == expected);
+}
+
+TEST_CASE("PersistentLtHashMap interrupted insertions keep the size consistent", "[DiceHash]") {
+	using Map = PersistentLtHashMap<20, 1008, dice::hash::blake3::Blake3, DefaultMathEngine, std::allocator<std::byte>, CrashingPersistBarrier>;
+
+	// an insertion persists the size mark, the id and the new size (in this order)
+	auto const crash_at = GENERATE(size_t{0}, size_t{1}, size_t{2});
+	CAPTURE(crash_at);
+
+	Map map;
+	map.insert(1);
+
+	CrashingPersistBarrier::calls_until_crash = crash_at;
+	REQUIRE_THROWS_AS(map.insert(2), std::runtime_error);
+	CrashingPersistBarrier::calls_until_crash = std::numeric_limits<size_t>::max();
+
+	// the id is only lost if the crash happened before it was written
+	auto const expected_size = crash_at == 0 ? size_t{1} : size_t{2};
+	REQUIRE(map.contains(2) == (crash_at != 0));
+	REQUIRE(map.size() == expected_size);
+
+	map.insert(3);
+	REQUIRE(map.size() == expected_size + 1);
+	map.insert(2);
+	REQUIRE(map.size() == 3);
+}
+
+TEST_CASE("PersistentLtHashMap interrupted growth does not leak tables", "[DiceHash]") {
+	using Map = PersistentLtHashMap<16, 1024, dice::hash::blake3::Blake3, DefaultMathEngine, TrackingAllocator<std::byte>, CrashingPersistBarrier>;
+
+	auto const make_map = []() {
+		auto map = std::make_unique<Map>(TrackingAllocator<std::byte>{}, 1);
+		map->add(1, obj1);
+		return map;
+	};
+
+	// an insertion that grows the table: grow() and the three barriers of the insertion itself
+	size_t n_barriers;
+	{
+		auto const map = make_map();
+		CrashingPersistBarrier::calls_until_crash = std::numeric_limits<size_t>::max();
+		map->insert(2);
+		n_barriers = std::numeric_limits<size_t>::max() - CrashingPersistBarrier::calls_until_crash;
+	}
+	REQUIRE(live_allocations.size() == 0);
+
+	auto const crash_at = GENERATE_COPY(range(size_t{0}, n_barriers));
+	CAPTURE(crash_at);
+
+	{
+		auto const map = make_map();
+
+		CrashingPersistBarrier::calls_until_crash = crash_at;
+		REQUIRE_THROWS_AS(map->insert(2), std::runtime_error);
+		CrashingPersistBarrier::calls_until_crash = std::numeric_limits<size_t>::max();
+
+		REQUIRE(map->contains(1));
+		REQUIRE(map->get(1).checksum_equal(LtHash16{}.add(obj1)));
+
+		// the next insertion reclaims whatever the interrupted one left behind, so that only the header and the entries
+		// of the current table remain. The old table is only lost if the crash happened right before it was released,
+		// after it was already forgotten (which prevents releasing it twice).
+		map->insert(3);
+		REQUIRE(map->contains(3));
+		auto const forgot_old_table = crash_at == n_barriers - 4;
+		REQUIRE(live_allocations.size() == (forgot_old_table ? 4 : 2));
+	}
+
+	REQUIRE(live_allocations.size() == (crash_at == n_barriers - 4 ? 2 : 0));
+	for (auto *ptr : std::exchange(live_allocations, {})) {
+		::operator delete(ptr); // the intentionally leaked table
+	}
+}
@@ -0,0 +1,133 @@
+#include <catch2/catch_all.hpp>
+
+#include <dice/hash/lthash/SeqLockLtHash.hpp>
+
+#include "TestLtHash_common.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace dice::hash::lthash;
+
+TEMPLATE_TEST_CASE("SeqLockLtHash", "[DiceHash]", LtHash16, LtHash20, LtHash32) {
+	using L = TestType;
+	using H = SeqLockLtHash<L>;
+
+	auto const key_bytes = as_bytes(std::span<char const, 32>{"0123456789abcdef0123456789abcdef", 32});
+
+	L keyed;
+	keyed.set_key(key_bytes);
+
+	SECTION("writers may throw (they lock), readers do not") {
+		STATIC_REQUIRE(!noexcept(std::declval<H &>().add(std::span<std::byte const>{})));
+		STATIC_REQUIRE(!noexcept(std::declval<H &>().remove(std::span<std::byte const>{})));
+		STATIC_REQUIRE(noexcept(std::declval<H const &>().snapshot()));
+	}
+
+	SECTION("updates are published with increasing epochs") {
+		H h{keyed};
+		CHECK(h.epoch() == 0);
+		CHECK(h.snapshot().epoch == 0);
+		CHECK(std::ranges::equal(h.snapshot().checksum, L::default_checksum));
+
+		h.add(as_object(1));
+		h.add(as_object(2));
+		CHECK(h.epoch() == 2);
+		CHECK(h.changed_since(0));
+		CHECK_FALSE(h.changed_since(2));
+
+		L expected = keyed;
+		expected.add(as_object(1)).add(as_object(2));
+
+		auto const snap = h.snapshot();
+		CHECK(snap.epoch == 2);
+		CHECK(std::ranges::equal(snap.checksum, expected.checksum()));
+		CHECK(h.get() == expected);
+		CHECK(h.get().key_equal(key_bytes));
+
+		h.remove(as_object(2));
+		expected.remove(as_object(2));
+		CHECK(h.get() == expected);
+	}
+
+	SECTION("snapshot_if_changed") {
+		H h{keyed};
+		typename H::Snapshot snap = h.snapshot();
+		CHECK_FALSE(h.snapshot_if_changed(snap.epoch, snap));
+
+		h.add(as_object(1));
+		REQUIRE(h.snapshot_if_changed(snap.epoch, snap));
+		CHECK(snap.epoch == 1);
+		CHECK_FALSE(h.snapshot_if_changed(snap.epoch, snap));
+	}
+
+	SECTION("update publishes once") {
+		H h{keyed};
+		h.update([](L &l) {
+			l.add(as_object(1)).add(as_object(2)).add(as_object(3));
+		});
+		CHECK(h.epoch() == 1);
+
+		L expected = keyed;
+		expected.add(as_object(1)).add(as_object(2)).add(as_object(3));
+		CHECK(h.get() == expected);
+	}
+
+	SECTION("combine") {
+		H h{keyed};
+		L other = keyed;
+		other.add(as_object(1));
+
+		h.combine_add(other);
+		CHECK(h.get() == other);
+		h.combine_remove(other);
+		CHECK(h.get() == L{});
+
+		CHECK_THROWS_AS(h.combine_add(L{}), std::invalid_argument);
+	}
+
+	SECTION("readers see consistent checksums while a writer updates") {
+		static constexpr size_t n_updates = 200;
+
+		std::vector<std::array<std::byte, L::checksum_len>> expected(n_updates + 1);
+		L l = keyed;
+		for (size_t ix = 0; ix <= n_updates; ++ix) {
+			std::ranges::copy(l.checksum(), expected[ix].begin());
+			l.add(as_object(ix));
+		}
+
+		H h{keyed};
+		std::atomic<bool> done{false};
+		std::atomic<size_t> inconsistent{0};
+
+		std::vector<std::thread> readers;
+		for (size_t r = 0; r < 2; ++r) {
+			readers.emplace_back([&]() {
+				while (!done.load(std::memory_order_relaxed)) {
+					auto const snap = h.snapshot();
+					if (snap.epoch > n_updates || !std::ranges::equal(snap.checksum, expected[snap.epoch])) {
+						inconsistent.fetch_add(1, std::memory_order_relaxed);
+					}
+				}
+			});
+		}
+
+		for (size_t ix = 0; ix < n_updates; ++ix) {
+			h.add(as_object(ix));
+		}
+		done.store(true, std::memory_order_relaxed);
+
+		for (auto &reader : readers) {
+			reader.join();
+		}
+
+		CHECK(inconsistent.load() == 0);
+		CHECK(h.epoch() == n_updates);
+		CHECK(std::ranges::equal(h.snapshot().checksum, expected[n_updates]));
+	}
+}
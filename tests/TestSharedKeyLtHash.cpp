@@ -0,0 +1,126 @@
+#include <catch2/catch_all.hpp>
+
+#include <dice/hash/blake/Blake2Xb.hpp>
+#include <dice/hash/lthash/SharedKeyLtHash.hpp>
+
+#include "TestLtHash_common.hpp"
+
+#include <array>
+#include <stdexcept>
+
+using namespace dice::hash::lthash;
+
+TEMPLATE_TEST_CASE("SharedKeyLtHash", "[DiceHash]",
+				   (SharedKeyLtHash<16, 1024>),
+				   (SharedKeyLtHash<20, 1008>),
+				   (SharedKeyLtHash<32, 1024>),
+				   (SharedKeyLtHash<20, 1008, dice::hash::blake2xb::Blake2Xb>)) {
+	using H = TestType;
+	using L = typename H::lthash_type;
+	using Key = typename H::key_type;
+
+	auto const key_bytes = as_bytes(std::span<char const, 32>{"0123456789abcdef0123456789abcdef", 32});
+	Key const key{key_bytes};
+
+	SECTION("same checksums as LtHash") {
+		H h{key};
+		h.add(obj1).add(obj2).remove(obj1);
+
+		L l;
+		l.set_key(key_bytes);
+		l.add(obj1).add(obj2).remove(obj1);
+
+		CHECK(std::ranges::equal(h.checksum(), l.checksum()));
+		CHECK(h.to_lthash() == l);
+		CHECK(h.to_lthash().key_equal(key_bytes));
+	}
+
+	SECTION("default key") {
+		H h;
+		h.add(obj1);
+
+		L l;
+		l.add(obj1);
+
+		CHECK(std::ranges::equal(h.checksum(), l.checksum()));
+	}
+
+	SECTION("key equality") {
+		H h1{key};
+		H h2{key};
+		CHECK(h1.key().same_object(h2.key()));
+		CHECK(h1.key_equal(h2));
+
+		// a separately created key object with the same bytes is still equal
+		H h3{Key{key_bytes}};
+		CHECK_FALSE(h1.key().same_object(h3.key()));
+		CHECK(h1.key_equal(h3));
+
+		std::array<std::byte, 32> other_bytes;
+		std::ranges::copy(key_bytes, other_bytes.begin());
+		other_bytes[0] = std::byte{'x'};
+		H h4{Key{std::span<std::byte const, 32>{other_bytes}}};
+		CHECK_FALSE(h1.key_equal(h4));
+		CHECK_THROWS_AS(h1.combine_add(h4), std::invalid_argument);
+		CHECK_THROWS_AS(h1.combine_remove(h4), std::invalid_argument);
+
+		CHECK_FALSE(h1.key_equal(H{}));
+		CHECK(H{}.key_equal(H{}));
+	}
+
+	SECTION("combine") {
+		H h1{key};
+		h1.add(obj1);
+		H h2{key};
+		h2.add(obj2);
+
+		H h3{key};
+		h3.add(obj1).add(obj2);
+
+		h1.combine_add(h2);
+		CHECK(h1 == h3);
+
+		h1.combine_remove(h2);
+		h3.remove(obj2);
+		CHECK(h1 == h3);
+	}
+
+	SECTION("copy and move share the key object") {
+		H h1{key};
+		h1.add(obj1);
+
+		H h2{h1};
+		CHECK(h2 == h1);
+		CHECK(h2.key().same_object(key));
+
+		H h3{std::move(h2)};
+		CHECK(h3 == h1);
+		CHECK(h3.key().same_object(key));
+
+		h3.set_key(Key{});
+		CHECK_FALSE(h3.key_equal(h1));
+	}
+
+	SECTION("set checksum") {
+		H h1{key};
+		h1.add(obj1);
+
+		H h2{key, h1.checksum()};
+		CHECK(h1 == h2);
+		CHECK(h1.checksum_equal_constant_time(h2.checksum()));
+
+		h2.clear_checksum();
+		CHECK(h2 == H{});
+
+		if constexpr (H::needs_padding) {
+			std::array<std::byte, H::checksum_len> invalid{};
+			invalid[7] = std::byte{0xFF};
+			CHECK_THROWS_AS(h2.set_checksum(invalid), std::invalid_argument);
+		}
+	}
+
+	SECTION("invalid key size") {
+		std::array<std::byte, 65> too_long{};
+		CHECK_THROWS_AS(Key{std::span<std::byte const>{too_long}}, std::invalid_argument);
+	}
+}